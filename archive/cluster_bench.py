@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+
+# Starts a cluster of pleroma nodes on loopback, runs each workload in bench/
+# on it and writes what it measured to a JSON file, one entry per workload.
+#
+# Node 0 has the "driver" resource and every other node "worker", so a
+# workload's Driver and its sinks run on node 0 and everything they talk to
+# on the rest.  The last node to join starts the Driver, which prints
+# bench-start and bench-done through Io; the run is timed between the two.
+# Message counts and round trips come from the "stats" file every node
+# writes (see pleroma_src/node_stats.h), CPU from /proc.
+
+import argparse, json, os, subprocess, sys, tempfile, time
+
+WORKLOADS = ["pingpong", "fanout", "fanin"]
+
+parser = argparse.ArgumentParser()
+parser.add_argument("workloads", nargs="*", default=WORKLOADS)
+parser.add_argument("--nodes", type=int, default=3)
+parser.add_argument("--burners", type=int, default=2)
+parser.add_argument("--base-port", type=int, default=7300)
+parser.add_argument("--pleroma", default="./pleroma")
+parser.add_argument("--timeout", type=float, default=120)
+parser.add_argument("--out", default="clusterbench.json")
+args = parser.parse_args()
+
+if args.nodes < 2:
+    sys.exit("Need at least 2 nodes, one driver and one worker")
+
+clock_ticks = os.sysconf("SC_CLK_TCK")
+
+def cpu_seconds(pid):
+    try:
+        with open("/proc/{}/stat".format(pid)) as f:
+            # Past the parenthesized command name, utime and stime are the
+            # 12th and 13th fields
+            fields = f.read().rsplit(")", 1)[1].split()
+        return (int(fields[11]) + int(fields[12])) / clock_ticks
+    except (OSError, IndexError):
+        return 0.0
+
+def wait_for(path, text, proc, deadline):
+    while time.time() < deadline:
+        with open(path, "rb") as f:
+            if text in f.read():
+                return True
+        if proc.poll() is not None:
+            return False
+        time.sleep(0.01)
+    return False
+
+def percentile(buckets, n, p):
+    # The shortest round trip of the bucket the p'th one falls in
+    seen = 0
+    for floor, count in buckets:
+        seen += count
+        if seen >= n * p:
+            return floor
+    return 0
+
+def run_workload(name, workdir):
+    program = os.path.join("bench", name + ".plm")
+    procs = []
+    outs = []
+    stats_paths = []
+
+    try:
+        for k in range(args.nodes):
+            config = {
+                "name": "bench{}".format(k),
+                "resources": ["driver"] if k == 0 else ["worker"],
+                "burners": args.burners,
+                "stats": os.path.join(workdir, "{}-stats{}.json".format(name, k)),
+            }
+            config_path = os.path.join(workdir, "{}-node{}.json".format(name, k))
+            with open(config_path, "w") as f:
+                json.dump(config, f)
+            stats_paths.append(config["stats"])
+
+            cmd = ["stdbuf", "-oL", args.pleroma, "start",
+                   "--local-host", "127.0.0.1:{}".format(args.base_port + k),
+                   "--config", config_path, "--program", program,
+                   "--entity", "Driver" if k == args.nodes - 1 else "none"]
+            if k > 0:
+                cmd += ["--remote-host", "127.0.0.1:{}".format(args.base_port)]
+
+            out_path = os.path.join(workdir, "{}-node{}.out".format(name, k))
+            outs.append(out_path)
+            with open(out_path, "wb") as out:
+                procs.append(subprocess.Popen(cmd, stdout = out, stderr = subprocess.STDOUT))
+
+            # Each node has to be in before the next one joins
+            ready = b"Host initialized" if k == 0 else b"our ID"
+            if not wait_for(out_path, ready, procs[-1], time.time() + 10):
+                return {"error": "node {} didn't come up, see {}".format(k, out_path)}
+
+        deadline = time.time() + args.timeout
+        if not wait_for(outs[0], b"bench-start", procs[0], deadline):
+            return {"error": "workload didn't start, see {}".format(outs[0])}
+        start = time.time()
+        start_cpu = sum(cpu_seconds(p.pid) for p in procs)
+
+        if not wait_for(outs[0], b"bench-done", procs[0], deadline):
+            return {"error": "workload didn't finish in {}s, see {}".format(args.timeout, outs[0])}
+        elapsed = time.time() - start
+        cpu = sum(cpu_seconds(p.pid) for p in procs) - start_cpu
+
+        # Stats files are rewritten about once a second
+        time.sleep(1.5)
+    finally:
+        for p in procs:
+            p.kill()
+            p.wait()
+
+    calls = 0
+    rtt_counts = {}
+    bytes_sent = 0
+    for path in stats_paths:
+        if not os.path.exists(path):
+            continue
+        with open(path) as f:
+            stats = json.load(f)
+        calls += stats["calls_sent"]
+        bytes_sent += stats["bytes_sent"]
+        for floor, count in stats["rtt_us"]["buckets"]:
+            rtt_counts[floor] = rtt_counts.get(floor, 0) + count
+
+    buckets = sorted(rtt_counts.items())
+    n_rtts = sum(rtt_counts.values())
+
+    return {
+        "nodes": args.nodes,
+        "seconds": round(elapsed, 4),
+        "calls": calls,
+        "bytes_sent": bytes_sent,
+        "msgs_per_sec": round(calls / elapsed, 1) if elapsed > 0 else 0,
+        "rtt_count": n_rtts,
+        "rtt_p50_us": percentile(buckets, n_rtts, 0.5),
+        "rtt_p99_us": percentile(buckets, n_rtts, 0.99),
+        "cpu_seconds": round(cpu, 4),
+        "cpu_us_per_msg": round(cpu * 1e6 / calls, 2) if calls > 0 else 0,
+    }
+
+results = {}
+all_succeed = True
+with tempfile.TemporaryDirectory(prefix = "clusterbench") as workdir:
+    for name in args.workloads:
+        result = run_workload(name, workdir)
+        results[name] = result
+        if "error" in result:
+            all_succeed = False
+            print("\033[1;31mFailed:\033[0m {}: {}".format(name, result["error"]))
+            # The logs go with the temporary directory
+            for k in range(args.nodes):
+                out_path = os.path.join(workdir, "{}-node{}.out".format(name, k))
+                if os.path.exists(out_path):
+                    with open(out_path, "rb") as f:
+                        print("\tnode {}: {}".format(k, str(f.read()[-2000:], "utf-8", "replace")))
+        else:
+            print("\033[1;32m{}:\033[0m {} msgs/s, rtt p50 {}us p99 {}us, {} cpu us/msg".format(
+                name, result["msgs_per_sec"], result["rtt_p50_us"], result["rtt_p99_us"], result["cpu_us_per_msg"]))
+
+with open(args.out, "w") as f:
+    json.dump(results, f, indent = 2)
+
+sys.exit(0 if all_succeed else 1)
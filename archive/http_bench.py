@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Starts a pleroma node serving bench/httpserve.plm once for each HTTP thread
+# count, loads it from local client processes over keep-alive connections and
+# writes the requests per second each count managed to a JSON file.
+#
+# The node's "http" config sets the port, backlog and thread count; each
+# thread has its own SO_REUSEPORT listener, so with more threads the kernel
+# spreads the connections over more cores.  The program starts eight handler
+# vats for the "bench" host, and the HttpLb takes turns between them.
+
+import argparse, json, multiprocessing, os, selectors, socket, subprocess, sys, tempfile, time
+
+parser = argparse.ArgumentParser()
+parser.add_argument("threads", nargs="*", type=int, default=[1, 2, 4])
+parser.add_argument("--burners", type=int, default=0)
+parser.add_argument("--port", type=int, default=7400)
+parser.add_argument("--backlog", type=int, default=1024)
+parser.add_argument("--clients", type=int, default=4, help="load generator processes")
+parser.add_argument("--conns", type=int, default=16, help="connections per client")
+parser.add_argument("--seconds", type=float, default=5)
+parser.add_argument("--pleroma", default="./pleroma")
+parser.add_argument("--out", default="httpbench.json")
+args = parser.parse_args()
+
+REQUEST = b"GET / HTTP/1.1\r\nHost: bench\r\n\r\n"
+
+def response_end(buf):
+    # Where the first response in buf ends, or -1 if it hasn't all arrived
+    head_end = buf.find(b"\r\n\r\n")
+    sep = 4
+    if head_end < 0 or (0 <= buf.find(b"\n\n") < head_end):
+        head_end = buf.find(b"\n\n")
+        sep = 2
+    if head_end < 0:
+        return -1
+    length = 0
+    for line in buf[:head_end].split(b"\n")[1:]:
+        name, _, value = line.partition(b":")
+        if name.strip().lower() == b"content-length":
+            length = int(value)
+    end = head_end + sep + length
+    return end if len(buf) >= end else -1
+
+def client(port, n_conns, seconds, results):
+    # Each connection has one request out at a time
+    sel = selectors.DefaultSelector()
+    bufs = {}
+    for k in range(n_conns):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.sendall(REQUEST)
+        bufs[s] = b""
+        sel.register(s, selectors.EVENT_READ)
+
+    done = 0
+    errors = 0
+    deadline = time.time() + seconds
+    while bufs and time.time() < deadline:
+        for key, _ in sel.select(0.1):
+            s = key.fileobj
+            data = s.recv(65536)
+            if not data:
+                errors += 1
+                sel.unregister(s)
+                del bufs[s]
+                continue
+            buf = bufs[s] + data
+            end = response_end(buf)
+            while end >= 0:
+                if not buf.startswith(b"HTTP/1.1 200"):
+                    errors += 1
+                done += 1
+                buf = buf[end:]
+                s.sendall(REQUEST)
+                end = response_end(buf)
+            bufs[s] = buf
+    results.put((done, errors))
+
+def wait_until_serving(proc, deadline):
+    while time.time() < deadline and proc.poll() is None:
+        try:
+            with socket.create_connection(("127.0.0.1", args.port), timeout = 1) as s:
+                s.sendall(REQUEST)
+                if s.recv(4096).startswith(b"HTTP/1.1 200"):
+                    return True
+        except OSError:
+            pass
+        time.sleep(0.1)
+    return False
+
+def run(n_threads, workdir):
+    config = {
+        "name": "httpbench",
+        "resources": [],
+        "burners": args.burners,
+        "http": {"port": args.port, "backlog": args.backlog, "threads": n_threads},
+    }
+    config_path = os.path.join(workdir, "node{}.json".format(n_threads))
+    with open(config_path, "w") as f:
+        json.dump(config, f)
+
+    out_path = os.path.join(workdir, "node{}.out".format(n_threads))
+    cmd = [args.pleroma, "start", "--local-host", "127.0.0.1:{}".format(args.port + 1),
+           "--config", config_path, "--program", os.path.join("bench", "httpserve.plm"), "--entity", "Driver"]
+    with open(out_path, "wb") as out:
+        proc = subprocess.Popen(cmd, stdout = out, stderr = subprocess.STDOUT)
+
+    try:
+        if not wait_until_serving(proc, time.time() + 10):
+            return {"error": "node didn't start serving, see {}".format(out_path)}
+
+        results = multiprocessing.Queue()
+        clients = [multiprocessing.Process(target = client, args = (args.port, args.conns, args.seconds, results))
+                   for k in range(args.clients)]
+        start = time.time()
+        for c in clients:
+            c.start()
+        counts = [results.get() for c in clients]
+        elapsed = time.time() - start
+        for c in clients:
+            c.join()
+    finally:
+        proc.kill()
+        proc.wait()
+
+    done = sum(c[0] for c in counts)
+    return {
+        "threads": n_threads,
+        "connections": args.clients * args.conns,
+        "seconds": round(elapsed, 4),
+        "requests": done,
+        "errors": sum(c[1] for c in counts),
+        "requests_per_sec": round(done / elapsed, 1) if elapsed > 0 else 0,
+    }
+
+results = {}
+all_succeed = True
+with tempfile.TemporaryDirectory(prefix = "httpbench") as workdir:
+    for n_threads in args.threads:
+        result = run(n_threads, workdir)
+        results[str(n_threads)] = result
+        if "error" in result:
+            all_succeed = False
+            print("\033[1;31mFailed:\033[0m {} threads: {}".format(n_threads, result["error"]))
+            out_path = os.path.join(workdir, "node{}.out".format(n_threads))
+            if os.path.exists(out_path):
+                with open(out_path, "rb") as f:
+                    print("\t{}".format(str(f.read()[-2000:], "utf-8", "replace")))
+        else:
+            print("\033[1;32m{} threads:\033[0m {} req/s, {} errors".format(n_threads, result["requests_per_sec"], result["errors"]))
+
+with open(args.out, "w") as f:
+    json.dump(results, f, indent = 2)
+
+sys.exit(0 if all_succeed else 1)
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+
+# Runs the programs in http_tests/ on a node and checks what their HttpLb
+# answers.  Each check sends requests and compares how many times the
+# handler ran, which it prints as "rendered", against what the cache should
+# have let through.
+
+import argparse, json, os, socket, subprocess, sys, tempfile, time
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--port", type=int, default=7500)
+parser.add_argument("--pleroma", default="./pleroma")
+args = parser.parse_args()
+
+def get(host, path):
+    with socket.create_connection(("127.0.0.1", args.port), timeout = 5) as s:
+        s.sendall("GET {} HTTP/1.1\r\nHost: {}\r\nConnection: close\r\n\r\n".format(path, host).encode())
+        response = b""
+        while True:
+            data = s.recv(65536)
+            if not data:
+                return response
+            response += data
+
+def renders(out_path, before):
+    # Printing goes through the Io vat, give it a moment
+    time.sleep(0.3)
+    with open(out_path, "rb") as f:
+        return f.read().count(b"rendered") - before
+
+def cache_any_host(out_path):
+    # Both hosts fall back to the "*" routes, each gets its own entry
+    n = renders(out_path, 0)
+    for host in ["a.test", "b.test", "a.test", "b.test"]:
+        get(host, "/cached/page")
+    if renders(out_path, n) != 2:
+        return "expected one render per host"
+
+    # Invalidating "*" drops them for every host
+    n = renders(out_path, 0)
+    get("a.test", "/flush")
+    for host in ["a.test", "b.test"]:
+        get(host, "/cached/page")
+    if renders(out_path, n) != 2:
+        return "invalidate(\"*\") left pages cached"
+
+    # As does turning the cache off
+    n = renders(out_path, 0)
+    get("a.test", "/nocache")
+    for host in ["a.test", "b.test"]:
+        get(host, "/cached/page")
+    if renders(out_path, n) != 2:
+        return "cache(\"*\", ..., 0) left pages cached"
+    return None
+
+TESTS = {"cache-any-host": cache_any_host}
+
+def wait_until_serving(proc, deadline):
+    while time.time() < deadline and proc.poll() is None:
+        try:
+            get("localhost", "/")
+            return True
+        except OSError:
+            time.sleep(0.1)
+    return False
+
+all_succeed = True
+with tempfile.TemporaryDirectory(prefix = "httptest") as workdir:
+    config_path = os.path.join(workdir, "node.json")
+    with open(config_path, "w") as f:
+        json.dump({"name": "httptest", "resources": [], "burners": 2, "http": {"port": args.port}}, f)
+
+    for name, check in TESTS.items():
+        out_path = os.path.join(workdir, name + ".out")
+        cmd = ["stdbuf", "-oL", args.pleroma, "start", "--local-host", "127.0.0.1:{}".format(args.port + 1),
+               "--config", config_path, "--program", os.path.join("http_tests", name + ".plm")]
+        with open(out_path, "wb") as out:
+            proc = subprocess.Popen(cmd, stdout = out, stderr = subprocess.STDOUT)
+
+        try:
+            error = "node didn't start serving" if not wait_until_serving(proc, time.time() + 10) else check(out_path)
+        except OSError as e:
+            error = str(e)
+        finally:
+            proc.kill()
+            proc.wait()
+
+        if error is None:
+            print("\033[1;32mSuccess:\033[0m {}".format(name))
+        else:
+            all_succeed = False
+            print("\033[1;31mFailed:\033[0m {}: {}".format(name, error))
+            with open(out_path, "rb") as f:
+                print("\t" + str(f.read()[-2000:], "utf-8", "replace"))
+
+sys.exit(0 if all_succeed else 1)
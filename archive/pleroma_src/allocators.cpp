@@ -0,0 +1,92 @@
+#include "allocators.h"
+#include <cassert>
+
+thread_local VatAllocator *tl_current_allocator = nullptr;
+
+// Regions start with their header, rounded up so objects stay aligned
+const size_t REGION_HEADER_SIZE =
+    (sizeof(VatAllocator::Region) + VAT_ALLOC_GRANULE - 1) & ~(VAT_ALLOC_GRANULE - 1);
+
+static inline int size_class(size_t size) {
+  return (size + VAT_ALLOC_GRANULE - 1) / VAT_ALLOC_GRANULE - 1;
+}
+
+VatAllocator *create_vat_allocator() {
+  return new VatAllocator;
+}
+
+void destroy_vat_allocator(VatAllocator *allocator) {
+  auto region = allocator->regions;
+  while (region) {
+    auto next = region->next;
+    ::operator delete(region);
+    region = next;
+  }
+
+  delete allocator;
+}
+
+void add_region(VatAllocator *allocator) {
+  auto region = (VatAllocator::Region *)::operator new(VAT_REGION_SIZE);
+  region->next = allocator->regions;
+  allocator->regions = region;
+  allocator->n_regions++;
+
+  allocator->bump = (char *)region + REGION_HEADER_SIZE;
+  allocator->bump_end = (char *)region + VAT_REGION_SIZE;
+}
+
+void *vat_alloc(VatAllocator *allocator, size_t size) {
+  if (size == 0) size = 1;
+  if (size > VAT_MAX_SMALL_ALLOC) {
+    return ::operator new(size);
+  }
+
+  int sc = size_class(size);
+  size_t class_size = (sc + 1) * VAT_ALLOC_GRANULE;
+  allocator->bytes_in_use += class_size;
+
+  if (auto obj = allocator->free_lists[sc]) {
+    allocator->free_lists[sc] = obj->next;
+    return obj;
+  }
+
+  // Whatever is left of the old region is abandoned, it is never more than
+  // one object's worth
+  if (allocator->bump + class_size > allocator->bump_end) {
+    add_region(allocator);
+  }
+
+  void *obj = allocator->bump;
+  allocator->bump += class_size;
+  return obj;
+}
+
+void vat_free(VatAllocator *allocator, void *ptr, size_t size) {
+  if (size == 0) size = 1;
+  if (size > VAT_MAX_SMALL_ALLOC) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  int sc = size_class(size);
+  assert(allocator->bytes_in_use >= (sc + 1) * VAT_ALLOC_GRANULE);
+  allocator->bytes_in_use -= (sc + 1) * VAT_ALLOC_GRANULE;
+
+  auto obj = (VatAllocator::FreeObj *)ptr;
+  obj->next = allocator->free_lists[sc];
+  allocator->free_lists[sc] = obj;
+}
+
+VatAllocator *current_allocator() {
+  return tl_current_allocator;
+}
+
+AllocatorScope::AllocatorScope(VatAllocator *allocator) {
+  prev = tl_current_allocator;
+  tl_current_allocator = allocator;
+}
+
+AllocatorScope::~AllocatorScope() {
+  tl_current_allocator = prev;
+}
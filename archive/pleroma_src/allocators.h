@@ -0,0 +1,80 @@
+#pragma once
+
+#include "common.h"
+#include <cstddef>
+#include <new>
+#include <utility>
+
+const size_t VAT_REGION_SIZE = 64 * 1024;
+
+// Size classes are multiples of this, which is also the alignment of every
+// object handed out
+const size_t VAT_ALLOC_GRANULE = 16;
+const int VAT_N_SIZE_CLASSES = 32;
+// Anything bigger goes straight to the global heap
+const size_t VAT_MAX_SMALL_ALLOC = VAT_ALLOC_GRANULE * VAT_N_SIZE_CLASSES;
+
+// Region allocator owned by a single vat.  Only the burner dispatching the
+// vat allocates from it, so nothing here is locked.  Freed objects go on a
+// free list per size class, empty lists are refilled by bumping through the
+// current region.
+struct VatAllocator {
+  struct Region {
+    Region *next;
+  };
+
+  struct FreeObj {
+    FreeObj *next;
+  };
+
+  Region *regions = nullptr;
+  char *bump = nullptr;
+  char *bump_end = nullptr;
+
+  FreeObj *free_lists[VAT_N_SIZE_CLASSES] = {};
+
+  int n_regions = 0;
+  u64 bytes_in_use = 0;
+};
+
+VatAllocator *create_vat_allocator();
+// Hands back every region at once without visiting the objects in them.
+// Destructors don't run, so anything an object keeps on the global heap
+// (string or vector storage) has to be released first or leaks.
+void destroy_vat_allocator(VatAllocator *allocator);
+
+void *vat_alloc(VatAllocator *allocator, size_t size);
+// size is the one the object was allocated with
+void vat_free(VatAllocator *allocator, void *ptr, size_t size);
+
+// Allocator of the vat this thread is running, nullptr outside a dispatch.
+// Runtime make_* calls allocate from it.
+VatAllocator *current_allocator();
+
+// Sets the current allocator until the end of the scope.  nullptr sends
+// allocations to the global heap, for things that outlive any one vat.
+struct AllocatorScope {
+  VatAllocator *prev;
+
+  AllocatorScope(VatAllocator *allocator);
+  ~AllocatorScope();
+};
+
+// With no allocator these fall back to plain new/delete
+template <typename T, typename... Args>
+T *vat_new(VatAllocator *allocator, Args &&...args) {
+  if (!allocator) {
+    return new T(std::forward<Args>(args)...);
+  }
+  return new (vat_alloc(allocator, sizeof(T))) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void vat_delete(VatAllocator *allocator, T *obj) {
+  if (!allocator) {
+    delete obj;
+    return;
+  }
+  obj->~T();
+  vat_free(allocator, obj, sizeof(T));
+}
@@ -27,15 +27,19 @@ PleromaArgs parse_args(int argc, char** argv) {
   }
 
   if (vargs.size() < 1) {
-    throw PleromaException("Must use command [start, test]");
+    throw PleromaException("Must use command [start, test, difftest, wirebench]");
   }
 
   if (vargs[0] == "start") {
     pargs.command = PCommand::Start;
   } else if (vargs[0] == "test") {
     pargs.command = PCommand::Test;
+  } else if (vargs[0] == "difftest") {
+    pargs.command = PCommand::DiffTest;
+  } else if (vargs[0] == "wirebench") {
+    pargs.command = PCommand::WireBench;
   } else {
-    throw PleromaException("Need valid command: start or test.");
+    throw PleromaException("Need valid command: start, test, difftest or wirebench.");
   }
 
   if (pargs.command == PCommand::Start) {
@@ -5,7 +5,11 @@
 
 enum class PCommand {
   Start,
-  Test
+  Test,
+  // Runs a file under both execution engines and compares the results
+  DiffTest,
+  // Compares the protobuf and binary wire formats
+  WireBench
 };
 
 struct PleromaArgs {
@@ -19,7 +23,8 @@ struct PleromaArgs {
   u32 remote_port = 0;
 
   std::string program_path = "examples/helloworld.plm";
-  // In the future, we should automatically find this
+  // In the future, we should automatically find this.  "none" loads the
+  // program without starting anything, for nodes that only host its vats.
   std::string entity_name = "UserProgram";
 };
 
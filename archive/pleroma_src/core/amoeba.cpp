@@ -120,8 +120,8 @@ AstNode *amoeba_init(EvalContext *context, std::vector<AstNode *> args) {
     panic("Failed to initialize TTF system.");
   }
 
-  EntityRefNode* rfn = (EntityRefNode*)cfs(context).entity->data["mnd"];
-  eval_message_node(context, rfn, CommMode::Async, "subscribe-irq", {make_number(1)});
+  EntityRefNode* rfn = (EntityRefNode*)box_value(entity_field(cfs(context).entity, "mnd"));
+  eval_message_node(context, rfn, CommMode::Async, intern_selector("subscribe-irq"), {make_number(1)});
 
   auto window = SDL_CreateWindow("SDL2 Window", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 680, 480, SDL_WINDOW_FULLSCREEN_DESKTOP);
   renderer = SDL_CreateRenderer(window, -1, 0);
@@ -147,11 +147,10 @@ AstNode *amoeba_super_window(EvalContext *context, std::vector<AstNode *> args)
   refresh_window(window);
 
   auto env = eval(context, make_create_entity("AmoebaWindow", false));
-  auto ent_ref = (EntityRefNode*)env;
 
-  context->vat->entities[ent_ref->entity_id]->data["window-id"] = make_number(window->window_id);
+  context->vat->entities[env.ref.entity_id]->_kdata["window-id"] = make_number(window->window_id);
 
-  return env;
+  return box_value(env);
 }
 
 AstNode *amoeba_close(EvalContext *context, std::vector<AstNode *> args) {
@@ -175,7 +174,7 @@ AstNode *super_window_close(EvalContext *context, std::vector<AstNode *> args) {
 
 AstNode *super_window_write(EvalContext *context, std::vector<AstNode *> args) {
 
-  auto window_id = ((NumberNode*)cfs(context).entity->data["window-id"])->value;
+  auto window_id = ((NumberNode*)cfs(context).entity->_kdata["window-id"])->value;
 
   drawText(windows[window_id], "test", 24, 0, 0, 255, 255, 255, 0, 0, 0);
 
@@ -0,0 +1,110 @@
+#include "http_cache.h"
+#include "http_router.h"
+
+#include <chrono>
+
+static u64 now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static size_t entry_bytes(const std::string &key, const HttpCacheEntry &entry) {
+  return key.size() + entry.response.size();
+}
+
+static void erase_entry(HttpCache *cache, std::map<std::string, HttpCacheEntry>::iterator it) {
+  cache->bytes -= entry_bytes(it->first, it->second);
+  cache->lru.erase(it->second.lru_pos);
+  cache->entries.erase(it);
+}
+
+std::string http_cache_key(const std::string &host, const std::string &path) {
+  // Hosts have no spaces, paths start with one
+  return host + " " + path;
+}
+
+bool http_cache_get(HttpCache *cache, const std::string &key, std::string *response) {
+  std::lock_guard<std::mutex> lock(cache->mtx);
+
+  auto found = cache->entries.find(key);
+  if (found == cache->entries.end()) return false;
+  if (found->second.expires_ns <= now_ns()) {
+    erase_entry(cache, found);
+    return false;
+  }
+
+  cache->lru.splice(cache->lru.begin(), cache->lru, found->second.lru_pos);
+  *response = found->second.response;
+  return true;
+}
+
+u64 http_cache_generation(HttpCache *cache) {
+  std::lock_guard<std::mutex> lock(cache->mtx);
+  return cache->generation;
+}
+
+void http_cache_put(HttpCache *cache, const std::string &key, std::string response, u32 ttl_ms, u64 generation) {
+  std::lock_guard<std::mutex> lock(cache->mtx);
+  if (generation != cache->generation) return;
+
+  auto found = cache->entries.find(key);
+  if (found != cache->entries.end()) erase_entry(cache, found);
+
+  // One response may not push out the rest of the cache
+  if (key.size() + response.size() > cache->max_bytes / 8) return;
+
+  HttpCacheEntry entry;
+  entry.response = std::move(response);
+  entry.expires_ns = now_ns() + (u64)ttl_ms * 1000000;
+  cache->lru.push_front(key);
+  entry.lru_pos = cache->lru.begin();
+  cache->bytes += entry_bytes(key, entry);
+  cache->entries.emplace(key, std::move(entry));
+
+  while (cache->bytes > cache->max_bytes) {
+    erase_entry(cache, cache->entries.find(cache->lru.back()));
+  }
+}
+
+// Whether the key from start on is the pattern's path, or under it.  "/a/*"
+// is "/a" and everything from "/a/" and "/a?" on.
+static bool key_matches(const std::string &key, size_t start, const std::string &pattern, bool prefix) {
+  size_t len = prefix ? pattern.size() - 2 : pattern.size();
+  if (key.size() - start < len || key.compare(start, len, pattern, 0, len) != 0) return false;
+  if (!prefix) return key.size() - start == len;
+
+  char next = key.size() - start > len ? key[start + len] : '\0';
+  return next == '\0' || next == '/' || next == '?' || next == '#';
+}
+
+void http_cache_invalidate(HttpCache *cache, const std::string &host, const std::string &pattern) {
+  std::lock_guard<std::mutex> lock(cache->mtx);
+  cache->generation++;
+
+  bool prefix = pattern.size() >= 2 && pattern.compare(pattern.size() - 2, 2, "/*") == 0;
+
+  // Entries are kept under the Host the request came with, which for the
+  // fallback routes can be any
+  if (host == HTTP_ANY_HOST) {
+    for (auto it = cache->entries.begin(); it != cache->entries.end();) {
+      size_t path_start = it->first.find(' ') + 1;
+      if (key_matches(it->first, path_start, pattern, prefix)) {
+        erase_entry(cache, it++);
+      } else {
+        ++it;
+      }
+    }
+    return;
+  }
+
+  // The host's entries are a range, its paths under the pattern one within it
+  std::string base = http_cache_key(host, prefix ? pattern.substr(0, pattern.size() - 2) : pattern);
+  size_t path_start = host.size() + 1;
+  auto it = cache->entries.lower_bound(base);
+  while (it != cache->entries.end() && it->first.compare(0, base.size(), base) == 0) {
+    if (key_matches(it->first, path_start, pattern, prefix)) {
+      erase_entry(cache, it++);
+    } else {
+      ++it;
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../common.h"
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Responses to GET requests kept by host and path, so the server threads can
+// answer repeat requests without the HttpLb or a handler running.  Entries
+// live for their route's TTL, and the least recently used ones go first once
+// the cache passes its size.  Only routes a program asked to cache are put
+// here, see http_router.h.
+
+struct HttpCacheEntry {
+  std::string response;
+  u64 expires_ns;
+  // Position in HttpCache::lru
+  std::list<std::string>::iterator lru_pos;
+};
+
+struct HttpCache {
+  std::mutex mtx;
+  // Ordered, so everything under a path is a range
+  std::map<std::string, HttpCacheEntry> entries;
+  // Keys, most recently used first
+  std::list<std::string> lru;
+  size_t bytes = 0;
+  size_t max_bytes = 0;
+  // Bumped by every invalidation, responses to requests made before one
+  // aren't put
+  u64 generation = 0;
+};
+
+// Safe to call from any thread
+std::string http_cache_key(const std::string &host, const std::string &path);
+bool http_cache_get(HttpCache *cache, const std::string &key, std::string *response);
+u64 http_cache_generation(HttpCache *cache);
+
+// Skipped if the cache was invalidated since generation was read
+void http_cache_put(HttpCache *cache, const std::string &key, std::string response, u32 ttl_ms, u64 generation);
+
+// Drops the path's response, or with a trailing "/*" everything under it.  The
+// "*" host drops them for every host, as its routes answer for any.
+void http_cache_invalidate(HttpCache *cache, const std::string &host, const std::string &pattern);
@@ -0,0 +1,210 @@
+#include "http_parser.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+const size_t HTTP_MAX_CHUNK_LINE = 1024;
+
+void http_parser_reset(HttpParser *parser) {
+  *parser = HttpParser();
+}
+
+static HttpParse fail(HttpParser *parser, int status) {
+  parser->error_status = status;
+  return HttpParse::Error;
+}
+
+// The next line past pos without its line ending, moving pos past it.  False
+// if it hasn't all arrived.
+static bool next_line(HttpParser *parser, const std::string &buf, std::string *line) {
+  size_t end = buf.find('\n', parser->pos);
+  if (end == std::string::npos) return false;
+
+  size_t len = end - parser->pos;
+  if (len > 0 && buf[end - 1] == '\r') len--;
+  line->assign(buf, parser->pos, len);
+  parser->pos = end + 1;
+  return true;
+}
+
+static bool name_is(const std::string &header, size_t name_len, const char *name) {
+  return name_len == strlen(name) && strncasecmp(header.data(), name, name_len) == 0;
+}
+
+static bool value_has(const std::string &value, const char *token) {
+  return strcasestr(value.c_str(), token) != nullptr;
+}
+
+static HttpParse parse_request_line(HttpParser *parser, const std::string &line) {
+  size_t sp1 = line.find(' ');
+  size_t sp2 = sp1 == std::string::npos ? std::string::npos : line.find(' ', sp1 + 1);
+  if (sp1 == 0 || sp2 == std::string::npos || sp2 == sp1 + 1) return fail(parser, 400);
+
+  std::string version = line.substr(sp2 + 1);
+  if (version == "HTTP/1.1") {
+    parser->req.keep_alive = true;
+  } else if (version == "HTTP/1.0") {
+    parser->req.keep_alive = false;
+  } else {
+    return fail(parser, 505);
+  }
+
+  parser->req.verb = line.substr(0, sp1);
+  parser->req.path = line.substr(sp1 + 1, sp2 - sp1 - 1);
+  parser->state = HttpParseState::Headers;
+  return HttpParse::More;
+}
+
+static HttpParse parse_header(HttpParser *parser, const std::string &line) {
+  size_t colon = line.find(':');
+  if (colon == std::string::npos || colon == 0) return fail(parser, 400);
+
+  size_t value_start = line.find_first_not_of(" \t", colon + 1);
+  std::string value = value_start == std::string::npos ? "" : line.substr(value_start);
+
+  if (name_is(line, colon, "host")) {
+    parser->req.host = value;
+  } else if (name_is(line, colon, "content-length")) {
+    char *end;
+    unsigned long long len = strtoull(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0') return fail(parser, 400);
+    if (len > HTTP_MAX_BODY_BYTES) return fail(parser, 413);
+    parser->body_left = len;
+  } else if (name_is(line, colon, "transfer-encoding")) {
+    if (strcasecmp(value.c_str(), "chunked") != 0) return fail(parser, 501);
+    parser->chunked = true;
+  } else if (name_is(line, colon, "connection")) {
+    if (value_has(value, "close")) parser->req.keep_alive = false;
+    if (value_has(value, "keep-alive")) parser->req.keep_alive = true;
+  }
+
+  parser->req.headers.push_back(line);
+  return HttpParse::More;
+}
+
+static HttpParse end_headers(HttpParser *parser) {
+  if (parser->chunked) {
+    // Chunked wins over a Content-Length, as RFC 9112 has it
+    parser->body_left = 0;
+    parser->state = HttpParseState::ChunkSize;
+    return HttpParse::More;
+  }
+  if (parser->body_left > 0) {
+    parser->state = HttpParseState::Body;
+    return HttpParse::More;
+  }
+  return HttpParse::Done;
+}
+
+static HttpParse parse_chunk_size(HttpParser *parser, const std::string &line) {
+  char *end;
+  unsigned long long len = strtoull(line.c_str(), &end, 16);
+  // Chunk extensions are ignored
+  if (end == line.c_str() || (*end != '\0' && *end != ';' && *end != ' ' && *end != '\t')) return fail(parser, 400);
+  if (len > HTTP_MAX_BODY_BYTES - parser->req.body.size()) return fail(parser, 413);
+
+  parser->body_left = len;
+  parser->state = len == 0 ? HttpParseState::Trailers : HttpParseState::ChunkData;
+  return HttpParse::More;
+}
+
+HttpParse http_parse(HttpParser *parser, const std::string &buf) {
+  std::string line;
+
+  while (true) {
+    HttpParse result = HttpParse::More;
+
+    switch (parser->state) {
+    case HttpParseState::RequestLine:
+    case HttpParseState::Headers:
+    case HttpParseState::Trailers:
+      if (!next_line(parser, buf, &line)) {
+        if (parser->head_bytes + (buf.size() - parser->pos) > HTTP_MAX_HEADER_BYTES) return fail(parser, 431);
+        return HttpParse::More;
+      }
+      parser->head_bytes += line.size() + 1;
+      if (parser->head_bytes > HTTP_MAX_HEADER_BYTES) return fail(parser, 431);
+
+      if (parser->state == HttpParseState::RequestLine) {
+        // Stray blank lines between pipelined requests are allowed
+        if (!line.empty()) result = parse_request_line(parser, line);
+      } else if (parser->state == HttpParseState::Headers) {
+        result = line.empty() ? end_headers(parser) : parse_header(parser, line);
+      } else if (line.empty()) {
+        result = HttpParse::Done;
+      }
+      break;
+
+    case HttpParseState::Body: {
+      size_t n = std::min(parser->body_left, buf.size() - parser->pos);
+      parser->req.body.append(buf, parser->pos, n);
+      parser->pos += n;
+      parser->body_left -= n;
+      if (parser->body_left > 0) return HttpParse::More;
+      result = HttpParse::Done;
+      break;
+    }
+
+    case HttpParseState::ChunkSize:
+      if (!next_line(parser, buf, &line)) {
+        // Sizes are a few hex digits and maybe an extension
+        if (buf.size() - parser->pos > HTTP_MAX_CHUNK_LINE) return fail(parser, 400);
+        return HttpParse::More;
+      }
+      result = parse_chunk_size(parser, line);
+      break;
+
+    case HttpParseState::ChunkData: {
+      size_t n = std::min(parser->body_left, buf.size() - parser->pos);
+      parser->req.body.append(buf, parser->pos, n);
+      parser->pos += n;
+      parser->body_left -= n;
+      if (parser->body_left > 0) return HttpParse::More;
+
+      // The line ending after the data
+      if (!next_line(parser, buf, &line)) return HttpParse::More;
+      if (!line.empty()) return fail(parser, 400);
+      parser->state = HttpParseState::ChunkSize;
+      break;
+    }
+    }
+
+    if (result != HttpParse::More) return result;
+  }
+}
+
+bool http_response_framed(const std::string &response) {
+  size_t head_end = response.find("\n\n");
+  size_t crlf_end = response.find("\r\n\r\n");
+  if (crlf_end != std::string::npos && (head_end == std::string::npos || crlf_end < head_end)) head_end = crlf_end;
+  if (head_end == std::string::npos) head_end = response.size();
+
+  size_t pos = response.find('\n');
+  while (pos != std::string::npos && pos < head_end) {
+    const char *line = response.c_str() + pos + 1;
+    if (strncasecmp(line, "content-length:", 15) == 0) return true;
+    if (strncasecmp(line, "transfer-encoding:", 18) == 0) {
+      size_t line_end = response.find('\n', pos + 1);
+      if (strcasestr(response.substr(pos + 1, line_end - pos - 1).c_str(), "chunked")) return true;
+    }
+    pos = response.find('\n', pos + 1);
+  }
+  return false;
+}
+
+std::string http_error_response(int status) {
+  const char *reason;
+  switch (status) {
+  case 400: reason = "Bad Request"; break;
+  case 404: reason = "Not Found"; break;
+  case 413: reason = "Content Too Large"; break;
+  case 431: reason = "Request Header Fields Too Large"; break;
+  case 500: reason = "Internal Server Error"; break;
+  case 501: reason = "Not Implemented"; break;
+  case 505: reason = "HTTP Version Not Supported"; break;
+  default: reason = "Error"; break;
+  }
+  return "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
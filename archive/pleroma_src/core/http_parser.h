@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../common.h"
+#include <string>
+#include <vector>
+
+// Incremental HTTP/1.x request parser.  It works on a connection's input
+// buffer as it grows, picking up where the last call stopped, so a request
+// split over any number of reads is only scanned once.  Bodies are read by
+// Content-Length or chunked transfer encoding.  Lines may end in CRLF or a
+// bare LF.
+
+typedef s32 HttpConnId;
+
+struct HttpRequest {
+  HttpConnId conn;
+  std::string verb;
+  std::string path;
+  std::string host;
+  // "Name: value", as received, in order
+  std::vector<std::string> headers;
+  std::string body;
+  // HTTP/1.1 unless it asked for Connection: close, HTTP/1.0 only if it
+  // asked for keep-alive
+  bool keep_alive = false;
+};
+
+// Requests whose headers run past this are refused with 431, bodies past
+// HTTP_MAX_BODY_BYTES with 413
+const size_t HTTP_MAX_HEADER_BYTES = 64 * 1024;
+const size_t HTTP_MAX_BODY_BYTES = 8 * 1024 * 1024;
+
+enum class HttpParse { More, Done, Error };
+
+enum class HttpParseState { RequestLine, Headers, Body, ChunkSize, ChunkData, Trailers };
+
+struct HttpParser {
+  HttpParseState state = HttpParseState::RequestLine;
+  // Everything before this has been parsed
+  size_t pos = 0;
+  // Of the body, or the current chunk
+  size_t body_left = 0;
+  bool chunked = false;
+  // Of the request line, headers and trailers, which HTTP_MAX_HEADER_BYTES
+  // limits
+  size_t head_bytes = 0;
+  HttpRequest req;
+  // The status to answer with, after Error
+  int error_status = 0;
+};
+
+void http_parser_reset(HttpParser *parser);
+
+// Parses what has arrived in buf since the last call.  With Done the request
+// is in parser->req and took up the first parser->pos bytes of buf, the rest
+// may already be the next one.
+HttpParse http_parse(HttpParser *parser, const std::string &buf);
+
+// Whether a response says where it ends, with Content-Length or chunked
+// encoding.  Anything else ends when the connection closes.
+bool http_response_framed(const std::string &response);
+
+// A bodyless response with the status' reason phrase, closing the connection
+std::string http_error_response(int status);
@@ -0,0 +1,145 @@
+#include "http_router.h"
+
+// Calls each(segment) for the segments of path up to its query string
+template <typename F> static void for_segments(const std::string &path, size_t end, F each) {
+  std::string segment;
+  size_t pos = 0;
+  while (pos < end) {
+    size_t next = path.find('/', pos);
+    if (next == std::string::npos || next > end) next = end;
+    if (next > pos) {
+      segment.assign(path, pos, next - pos);
+      if (!each(segment)) return;
+    }
+    pos = next + 1;
+  }
+}
+
+// The route a pattern names, made if it isn't there and make is set
+static HttpRoute *find_route(HttpRouter *router, const std::string &host, const std::string &pattern, bool make) {
+  if (pattern.empty() || pattern[0] != '/') return nullptr;
+
+  bool prefix = pattern.size() >= 2 && pattern.compare(pattern.size() - 2, 2, "/*") == 0;
+  size_t end = prefix ? pattern.size() - 1 : pattern.size();
+
+  auto found = router->hosts.find(host);
+  if (found == router->hosts.end()) {
+    if (!make) return nullptr;
+    found = router->hosts.emplace(host, new HttpRouteNode).first;
+  }
+
+  HttpRouteNode *node = found->second.get();
+  for_segments(pattern, end, [&](const std::string &segment) {
+    auto child = node->children.find(segment);
+    if (child == node->children.end()) {
+      if (!make) {
+        node = nullptr;
+        return false;
+      }
+      child = node->children.emplace(segment, new HttpRouteNode).first;
+    }
+    node = child->second.get();
+    return true;
+  });
+
+  if (node == nullptr) return nullptr;
+  return prefix ? &node->prefix : &node->exact;
+}
+
+static HttpRouteNode *copy_node(const HttpRouteNode *node) {
+  auto copy = new HttpRouteNode;
+  copy->exact = node->exact;
+  copy->prefix = node->prefix;
+  for (auto &child : node->children) {
+    copy->children.emplace(child.first, copy_node(child.second.get()));
+  }
+  return copy;
+}
+
+std::shared_ptr<const HttpRouter> http_router_copy(const HttpRouter *router) {
+  auto copy = std::make_shared<HttpRouter>();
+  for (auto &host : router->hosts) {
+    copy->hosts.emplace(host.first, copy_node(host.second.get()));
+  }
+  return copy;
+}
+
+static bool same_backend(const HttpBackend &a, const HttpBackend &b) {
+  return a.address.node_id == b.address.node_id && a.address.vat_id == b.address.vat_id && a.address.entity_id == b.address.entity_id &&
+         a.selector == b.selector;
+}
+
+bool http_route_add(HttpRouter *router, const std::string &host, const std::string &pattern, HttpBackend backend) {
+  HttpRoute *route = find_route(router, host, pattern, true);
+  if (route == nullptr) return false;
+
+  route->backends.push_back(backend);
+  return true;
+}
+
+bool http_route_remove(HttpRouter *router, const std::string &host, const std::string &pattern, HttpBackend backend) {
+  HttpRoute *route = find_route(router, host, pattern, false);
+  if (route == nullptr) return false;
+
+  for (auto it = route->backends.begin(); it != route->backends.end(); ++it) {
+    if (same_backend(*it, backend)) {
+      route->backends.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool http_route_cache(HttpRouter *router, const std::string &host, const std::string &pattern, int ttl_ms) {
+  HttpRoute *route = find_route(router, host, pattern, true);
+  if (route == nullptr) return false;
+
+  route->cache_ttl_ms = ttl_ms;
+  return true;
+}
+
+// Backends and cache TTL are matched separately, each by the best route
+// that has them
+static const HttpRoute *match(const HttpRouteNode *root, const std::string &path, size_t end, u32 *cache_ttl_ms) {
+  const HttpRouteNode *node = root;
+  const HttpRoute *best = nullptr;
+  int best_ttl = -1;
+  auto consider = [&](const HttpRoute *route) {
+    if (!route->backends.empty()) best = route;
+    if (route->cache_ttl_ms >= 0) best_ttl = route->cache_ttl_ms;
+  };
+
+  consider(&root->prefix);
+  bool whole_path = true;
+  for_segments(path, end, [&](const std::string &segment) {
+    auto child = node->children.find(segment);
+    if (child == node->children.end()) {
+      whole_path = false;
+      return false;
+    }
+    node = child->second.get();
+    consider(&node->prefix);
+    return true;
+  });
+  if (whole_path) consider(&node->exact);
+
+  *cache_ttl_ms = best_ttl > 0 ? best_ttl : 0;
+  return best;
+}
+
+const HttpRoute *http_route_match(const HttpRouter *router, const std::string &host, const std::string &path, u32 *cache_ttl_ms) {
+  size_t end = path.find_first_of("?#");
+  if (end == std::string::npos) end = path.size();
+
+  const HttpRoute *route = nullptr;
+  for (auto name : {host.c_str(), HTTP_ANY_HOST}) {
+    auto found = router->hosts.find(name);
+    if (found != router->hosts.end()) route = match(found->second.get(), path, end, cache_ttl_ms);
+    if (route != nullptr) break;
+  }
+  return route;
+}
+
+const HttpBackend &http_route_pick(const HttpRoute *route, u32 turn) {
+  return route->backends[turn % route->backends.size()];
+}
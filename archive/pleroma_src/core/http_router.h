@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../hylic_eval.h"
+#include "../selector.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The HttpLb's routes, by host and then path.  A host's paths are a trie of
+// their segments, so a request is routed by walking its path once however
+// many routes there are.  Routes are "/a/b" for that path only or "/a/*"
+// for it and everything under it; the longest matching one wins and exact
+// paths win over prefixes.  Empty segments are skipped, so "/a//b/" is "/a/b".
+// Hosts are matched as the Host header has them, requests for hosts without
+// a matching route fall back to the "*" host's routes.
+
+// Routes for requests to hosts that have none of their own
+const char *const HTTP_ANY_HOST = "*";
+
+// A function of an entity, on any node, that answers requests
+struct HttpBackend {
+  EntityAddress address;
+  Selector selector;
+};
+
+// Requests are spread over the backends round robin
+struct HttpRoute {
+  std::vector<HttpBackend> backends;
+  // How long GET responses under the route are cached, see http_cache.h.
+  // -1 leaves it to a shorter prefix, 0 doesn't cache.
+  int cache_ttl_ms = -1;
+};
+
+struct HttpRouteNode {
+  std::unordered_map<std::string, std::unique_ptr<HttpRouteNode>> children;
+  HttpRoute exact;
+  HttpRoute prefix;
+};
+
+// Matching doesn't change the router, so one that is no longer changed can
+// be read from any number of threads
+struct HttpRouter {
+  std::unordered_map<std::string, std::unique_ptr<HttpRouteNode>> hosts;
+};
+
+// A copy sharing nothing with the router
+std::shared_ptr<const HttpRouter> http_router_copy(const HttpRouter *router);
+
+// False if the pattern isn't a path
+bool http_route_add(HttpRouter *router, const std::string &host, const std::string &pattern, HttpBackend backend);
+
+// False if the backend wasn't on that route
+bool http_route_remove(HttpRouter *router, const std::string &host, const std::string &pattern, HttpBackend backend);
+
+// Sets how long GET responses under the route are cached whichever route
+// answers them, 0 doesn't.  False if the pattern isn't a path.
+bool http_route_cache(HttpRouter *router, const std::string &host, const std::string &pattern, int ttl_ms);
+
+// The best route with backends for the request, nullptr if none match, and
+// how long its response may be cached.  The query string is not part of the
+// path.
+const HttpRoute *http_route_match(const HttpRouter *router, const std::string &host, const std::string &path, u32 *cache_ttl_ms);
+
+// The backend whose turn it is, turn being a count the caller keeps going up
+const HttpBackend &http_route_pick(const HttpRoute *route, u32 turn);
@@ -0,0 +1,332 @@
+#include "http_server.h"
+#include "../general_util.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <netinet/in.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+const int HTTP_MAX_EVENTS = 64;
+// Buffered past the request being answered before the connection is dropped
+const size_t HTTP_MAX_PIPELINED_BYTES = HTTP_MAX_HEADER_BYTES + HTTP_MAX_BODY_BYTES;
+
+// epoll data for the two fds that aren't connections, connection ids start
+// past them
+const u64 HTTP_LISTEN_TAG = 0;
+const u64 HTTP_WAKE_TAG = 1;
+
+// Connection ids are a per-thread count times this plus the thread's index,
+// so a response finds its thread without a lookup
+const int HTTP_MAX_THREADS = 64;
+const HttpConnId HTTP_MAX_CONN_SEQ = INT32_MAX / HTTP_MAX_THREADS;
+
+struct HttpConn {
+  HttpConnId id;
+  int fd;
+  // Starts at the request being parsed, pipelined ones may follow it
+  std::string in;
+  HttpParser parser;
+  // Being written, from out_sent on
+  std::string out;
+  size_t out_sent = 0;
+  // Waiting for the socket to take more of out
+  bool writing = false;
+  // Handed a request, waiting on its response
+  bool waiting = false;
+  // Once the response is written
+  bool keep_alive = false;
+  // The client shut down its side, what is buffered is all there will be
+  bool read_done = false;
+};
+
+// One per thread, each with its own SO_REUSEPORT listener so the kernel
+// spreads new connections over them
+struct HttpWorker {
+  int index;
+  int listen_fd = -1;
+  int epoll_fd = -1;
+  // Written to when responses are queued, to wake the thread
+  int wake_fd = -1;
+
+  // Only touched by the worker's thread
+  std::unordered_map<HttpConnId, HttpConn *> conns;
+  HttpConnId next_seq = 1;
+
+  std::mutex responses_mtx;
+  std::vector<std::pair<HttpConnId, std::string>> responses;
+};
+
+struct HttpServer {
+  std::vector<HttpWorker *> workers;
+  std::function<void(HttpRequest &&)> on_request;
+} http;
+
+static void close_conn(HttpWorker *w, HttpConn *conn) {
+  epoll_ctl(w->epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+  close(conn->fd);
+  w->conns.erase(conn->id);
+  delete conn;
+}
+
+static void watch_conn(HttpWorker *w, HttpConn *conn, int op, bool writing) {
+  epoll_event ev = {};
+  ev.events = 0;
+  if (!conn->read_done) ev.events |= EPOLLIN | EPOLLRDHUP;
+  if (writing) ev.events |= EPOLLOUT;
+  ev.data.u64 = conn->id;
+  epoll_ctl(w->epoll_fd, op, conn->fd, &ev);
+}
+
+static void next_request(HttpWorker *w, HttpConn *conn);
+
+// Writes as much of the response as the socket takes, then goes on to the
+// next request or closes.  False if the connection was closed.
+static bool flush_conn(HttpWorker *w, HttpConn *conn) {
+  while (conn->out_sent < conn->out.size()) {
+    ssize_t n = send(conn->fd, conn->out.data() + conn->out_sent, conn->out.size() - conn->out_sent, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        if (!conn->writing) watch_conn(w, conn, EPOLL_CTL_MOD, true);
+        conn->writing = true;
+        return true;
+      }
+      if (errno == EINTR) continue;
+      close_conn(w, conn);
+      return false;
+    }
+    conn->out_sent += n;
+  }
+
+  if (!conn->keep_alive) {
+    close_conn(w, conn);
+    return false;
+  }
+
+  if (conn->writing) watch_conn(w, conn, EPOLL_CTL_MOD, false);
+  conn->writing = false;
+  conn->out.clear();
+  conn->out_sent = 0;
+  conn->waiting = false;
+  HttpConnId id = conn->id;
+  next_request(w, conn);
+  return w->conns.count(id) > 0;
+}
+
+static void respond_now(HttpWorker *w, HttpConn *conn, std::string response, bool keep_alive) {
+  conn->out = std::move(response);
+  conn->out_sent = 0;
+  conn->keep_alive = keep_alive && http_response_framed(conn->out);
+  flush_conn(w, conn);
+}
+
+// Hands over the next request if it has all arrived
+static void next_request(HttpWorker *w, HttpConn *conn) {
+  HttpParse result = http_parse(&conn->parser, conn->in);
+  if (result == HttpParse::More) {
+    // Nothing more is coming to finish it
+    if (conn->read_done) close_conn(w, conn);
+    return;
+  }
+
+  if (result == HttpParse::Error) {
+    conn->waiting = true;
+    respond_now(w, conn, http_error_response(conn->parser.error_status), false);
+    return;
+  }
+
+  HttpRequest req = std::move(conn->parser.req);
+  req.conn = conn->id;
+  conn->keep_alive = req.keep_alive;
+  conn->in.erase(0, conn->parser.pos);
+  http_parser_reset(&conn->parser);
+
+  conn->waiting = true;
+  http.on_request(std::move(req));
+}
+
+static void read_conn(HttpWorker *w, HttpConn *conn) {
+  char buf[16 * 1024];
+  while (true) {
+    ssize_t n = recv(conn->fd, buf, sizeof(buf), 0);
+    if (n > 0) {
+      conn->in.append(buf, n);
+      if (conn->in.size() > HTTP_MAX_PIPELINED_BYTES) {
+        // Pipelining far ahead of the responses
+        close_conn(w, conn);
+        return;
+      }
+      // Parse before reading on, so headers past the limit are refused as
+      // soon as they are, the rest is read on the next wakeup
+      bool in_head = conn->parser.state == HttpParseState::RequestLine || conn->parser.state == HttpParseState::Headers;
+      if (!conn->waiting && in_head && conn->in.size() > HTTP_MAX_HEADER_BYTES) break;
+      continue;
+    }
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+
+    if (n < 0) {
+      // Broken
+      close_conn(w, conn);
+      return;
+    }
+
+    // Shut down by the client, it may still be waiting on the responses to
+    // what it sent
+    conn->read_done = true;
+    watch_conn(w, conn, EPOLL_CTL_MOD, conn->writing);
+    break;
+  }
+
+  if (!conn->waiting) next_request(w, conn);
+}
+
+static void accept_conns(HttpWorker *w) {
+  while (true) {
+    int fd = accept4(w->listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        dbp(log_warning, "HTTP accept failed: %s", strerror(errno));
+      }
+      return;
+    }
+
+    HttpConn *conn = new HttpConn;
+    conn->id = w->next_seq * HTTP_MAX_THREADS + w->index;
+    w->next_seq = w->next_seq < HTTP_MAX_CONN_SEQ ? w->next_seq + 1 : 1;
+    conn->fd = fd;
+    w->conns[conn->id] = conn;
+    watch_conn(w, conn, EPOLL_CTL_ADD, false);
+  }
+}
+
+static void send_responses(HttpWorker *w) {
+  u64 n_wakes;
+  while (read(w->wake_fd, &n_wakes, sizeof(n_wakes)) > 0) {
+  }
+
+  std::vector<std::pair<HttpConnId, std::string>> responses;
+  w->responses_mtx.lock();
+  responses.swap(w->responses);
+  w->responses_mtx.unlock();
+
+  for (auto &rsp : responses) {
+    auto found = w->conns.find(rsp.first);
+    if (found == w->conns.end()) continue;
+    respond_now(w, found->second, std::move(rsp.second), found->second->keep_alive);
+  }
+}
+
+static void serve(HttpWorker *w) {
+  epoll_event events[HTTP_MAX_EVENTS];
+  while (true) {
+    int n = epoll_wait(w->epoll_fd, events, HTTP_MAX_EVENTS, -1);
+    for (int k = 0; k < n; ++k) {
+      u64 tag = events[k].data.u64;
+      if (tag == HTTP_LISTEN_TAG) {
+        accept_conns(w);
+      } else if (tag == HTTP_WAKE_TAG) {
+        send_responses(w);
+      } else {
+        // May have been closed by an earlier event in this batch
+        auto found = w->conns.find((HttpConnId)tag);
+        if (found == w->conns.end()) continue;
+        HttpConn *conn = found->second;
+
+        if (events[k].events & EPOLLOUT) {
+          if (!flush_conn(w, conn)) continue;
+        }
+        if (conn->read_done) {
+          // Only reported once both directions are gone
+          if (events[k].events & (EPOLLHUP | EPOLLERR)) close_conn(w, conn);
+        } else if (events[k].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+          read_conn(w, conn);
+        }
+      }
+    }
+  }
+}
+
+static int listen_on(u16 port, int backlog) {
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    perror("socket failed");
+    exit(EXIT_FAILURE);
+  }
+
+  // Every worker binds the same port
+  int opt = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) || setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
+    perror("setsockopt");
+    exit(EXIT_FAILURE);
+  }
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = INADDR_ANY;
+  address.sin_port = htons(port);
+  if (bind(fd, (sockaddr *)&address, sizeof(address)) < 0) {
+    perror("bind failed");
+    exit(EXIT_FAILURE);
+  }
+  if (listen(fd, backlog) < 0) {
+    perror("listen");
+    exit(EXIT_FAILURE);
+  }
+  return fd;
+}
+
+void http_server_start(u16 port, int backlog, int n_threads, std::function<void(HttpRequest &&)> on_request) {
+  if (!http.workers.empty()) return;
+
+  http.on_request = on_request;
+  n_threads = std::max(1, std::min(n_threads, HTTP_MAX_THREADS));
+
+  for (int k = 0; k < n_threads; ++k) {
+    HttpWorker *w = new HttpWorker;
+    w->index = k;
+    w->listen_fd = listen_on(port, backlog);
+    w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    w->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = HTTP_LISTEN_TAG;
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->listen_fd, &ev);
+    ev.data.u64 = HTTP_WAKE_TAG;
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->wake_fd, &ev);
+
+    http.workers.push_back(w);
+  }
+
+  // Started once they're all in, responses may go to any of them
+  for (auto w : http.workers) {
+    std::thread(serve, w).detach();
+  }
+
+  dbp(log_info, "Serving HTTP on port %d from %d threads (backlog %d)", port, n_threads, backlog);
+}
+
+void http_server_respond(HttpConnId conn, std::string response) {
+  int index = conn % HTTP_MAX_THREADS;
+  if (conn < 0 || index >= (int)http.workers.size()) return;
+  HttpWorker *w = http.workers[index];
+
+  w->responses_mtx.lock();
+  w->responses.push_back(std::make_pair(conn, std::move(response)));
+  w->responses_mtx.unlock();
+
+  u64 one = 1;
+  write(w->wake_fd, &one, sizeof(one));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../common.h"
+#include "http_parser.h"
+#include <functional>
+#include <string>
+
+// HTTP connections served without blocking from epoll threads, so a slow
+// client holds up nobody.  Each thread has its own SO_REUSEPORT listener on
+// the port and the kernel spreads connections over them.  Requests are handed
+// to the callback once complete, on the connection's thread, and answered
+// later through the connection's id from any thread.  Connections are kept
+// alive between requests when both the request and the response allow it.
+// Pipelined requests are taken one at a time, the next is handed over once
+// the response to the last is written.  A client that shuts down its side
+// after writing is still answered before the connection closes.
+
+// Listens on the port and starts the threads, once
+void http_server_start(u16 port, int backlog, int n_threads, std::function<void(HttpRequest &&)> on_request);
+
+// Queues the response to the connection's request.  Responses without a
+// Content-Length or chunked encoding close the connection, since that is
+// where they end.  Connections that have gone away since are skipped.
+void http_server_respond(HttpConnId conn, std::string response);
@@ -35,8 +35,8 @@ std::vector<PleromaNode*> nodes;
 // Always 1, because we count the Monad
 int n_running_programs = 1;
 
-void load_software() {
-  programs["helloworld"] = load_file("helloworld", "examples/helloworld.plm");
+void load_software(std::string name, std::string path) {
+  programs[name] = load_file(name, path);
 }
 
 void add_new_pnode(PleromaNode* node) {
@@ -53,12 +53,16 @@ void nodeman_log(std::string log_str) {
   dbp(log_debug, "\033[1;36m(NodeMan)\033[0m %s", log_str.c_str());
 }
 
-// Tries to schedule a vat on the current node set, returns true if it was possible
+// Tries to schedule a vat on the current node set, returns the node or null
+// if none has the resources it needs.  Vats are spread over the nodes that
+// do in turn.
 PleromaNode* try_preschedule(EntityDef* edef) {
+  static size_t next_node = 0;
 
   PleromaNode* node = nullptr;
   node_mtx.lock();
-  for (auto &k : nodes) {
+  for (size_t n = 0; n < nodes.size() && !node; ++n) {
+    PleromaNode *k = nodes[(next_node + n) % nodes.size()];
     bool satisfied = true;
     for (auto &rq : edef->preamble) {
       if (std::find(k->resources.begin(), k->resources.end(), rq) == k->resources.end()) {
@@ -67,6 +71,7 @@ PleromaNode* try_preschedule(EntityDef* edef) {
     }
     if (satisfied) {
       node = k;
+      next_node = (next_node + n + 1) % nodes.size();
     }
   }
   node_mtx.unlock();
@@ -114,7 +119,7 @@ AstNode *monad_new_vat(EvalContext *context, std::vector<AstNode *> args) {
     printf("Sending create-vat to %d %d %d\n", sched_node->nodeman_addr.node_id, sched_node->nodeman_addr.vat_id, sched_node->nodeman_addr.entity_id);
     //FIXME hardcoded nodeman
 
-    auto prom = eval_message_node(context, (EntityRefNode *)make_entity_ref(sched_node->nodeman_addr.node_id, sched_node->nodeman_addr.vat_id, sched_node->nodeman_addr.entity_id), CommMode::Async, "create-vat", args);
+    auto prom = eval_message_node(context, (EntityRefNode *)make_entity_ref(sched_node->nodeman_addr.node_id, sched_node->nodeman_addr.vat_id, sched_node->nodeman_addr.entity_id), CommMode::Async, intern_selector("create-vat"), args);
 
     //eval(context, make_assignment(make_symbol("nodemanref"), eval_val));
     //auto eref = (EntityRefNode*)context->vat->promises[eval_val->promise_id].results[0];
@@ -156,7 +161,7 @@ AstNode *monad_irq_handler(EvalContext *context, std::vector<AstNode*> args) {
 
   for (auto &k : irq_subscriptions[irq_num->value]) {
     printf("Sending to \n");
-    eval_message_node(context, k, CommMode::Async, "handle-input", {make_number(irq_data->value)});
+    eval_message_node(context, k, CommMode::Async, intern_selector("handle-input"), {make_number(irq_data->value)});
     printf("SEnt to \n");
   }
   return make_number(0);
@@ -184,7 +189,7 @@ AstNode *monad_start_program(EvalContext *context, std::vector<AstNode*> args) {
   auto eref = monad_new_vat(context, args);
   // FIXME: hardcoded NodeMan address
 
-  auto finaly = eval_message_node(context, eref, CommMode::Async, "main", {make_number(0)});
+  auto finaly = eval_message_node(context, eref, CommMode::Async, intern_selector("main"), {make_number(0)});
   return finaly;
 }
 
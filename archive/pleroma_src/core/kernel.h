@@ -12,4 +12,5 @@ AstNode *monad_start_program(EvalContext *context, EntityRefNode *eref);
 
 void add_new_pnode(PleromaNode *node);
 
-void load_software();
+// Loads a program the Monad can start vats of, under the given name
+void load_software(std::string name, std::string path);
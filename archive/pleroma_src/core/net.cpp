@@ -3,126 +3,243 @@
 #include "../hylic_ast.h"
 #include "../hylic_eval.h"
 #include "../type_util.h"
+#include "../gc.h"
+#include "../netcode.h"
+#include "../scheduler.h"
+#include "../pleroma.h"
 #include "ffi.h"
+#include "http_cache.h"
+#include "http_router.h"
+#include "http_server.h"
 
-#include <cstring>
-#include <netinet/in.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string>
-#include <sys/socket.h>
-#include <unistd.h>
+#include <unordered_map>
 
 extern std::map<std::string, AstNode *> kernel_map;
 
-int server_fd, new_socket, valread;
-struct sockaddr_in address;
-int opt = 1;
-int addrlen = sizeof(address);
-char buffer[1024] = {0};
+// Only touched by the HttpLb's vat, the server threads route with copies
+HttpRouter router;
+
+// The copy of the routes the server threads are to use, replaced by the
+// HttpLb's vat on every change.  The version says when to look again, so a
+// thread only takes the lock once per change.
+std::mutex published_mtx;
+std::shared_ptr<const HttpRouter> published_router;
+std::atomic<u64> published_version{0};
+
+// Backends answer the requests to this "vat", with the connection's id as
+// the promise id, see set_native_mailbox
+const int HTTP_VAT_ID = -2;
+
+// What a request on a cached route needs to put its response
+struct PendingCache {
+  std::string key;
+  u32 ttl_ms;
+  u64 generation;
+};
+// A connection has at most one request being answered
+std::mutex pending_mtx;
+std::unordered_map<HttpConnId, PendingCache> pending_cache;
+
+// Read by the server threads
+HttpCache cache;
+
+static void publish_router() {
+  auto copy = http_router_copy(&router);
+  std::lock_guard<std::mutex> lock(published_mtx);
+  published_router = std::move(copy);
+  published_version++;
+}
 
-// Host -> Entity
-std::map<std::string, std::tuple<EntityRefNode *, std::string>> host_entity_lookup;
+static const HttpRouter *current_router() {
+  thread_local std::shared_ptr<const HttpRouter> seen_router;
+  thread_local u64 seen_version = 0;
+  if (published_version.load() != seen_version) {
+    std::lock_guard<std::mutex> lock(published_mtx);
+    seen_router = published_router;
+    seen_version = published_version.load();
+  }
+  return seen_router.get();
+}
 
-AstNode *net_return_http_result(EvalContext *context, std::vector<AstNode *> args) {
-  assert(args[0]->type == AstNodeType::StringNode);
+static AstNode *exported_string(std::string str) {
+  auto str_node = make_string(str);
+  str_node->gc_gen = GcGen::Exported;
+  return str_node;
+}
 
-  auto res_str = (StringNode *)args[0];
-  printf("calling return result %s\n", res_str->value.c_str());
-  send(new_socket, res_str->value.c_str(), strlen(res_str->value.c_str()), 0);
-  close(new_socket);
+// On the server thread, so the strings are exported like anything else
+// arriving from outside a vat.  The request goes straight to its backend,
+// whose handler gets verb, path, headers and body.
+static void on_http_request(HttpRequest &&req) {
+  std::string key;
+  if (req.verb == "GET") {
+    key = http_cache_key(req.host, req.path);
+    std::string cached;
+    if (http_cache_get(&cache, key, &cached)) {
+      http_server_respond(req.conn, std::move(cached));
+      return;
+    }
+  }
 
-  eval_message_node(context, (EntityRefNode *)make_entity_ref(-1, -1, -1), CommMode::Async, "next", {});
+  const HttpRouter *routes = current_router();
+  u32 cache_ttl_ms = 0;
+  const HttpRoute *route = routes ? http_route_match(routes, req.host, req.path, &cache_ttl_ms) : nullptr;
+  if (route == nullptr) {
+    http_server_respond(req.conn, http_error_response(404));
+    return;
+  }
+  if (!key.empty() && cache_ttl_ms > 0) {
+    std::lock_guard<std::mutex> lock(pending_mtx);
+    pending_cache[req.conn] = {std::move(key), cache_ttl_ms, http_cache_generation(&cache)};
+  }
 
-  return make_nop();
-}
+  // A connection's next request only arrives once this one is answered, so
+  // its responses stay in order whichever backend takes it
+  thread_local u32 turn = 0;
+  const HttpBackend &backend = http_route_pick(route, turn++);
 
-AstNode *net_start(EvalContext *context, std::vector<AstNode *> args) {
+  Msg m;
+  m.node_id = backend.address.node_id;
+  m.vat_id = backend.address.vat_id;
+  m.entity_id = backend.address.entity_id;
+  m.selector = backend.selector;
 
-  // Creating socket file descriptor
-  if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
-    perror("socket failed");
-    exit(EXIT_FAILURE);
+  for (auto str : {req.verb, req.path}) {
+    m.values.push_back(node_value(exported_string(str)));
   }
-
-  // Forcefully attaching socket to the port 8080
-  if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &opt, sizeof(opt))) {
-    perror("setsockopt");
-    exit(EXIT_FAILURE);
+  std::vector<AstNode *> headers;
+  for (auto &header : req.headers) {
+    headers.push_back(exported_string(header));
+  }
+  auto header_list = make_list(headers, nullptr);
+  header_list->gc_gen = GcGen::Exported;
+  m.values.push_back(node_value(header_list));
+  m.values.push_back(node_value(exported_string(req.body)));
+
+  m.src_node_id = this_pleroma_node->node_id;
+  m.src_vat_id = HTTP_VAT_ID;
+  m.src_entity_id = 0;
+  m.promise_id = req.conn;
+
+  if (m.node_id == (int)this_pleroma_node->node_id) {
+    deliver_local_msg(std::move(m));
+  } else {
+    net_out_queue.enqueue(std::move(m));
   }
-  address.sin_family = AF_INET;
-  address.sin_addr.s_addr = INADDR_ANY;
-  address.sin_port = htons(8080);
-
-  // Forcefully attaching socket to the port 8080
-  if (bind(server_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
-    perror("bind failed");
-    exit(EXIT_FAILURE);
+}
+
+// On whichever thread delivers the handler's answer
+static void on_http_response(Msg &&m) {
+  HttpConnId conn = m.promise_id;
+
+  bool cacheable = false;
+  PendingCache pending;
+  {
+    std::lock_guard<std::mutex> lock(pending_mtx);
+    auto found = pending_cache.find(conn);
+    if (found != pending_cache.end()) {
+      cacheable = true;
+      pending = std::move(found->second);
+      pending_cache.erase(found);
+    }
   }
-  if (listen(server_fd, 3) < 0) {
-    perror("listen");
-    exit(EXIT_FAILURE);
+
+  if (m.values.size() == 1 && m.values[0].tag == ValueTag::Node && m.values[0].node->type == AstNodeType::StringNode) {
+    std::string &response = ((StringNode *)m.values[0].node)->value;
+    if (cacheable && (response.compare(0, 13, "HTTP/1.1 200 ") == 0 || response.compare(0, 13, "HTTP/1.0 200 ") == 0)) {
+      http_cache_put(&cache, pending.key, response, pending.ttl_ms, pending.generation);
+    }
+    http_server_respond(conn, std::move(response));
+  } else {
+    dbp(log_warning, "Handler %s answered connection %d without a response", selector_name(m.selector).c_str(), conn);
+    http_server_respond(conn, http_error_response(500));
   }
 
-  std::string hostname = ((StringNode *)args[0])->value;
-  auto entity_ref = ((EntityRefNode *)args[1]);
-  std::string callback = ((StringNode *)args[2])->value;
+  release_msg(m);
+}
 
-  printf("registered %s\n", hostname.c_str());
-  host_entity_lookup[hostname] =
-      std::make_tuple((EntityRefNode *)make_entity_ref(entity_ref->node_id, entity_ref->vat_id, entity_ref->entity_id), callback);
+// The server is started by the first route, later ones take effect from the
+// next request
+static AstNode *add_route(std::string host, std::string pattern, EntityRefNode *entity_ref, std::string callback) {
+  HttpBackend backend = {{entity_ref->node_id, entity_ref->vat_id, entity_ref->entity_id}, intern_selector(callback)};
+  if (!http_route_add(&router, host, pattern, backend)) {
+    dbp(log_warning, "Not a route: %s%s", host.c_str(), pattern.c_str());
+    return make_number(0);
+  }
+  printf("registered %s%s\n", host.c_str(), pattern.c_str());
+  publish_router();
+
+  set_native_mailbox(HTTP_VAT_ID, on_http_response);
+  HttpConfig &config = this_pleroma_node->http_config;
+  cache.max_bytes = config.cache_bytes;
+  int n_threads = config.threads > 0 ? config.threads : scheduler_burner_count();
+  http_server_start(config.port, config.backlog, n_threads, on_http_request);
 
   return make_number(0);
 }
 
-AstNode *net_next(EvalContext *context, std::vector<AstNode *> args) {
-  if ((new_socket = accept(server_fd, (struct sockaddr *)&address, (socklen_t *)&addrlen), SOCK_NONBLOCK) < 0) {
-    perror("accept");
-    exit(EXIT_FAILURE);
+static AstNode *remove_route(std::string host, std::string pattern, EntityRefNode *entity_ref, std::string callback) {
+  HttpBackend backend = {{entity_ref->node_id, entity_ref->vat_id, entity_ref->entity_id}, intern_selector(callback)};
+  if (http_route_remove(&router, host, pattern, backend)) {
+    printf("unregistered %s%s\n", host.c_str(), pattern.c_str());
+    publish_router();
+    http_cache_invalidate(&cache, host, pattern);
   }
-  valread = read(new_socket, buffer, 1024);
+  return make_number(0);
+}
 
-  std::string verb;
-  std::string path;
-  std::string version;
+// Everything on the host.  Starting a host again adds a backend, requests
+// are spread over them.
+AstNode *net_start(EvalContext *context, std::vector<AstNode *> args) {
+  return add_route(((StringNode *)args[0])->value, "/*", (EntityRefNode *)args[1], ((StringNode *)args[2])->value);
+}
 
-  std::istringstream iss(buffer, std::istringstream::in);
+AstNode *net_stop(EvalContext *context, std::vector<AstNode *> args) {
+  return remove_route(((StringNode *)args[0])->value, "/*", (EntityRefNode *)args[1], ((StringNode *)args[2])->value);
+}
 
-  iss >> verb;
-  iss >> path;
-  iss >> version;
+// A path, or everything under a path with a trailing "/*", see http_router.h
+AstNode *net_route(EvalContext *context, std::vector<AstNode *> args) {
+  return add_route(((StringNode *)args[0])->value, ((StringNode *)args[1])->value, (EntityRefNode *)args[2],
+                   ((StringNode *)args[3])->value);
+}
 
-  std::string header, header_contents;
-  std::string hostname;
+AstNode *net_unroute(EvalContext *context, std::vector<AstNode *> args) {
+  return remove_route(((StringNode *)args[0])->value, ((StringNode *)args[1])->value, (EntityRefNode *)args[2], ((StringNode *)args[3])->value);
+}
 
-  while (iss >> header) {
-    iss >> header_contents;
+// Opts the route's GET requests into the cache for ttl milliseconds, 0 opts
+// out.  Successful responses are kept; the route's owner invalidates them
+// when what they show changes.
+AstNode *net_cache(EvalContext *context, std::vector<AstNode *> args) {
+  std::string host = ((StringNode *)args[0])->value;
+  std::string pattern = ((StringNode *)args[1])->value;
+  int ttl_ms = ((NumberNode *)args[2])->value;
 
-    if (header == "Host:") {
-      hostname = header_contents;
-    }
-  }
-
-  if (host_entity_lookup.find(hostname) == host_entity_lookup.end()) {
-    printf("couldn't find it\n");
-    std::string rsp404 = "HTTP/1.1 404 Not Found";
-    send(new_socket, rsp404.c_str(), strlen(rsp404.c_str()), 0);
-    close(new_socket);
+  if (ttl_ms < 0 || !http_route_cache(&router, host, pattern, ttl_ms)) {
+    dbp(log_warning, "Can't cache %s%s for %dms", host.c_str(), pattern.c_str(), ttl_ms);
     return make_number(0);
   }
-  auto host_ref = host_entity_lookup[hostname];
-  // AstNode* res = eval_message_node(context, (EntityRefNode*)make_entity_ref(0, 0, 2), MessageDistance::Local, CommMode::Sync, "test",
-  // {make_string(buffer)});
-  PromiseNode *res = (PromiseNode *)eval_message_node(context, std::get<0>(host_ref), CommMode::Async, std::get<1>(host_ref), {make_string(verb), make_string(path)});
-
-  eval_message_node(context, make_self(), CommMode::Async, "return-http-result", {res});
-  //{make_message_node(make_self(), "return-http-result", CommMode::Async, {res})}));
-  // context->vat->promises[res->promise_id].callbacks.push_back((PromiseResNode *)make_promise_resolution_node("anon",
-  // {make_message_node(make_self(), "return-http-result", CommMode::Async, {res})}));
+  publish_router();
+  if (ttl_ms == 0) {
+    http_cache_invalidate(&cache, host, pattern);
+  }
+  return make_number(0);
+}
 
-  //context->vat->promises[res->promise_id].callbacks.push_back((PromiseResNode *)make_promise_resolution_node(
-  //    "anon", {make_message_node(make_entity_ref(0, 0, 1), "print", CommMode::Async, {make_string("blah")})}));
+AstNode *net_invalidate(EvalContext *context, std::vector<AstNode *> args) {
+  http_cache_invalidate(&cache, ((StringNode *)args[0])->value, ((StringNode *)args[1])->value);
+  return make_number(0);
+}
 
+// Requests are delivered as they arrive, this is kept for programs written
+// against the server that took them one at a time
+AstNode *net_next(EvalContext *context, std::vector<AstNode *> args) {
   return make_number(0);
 }
 
@@ -145,9 +262,13 @@ std::map<std::string, AstNode *> load_net() {
   blarg->basetype = PType::str;
 
   functions["start"] = setup_direct_call(net_start, "start", {"host", "e", "func"}, {blarg, blah, blarg}, none_type);
+  functions["stop"] = setup_direct_call(net_stop, "stop", {"host", "e", "func"}, {blarg, blah, blarg}, none_type);
+  functions["route"] = setup_direct_call(net_route, "route", {"host", "path", "e", "func"}, {blarg, blarg, blah, blarg}, none_type);
+  functions["unroute"] = setup_direct_call(net_unroute, "unroute", {"host", "path", "e", "func"}, {blarg, blarg, blah, blarg}, none_type);
+  functions["cache"] = setup_direct_call(net_cache, "cache", {"host", "path", "ttl"}, {blarg, blarg, lu8()}, none_type);
+  functions["invalidate"] = setup_direct_call(net_invalidate, "invalidate", {"host", "path"}, {blarg, blarg}, none_type);
   functions["next"] = setup_direct_call(net_next, "next", {}, {}, none_type);
   functions["create"] = setup_direct_call(net_create, "create", {}, {}, none_type);
-  functions["return-http-result"] = setup_direct_call(net_return_http_result, "return-http-result", {"res"}, {blarg}, none_type);
 
   kernel_map["HttpLb"] = make_actor(nullptr, "HttpLb", functions, {}, {}, {}, {});
 
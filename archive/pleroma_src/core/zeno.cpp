@@ -104,14 +104,14 @@ AstNode *zfile_assemble_chunks(EvalContext *context, std::vector<AstNode *> args
 
 AstNode *zfile_test(EvalContext *context, std::vector<AstNode *> args) {
 
-  auto m1 = eval_message_node(context, cfs(context).entity->data["zm"], CommMode::Async, "checkout", {args[0]});
+  auto m1 = eval_message_node(context, box_value(entity_field(cfs(context).entity, "zm")), CommMode::Async, intern_selector("checkout"), {args[0]});
 
   CType *str_type = new CType;
   str_type->basetype = PType::str;
   str_type->dtype = DType::Local;
 
   auto slist = make_list({make_string("example-0.dat"), make_string("example-1.dat")}, str_type);
-  auto m2 = eval_message_node(context, make_entity_ref(-1, -1, -1), CommMode::Sync, "assemble-chunks", {slist});
+  auto m2 = eval_message_node(context, make_entity_ref(-1, -1, -1), CommMode::Sync, intern_selector("assemble-chunks"), {slist});
 
   return m2;
 }
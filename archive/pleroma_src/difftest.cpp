@@ -0,0 +1,89 @@
+#include "difftest.h"
+#include "hylic.h"
+#include "hylic_ast.h"
+#include "hylic_eval.h"
+#include "other.h"
+#include <stdio.h>
+#include <string>
+
+struct DiffOutcome {
+  bool threw = false;
+  std::string error;
+  std::string result;
+  std::string fields;
+  int n_out_messages = 0;
+};
+
+// Each run gets its own copy of the program and its own node and vat,
+// neither registered with the scheduler
+DiffOutcome run_under(ExecEngine engine, std::string path, std::string ent_name, Selector sel) {
+  DiffOutcome outcome;
+
+  HylicModule *module = load_file("test", path);
+  EntityDef *entity_def = (EntityDef *)module->entity_defs[ent_name];
+
+  PleromaNode node;
+  node.engine = engine;
+  Vat *vat = new Vat;
+  vat->allocator = create_vat_allocator();
+
+  AllocatorScope vat_scope(vat->allocator);
+  EvalContext context;
+  start_context(&context, &node, vat, entity_def->module, nullptr);
+
+  try {
+    Entity *ent = create_entity(&context, entity_def, false);
+    outcome.result = value_to_string(eval_func_local(&context, ent, sel, {}));
+
+    for (auto field : ent->fields) {
+      outcome.fields += value_to_string(field) + " ";
+    }
+  } catch (PleromaException &e) {
+    outcome.threw = true;
+    outcome.error = e.what();
+  }
+
+  outcome.n_out_messages = vat->out_messages.size();
+
+  // Nothing from the run is looked at again, the vat goes in one step
+  destroy_vat_allocator(vat->allocator);
+  return outcome;
+}
+
+int run_difftest(std::string path) {
+  HylicModule *module = load_file("test", path);
+  int n_mismatches = 0;
+
+  for (auto &[ent_name, v] : module->entity_defs) {
+    auto entity_def = (EntityDef *)v;
+
+    // Inocaps need a running monad to hand them out
+    if (!entity_def->inocaps.empty()) {
+      printf("Skipping %s: has inocaps\n", ent_name.c_str());
+      continue;
+    }
+
+    for (auto &[func_name, func] : entity_def->functions) {
+      if (!func->args.empty()) continue;
+
+      Selector sel = intern_selector(func_name);
+      DiffOutcome ast = run_under(ExecEngine::Ast, path, ent_name, sel);
+      DiffOutcome vm = run_under(ExecEngine::Vm, path, ent_name, sel);
+
+      bool same = ast.threw == vm.threw && ast.error == vm.error &&
+                  ast.result == vm.result && ast.fields == vm.fields &&
+                  ast.n_out_messages == vm.n_out_messages;
+
+      if (same) {
+        printf("\033[1;32mSame:\033[0m %s::%s => %s\n", ent_name.c_str(), func_name.c_str(), ast.threw ? ast.error.c_str() : ast.result.c_str());
+      } else {
+        n_mismatches++;
+        printf("\033[1;31mDiffers:\033[0m %s::%s\n", ent_name.c_str(), func_name.c_str());
+        printf("\tast: %s %s | fields: %s| out: %d\n", ast.threw ? "threw" : "returned", ast.threw ? ast.error.c_str() : ast.result.c_str(), ast.fields.c_str(), ast.n_out_messages);
+        printf("\tvm:  %s %s | fields: %s| out: %d\n", vm.threw ? "threw" : "returned", vm.threw ? vm.error.c_str() : vm.result.c_str(), vm.fields.c_str(), vm.n_out_messages);
+      }
+    }
+  }
+
+  return n_mismatches;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+// Loads a Hylic file and runs every zero-argument function on a fresh entity
+// under both the tree walker and the bytecode VM.  Returns the number of
+// functions whose result, entity variables or failure differed.
+int run_difftest(std::string path);
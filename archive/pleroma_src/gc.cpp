@@ -1,47 +1,414 @@
-
 #include "hylic_ast.h"
 #include "hylic_eval.h"
+#include "general_util.h"
 #include "gc.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Every vat collects its own heap, on the burner dispatching it.
+//
+// Nodes start young.  A minor collection marks the young nodes reachable from
+// the roots or from the old lists in the remembered set, frees the rest and
+// promotes what survived.  A major collection marks and sweeps both
+// generations, in one go or a slice per dispatch when incremental.  While an
+// incremental mark is running new nodes are born marked and anything stored
+// into a list is shaded, and the roots are scanned again before sweeping.
+//
+// The roots are entity fields and kernel data, promise results, arguments of
+// sends waiting on a promise, the message a promise will answer, and messages
+// that haven't left the vat yet.  Collections only happen between messages so
+// there are never frames to scan.
+
+u64 node_bytes(AstNode *node) {
+  switch (node->type) {
+  case AstNodeType::NumberNode:
+    return sizeof(NumberNode);
+  case AstNodeType::StringNode:
+    return sizeof(StringNode) + ((StringNode *)node)->value.capacity();
+  case AstNodeType::ListNode:
+    return sizeof(ListNode) + ((ListNode *)node)->list.capacity() * sizeof(AstNode *);
+  case AstNodeType::EntityRefNode:
+    return sizeof(EntityRefNode);
+  case AstNodeType::PromiseNode:
+    return sizeof(PromiseNode);
+  default:
+    return sizeof(AstNode);
+  }
+}
+
+static inline bool is_managed(AstNode *node) {
+  return node && (node->gc_gen == GcGen::Young || node->gc_gen == GcGen::Old);
+}
+
+// Marks a node and queues it to have its children scanned.  young_only stops
+// at the old generation, minor collections find old to young pointers
+// through the remembered set instead.
+static inline void shade(VatHeap *heap, AstNode *node, bool young_only) {
+  if (!is_managed(node) || node->marked) return;
+  if (young_only && node->gc_gen == GcGen::Old) return;
+
+  node->marked = true;
+  if (node->type == AstNodeType::ListNode) {
+    heap->gray.push_back(node);
+  }
+}
+
+static inline void shade_value(VatHeap *heap, Value &v, bool young_only) {
+  if (v.tag == ValueTag::Node) shade(heap, v.node, young_only);
+}
+
+static void shade_msg(VatHeap *heap, Msg &m, bool young_only) {
+  for (auto &v : m.values) {
+    shade_value(heap, v, young_only);
+  }
+}
 
-void mark(AstNode* root) {
-  root->marked = true;
+static void shade_roots(Vat *vat, bool young_only) {
+  VatHeap *heap = &vat->heap;
 
-  switch (root->type) {
-    case AstNodeType::ListNode:{
-      auto tmp_lst = safe_ncast<ListNode*>(root, AstNodeType::ListNode);
-      for (auto &k : tmp_lst->list) {
-        mark(k);
+  for (auto &[ent_id, ent] : vat->entities) {
+    for (auto &v : ent->fields) {
+      shade_value(heap, v, young_only);
+    }
+    for (auto &[key, node] : ent->_kdata) {
+      shade(heap, node, young_only);
+    }
+  }
+
+  vat->promises.for_each([&](int, PromiseResult &prom) {
+    for (auto &v : prom.results) {
+      shade_value(heap, v, young_only);
+    }
+    for (auto dpf : prom.dependents) {
+      for (auto &v : dpf->args) {
+        shade_value(heap, v, young_only);
       }
-    } break;
+    }
+    if (prom.return_msg) {
+      shade_msg(heap, *prom.return_msg, young_only);
+    }
+  });
+
+  for (auto &m : vat->out_messages) {
+    shade_msg(heap, m, young_only);
   }
 }
 
-void run_gc(Vat *vat) {
+// Scans at most budget lists, true once nothing is left to scan
+static bool drain_gray(VatHeap *heap, bool young_only, u64 budget) {
+  for (u64 k = 0; k < budget && !heap->gray.empty(); ++k) {
+    auto list = (ListNode *)heap->gray.back();
+    heap->gray.pop_back();
+
+    for (auto elem : list->list) {
+      shade(heap, elem, young_only);
+    }
+  }
+
+  return heap->gray.empty();
+}
+
+static void free_node(Vat *vat, AstNode *node) {
+  vat->heap.stats.n_freed++;
+  destroy_ast_obj(vat->allocator, node);
+}
+
+static void promote(VatHeap *heap, AstNode *node) {
+  node->gc_gen = GcGen::Old;
+  heap->old.push_back(node);
+  heap->old_bytes += node_bytes(node);
+}
+
+static void minor_collect(Vat *vat) {
+  VatHeap *heap = &vat->heap;
+
+  shade_roots(vat, true);
+  for (auto list : heap->remembered) {
+    list->remembered = false;
+    for (auto elem : list->list) {
+      shade(heap, elem, true);
+    }
+  }
+  drain_gray(heap, true, UINT64_MAX);
+  heap->remembered.clear();
+
+  for (auto node : heap->young) {
+    if (node->marked) {
+      node->marked = false;
+      promote(heap, node);
+    } else {
+      free_node(vat, node);
+    }
+  }
+
+  heap->young.clear();
+  heap->young_bytes = 0;
+  heap->stats.n_minor++;
+}
+
+static void begin_major(Vat *vat) {
+  vat->heap.phase = GcPhase::Marking;
+  shade_roots(vat, false);
+}
+
+// Everything registered so far is swept, nodes made from here on aren't
+static void begin_sweep(VatHeap *heap) {
+  heap->sweeping.swap(heap->old);
+  heap->sweeping.insert(heap->sweeping.end(), heap->young.begin(), heap->young.end());
+  heap->old.clear();
+  heap->young.clear();
+  heap->old_bytes = 0;
+  heap->young_bytes = 0;
+
+  // Survivors end up old, the write barrier has to see them that way already
+  for (auto node : heap->sweeping) {
+    node->gc_gen = GcGen::Old;
+  }
+
+  // Unmarked lists are about to be freed
+  heap->remembered.erase(std::remove_if(heap->remembered.begin(), heap->remembered.end(),
+                                        [](ListNode *list) { return !list->marked; }),
+                         heap->remembered.end());
+
+  heap->sweep_pos = 0;
+  heap->phase = GcPhase::Sweeping;
+}
+
+static void mark_slice(Vat *vat, u64 budget) {
+  VatHeap *heap = &vat->heap;
+  if (!drain_gray(heap, false, budget)) return;
+
+  // The roots may have changed since marking started, anything they picked up
+  // since is either new (born marked) or was stored somewhere scanned again here
+  shade_roots(vat, false);
+  drain_gray(heap, false, UINT64_MAX);
+  begin_sweep(heap);
+}
+
+static void sweep_slice(Vat *vat, u64 budget) {
+  VatHeap *heap = &vat->heap;
+
+  for (u64 k = 0; k < budget && heap->sweep_pos < heap->sweeping.size(); ++k) {
+    auto node = heap->sweeping[heap->sweep_pos++];
+    if (node->marked) {
+      node->marked = false;
+      heap->old.push_back(node);
+      heap->old_bytes += node_bytes(node);
+    } else {
+      free_node(vat, node);
+    }
+  }
+
+  if (heap->sweep_pos < heap->sweeping.size()) return;
 
-  // Mark
-  for (auto &[ent_k, ent_v] : vat->entities) {
-    ent_v->marked = true;
-    for (auto &[_, v] : ent_v->data) {
-      mark(v);
+  heap->sweeping.clear();
+  heap->phase = GcPhase::Idle;
+  heap->old_limit = 2 * heap->old_bytes;
+  heap->stats.n_major++;
+  print_gc_stats(vat);
+}
+
+static void record_pause(VatHeap *heap, std::chrono::steady_clock::time_point start) {
+  u64 pause_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  int bucket = 0;
+  while (bucket < GC_PAUSE_BUCKETS - 1 && (1ull << bucket) <= pause_us) {
+    bucket++;
+  }
+
+  heap->stats.pause_histogram[bucket]++;
+  heap->stats.max_pause_us = std::max(heap->stats.max_pause_us, pause_us);
+}
+
+void gc_register(Vat *vat, AstNode *node) {
+  VatHeap *heap = &vat->heap;
+
+  node->gc_gen = GcGen::Young;
+  // Born marked so a running mark doesn't free it
+  node->marked = heap->phase == GcPhase::Marking;
+
+  heap->young.push_back(node);
+  heap->young_bytes += node_bytes(node);
+  heap->allocated_since_slice++;
+}
+
+void gc_list_store(Vat *vat, ListNode *list, AstNode *node) {
+  VatHeap *heap = &vat->heap;
+  if (!is_managed(node)) return;
+
+  heap->young_bytes += sizeof(AstNode *);
+
+  if (list->gc_gen == GcGen::Old && node->gc_gen == GcGen::Young && !list->remembered) {
+    list->remembered = true;
+    heap->remembered.push_back(list);
+  }
+
+  if (heap->phase == GcPhase::Marking) {
+    shade(heap, node, false);
+  }
+}
+
+void gc_safepoint(Vat *vat) {
+  VatHeap *heap = &vat->heap;
+  auto start = std::chrono::steady_clock::now();
+
+  u64 budget = std::max<u64>(heap->config.step_objects, 2 * heap->allocated_since_slice);
+  heap->allocated_since_slice = 0;
+
+  if (heap->phase == GcPhase::Marking) {
+    mark_slice(vat, budget);
+    heap->stats.n_slices++;
+  } else if (heap->phase == GcPhase::Sweeping) {
+    sweep_slice(vat, budget);
+    heap->stats.n_slices++;
+  } else if (heap->old_bytes > std::max(heap->config.old_bytes, heap->old_limit)) {
+    if (heap->config.incremental) {
+      begin_major(vat);
+      mark_slice(vat, budget);
+      heap->stats.n_slices++;
+    } else {
+      run_gc(vat);
+      return;
     }
+  } else if (heap->young_bytes > heap->config.nursery_bytes) {
+    minor_collect(vat);
+  } else {
+    return;
   }
 
-  // Sweep
-  for (auto &k : vat->all_entities) {
-    if (!k->marked) {
-      destroy_entity(k);
+  record_pause(heap, start);
+}
+
+void run_gc(Vat *vat) {
+  VatHeap *heap = &vat->heap;
+  auto start = std::chrono::steady_clock::now();
+
+  if (heap->phase == GcPhase::Idle) {
+    begin_major(vat);
+  }
+  if (heap->phase == GcPhase::Marking) {
+    mark_slice(vat, UINT64_MAX);
+  }
+  sweep_slice(vat, UINT64_MAX);
+
+  record_pause(heap, start);
+}
+
+void print_gc_stats(Vat *vat) {
+  GcStats &stats = vat->heap.stats;
+
+  std::string pauses;
+  for (int k = 0; k < GC_PAUSE_BUCKETS; ++k) {
+    if (stats.pause_histogram[k] == 0) continue;
+
+    if (k == GC_PAUSE_BUCKETS - 1) {
+      pauses += " >=" + std::to_string(1ull << (k - 1)) + "us:";
     } else {
-      k->marked = false;
+      pauses += " <" + std::to_string(1ull << k) + "us:";
     }
+    pauses += std::to_string(stats.pause_histogram[k]);
   }
 
-  for (auto it = vat->all_objects.begin(); it != vat->all_objects.end();) {
-    if (!(*it)->marked) {
-      destroy_ast_obj(*it);
-      it = vat->all_objects.erase(it);
+  dbp(log_debug, "GC vat %d: %lu minor, %lu major (%lu slices), %lu freed, %lu bytes old, max pause %luus, pauses%s",
+      vat->id, stats.n_minor, stats.n_major, stats.n_slices, stats.n_freed, vat->heap.old_bytes, stats.max_pause_us,
+      pauses.c_str());
+}
+
+// Copies a heap value, into to_vat's heap or (with no vat) out to the global
+// heap for a message to own.  Booleans, Nop and program nodes are shared.
+static AstNode *copy_node(AstNode *node, Vat *to_vat) {
+  AstNode *copy;
+
+  switch (node->type) {
+  case AstNodeType::NumberNode:
+    copy = make_number(((NumberNode *)node)->value);
+    break;
+  case AstNodeType::StringNode:
+    // An exported node is freed as soon as it's imported, its bytes can move
+    if (node->gc_gen == GcGen::Exported && to_vat) {
+      copy = make_string(std::move(((StringNode *)node)->value));
     } else {
-      (*it)->marked = false;
-      it++;
+      copy = make_string(((StringNode *)node)->value);
+    }
+    break;
+  case AstNodeType::EntityRefNode: {
+    auto ref = (EntityRefNode *)node;
+    copy = make_entity_ref(ref->node_id, ref->vat_id, ref->entity_id);
+  } break;
+  case AstNodeType::PromiseNode:
+    copy = make_promise_node(((PromiseNode *)node)->promise_id);
+    break;
+  case AstNodeType::ListNode: {
+    auto list = (ListNode *)node;
+    std::vector<AstNode *> elems;
+    for (auto elem : list->list) {
+      elems.push_back(copy_node(elem, to_vat));
+    }
+    copy = make_list(elems, list->ctype.subtype);
+  } break;
+  default:
+    return node;
+  }
+
+  // Refs sent to request-far-entity carry their type
+  copy->ctype = node->ctype;
+
+  if (to_vat) {
+    gc_register(to_vat, copy);
+  } else {
+    copy->gc_gen = GcGen::Exported;
+  }
+  return copy;
+}
+
+static void free_exported(AstNode *node) {
+  if (node->gc_gen != GcGen::Exported) return;
+
+  if (node->type == AstNodeType::ListNode) {
+    for (auto elem : ((ListNode *)node)->list) {
+      free_exported(elem);
+    }
+  }
+  destroy_ast_obj(nullptr, node);
+}
+
+void export_msg(Msg &m) {
+  AllocatorScope global_scope(nullptr);
+
+  for (auto &v : m.values) {
+    if (v.tag == ValueTag::Node) {
+      v.node = copy_node(v.node, nullptr);
+    }
+  }
+}
+
+void import_msg(Vat *vat, Msg &m) {
+  assert(current_allocator() == vat->allocator);
+
+  for (auto &v : m.values) {
+    if (v.tag == ValueTag::Node && v.node->gc_gen == GcGen::Exported) {
+      auto exported = v.node;
+      v.node = copy_node(exported, vat);
+      free_exported(exported);
     }
   }
 }
+
+void release_msg(Msg &m) {
+  for (auto &v : m.values) {
+    if (v.tag == ValueTag::Node) {
+      free_exported(v.node);
+    }
+  }
+}
+
+AstNode *box_exported(Value v) {
+  AstNode *node = box_value(v);
+  if (v.tag != ValueTag::Boolean && v.tag != ValueTag::Nop && v.tag != ValueTag::Node) {
+    node->gc_gen = GcGen::Exported;
+  }
+  return node;
+}
@@ -2,4 +2,28 @@
 
 #include "hylic_eval.h"
 
-void run_gc(Vat* vat);
+// Hands a node the vat just allocated to its young generation
+void gc_register(Vat *vat, AstNode *node);
+// Called whenever a node is stored into a list, keeps the remembered set and
+// a running incremental mark up to date
+void gc_list_store(Vat *vat, ListNode *list, AstNode *node);
+
+// Does whatever collection work is due.  Only called between messages, one
+// slice of an incremental collection per call.
+void gc_safepoint(Vat *vat);
+// Collects both generations, finishing an incremental collection if one is running
+void run_gc(Vat *vat);
+
+void print_gc_stats(Vat *vat);
+
+// Heap values are copied whenever a message crosses between vats.
+// export_msg copies them out of the sending vat's heap before the message
+// leaves it, import_msg copies them into the receiving vat's heap and frees
+// the exported copies, release_msg frees them once the message has been sent
+// to another node instead.
+void export_msg(Msg &m);
+void import_msg(Vat *vat, Msg &m);
+void release_msg(Msg &m);
+// Boxes a value decoded off the network into a node the message owns, for
+// putting in a list.  Booleans stay shared.
+AstNode *box_exported(Value v);
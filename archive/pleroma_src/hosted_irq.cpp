@@ -27,9 +27,9 @@ void loop_keyboard() {
       m.src_node_id = -1;
       m.src_vat_id = -1;
       m.src_entity_id = -1;
-      m.function_name = "irq-handler";
-      m.values.push_back((ValueNode*)make_number(1));
-      m.values.push_back((ValueNode *)make_number(event.key.keysym.sym));
+      m.selector = intern_selector("irq-handler");
+      m.values.push_back(number_value(1));
+      m.values.push_back(number_value(event.key.keysym.sym));
       net_out_queue.enqueue(m);
     }
   }
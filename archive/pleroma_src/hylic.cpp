@@ -17,8 +17,10 @@
 #include "hylic.h"
 #include "hylic_ast.h"
 #include "hylic_compex.h"
+#include "hylic_compiler.h"
 #include "hylic_eval.h"
 #include "hylic_parse.h"
+#include "hylic_resolver.h"
 #include "hylic_tokenizer.h"
 #include "hylic_typesolver.h"
 #include "general_util.h"
@@ -28,12 +30,17 @@ EntityRefNode *monad_ref;
 HylicModule *load_file(std::string program_name, std::string path) {
   dbp(log_debug, "Loading %s...", path.c_str());
 
+  // Programs outlive whichever vat asked for them
+  AllocatorScope program_scope(nullptr);
+
   HylicModule *program;
   TokenStream *stream = tokenize_file(path);
 
   program = parse(program_name, stream);
 
   typesolve(program);
+  resolve_slots(program);
+  compile_module(program);
 
   return program;
 }
@@ -13,7 +13,6 @@
 HylicModule *load_file(std::string program_name, std::string path);
 std::map<std::string, AstNode *> parse(TokenStream stream);
 bool typecheck(std::map<std::string, AstNode *>);
-AstNode *eval(AstNode *obj, Scope *scope);
 void parse_file(std::string path);
 
 extern EntityRefNode *monad_ref;
@@ -5,10 +5,6 @@
 #include <cassert>
 #include <string>
 
-AstNode *static_nop;
-AstNode *static_true;
-AstNode *static_false;
-
 std::string entity_ref_str(EntityRefNode *ref) {
   return "(" + std::to_string(ref->node_id) + ", " +
          std::to_string(ref->vat_id) + ", " +
@@ -165,8 +161,11 @@ AstNode *make_table(std::map<std::string, AstNode *> vals) {
   return table;
 }
 
+// Values made at runtime come from the running vat's allocator, see
+// allocators.h.  Everything else the parser makes lives on the global heap.
+
 AstNode *make_number(int64_t v) {
-  NumberNode *symbol_node = new NumberNode;
+  NumberNode *symbol_node = vat_new<NumberNode>(current_allocator());
   symbol_node->type = AstNodeType::NumberNode;
   symbol_node->value_type = ValueType::Number;
   symbol_node->ctype.basetype = PType::u8;
@@ -177,10 +176,10 @@ AstNode *make_number(int64_t v) {
 }
 
 AstNode *make_string(std::string s) {
-  StringNode *node = new StringNode;
+  StringNode *node = vat_new<StringNode>(current_allocator());
   node->type = AstNodeType::StringNode;
   node->ctype.basetype = PType::str;
-  node->value = s;
+  node->value = std::move(s);
   return node;
 }
 
@@ -189,17 +188,20 @@ AstNode *make_entity_creation() {}
 // Value nodes
 
 AstNode *make_boolean(bool b) {
-  if (!static_true || !static_false) {
+  // Burners race to create these, static init makes it safe
+  static AstNode *static_true = [] {
     BooleanNode *true_node = new BooleanNode;
     true_node->type = AstNodeType::BooleanNode;
     true_node->value = true;
-    static_true = true_node;
+    return true_node;
+  }();
 
+  static AstNode *static_false = [] {
     BooleanNode *false_node = new BooleanNode;
     false_node->type = AstNodeType::BooleanNode;
     false_node->value = false;
-    static_false = false_node;
-  }
+    return false_node;
+  }();
 
   if (b) {
     return static_true;
@@ -225,9 +227,47 @@ AstNode *make_actor(HylicModule* module, std::string s, std::map<std::string, Fu
   actor_def->inocaps = inocaps;
   actor_def->preamble = preamble;
   actor_def->postamble = postamble;
+  build_vtable(actor_def);
+  build_field_slots(actor_def);
   return actor_def;
 }
 
+void build_vtable(EntityDef *entity_def) {
+  entity_def->vtable.clear();
+
+  for (auto &[name, func] : entity_def->functions) {
+    Selector sel = intern_selector(name);
+    if (sel >= entity_def->vtable.size()) {
+      entity_def->vtable.resize(sel + 1, nullptr);
+    }
+    entity_def->vtable[sel] = func;
+  }
+}
+
+void build_field_slots(EntityDef *entity_def) {
+  entity_def->field_slots.clear();
+
+  for (auto &[name, _] : entity_def->data) {
+    int slot = entity_def->field_slots.size();
+    entity_def->field_slots[name] = slot;
+  }
+
+  for (auto &inocap : entity_def->inocaps) {
+    if (entity_def->field_slots.find(inocap.var_name) == entity_def->field_slots.end()) {
+      int slot = entity_def->field_slots.size();
+      entity_def->field_slots[inocap.var_name] = slot;
+    }
+  }
+}
+
+FuncStmt *find_function(EntityDef *entity_def, Selector sel) {
+  if (sel >= entity_def->vtable.size()) {
+    return nullptr;
+  }
+
+  return entity_def->vtable[sel];
+}
+
 AstNode *make_function(std::string s, std::vector<std::string> args, std::vector<AstNode *> body, std::vector<CType*> param_types, bool pure) {
   FuncStmt *func_stmt = new FuncStmt;
   func_stmt->type = AstNodeType::FuncStmt;
@@ -240,11 +280,11 @@ AstNode *make_function(std::string s, std::vector<std::string> args, std::vector
 }
 
 AstNode *make_nop() {
-  if (!static_nop) {
+  static AstNode *static_nop = [] {
     auto nop = new Nop;
     nop->type = AstNodeType::Nop;
-    static_nop = nop;
-  }
+    return nop;
+  }();
   return static_nop;
 }
 
@@ -269,6 +309,7 @@ AstNode *make_message_node(AstNode* entity_ref, std::string function_name, CommM
   func_call->type = AstNodeType::MessageNode;
   func_call->entity_ref = entity_ref;
   func_call->function_name = function_name;
+  func_call->selector = intern_selector(function_name);
   func_call->comm_mode = comm_mode;
   func_call->args = args;
 
@@ -299,7 +340,7 @@ AstNode *make_create_entity(std::string entity_def_name, bool new_vat) {
 }
 
 AstNode *make_entity_ref(int node_id, int vat_id, int entity_id) {
-  EntityRefNode *entity_ref = new EntityRefNode;
+  EntityRefNode *entity_ref = vat_new<EntityRefNode>(current_allocator());
 
   entity_ref->type = AstNodeType::EntityRefNode;
   entity_ref->entity_id = entity_id;
@@ -310,7 +351,7 @@ AstNode *make_entity_ref(int node_id, int vat_id, int entity_id) {
 }
 
 AstNode *make_list(std::vector<AstNode *> list, CType *ctype) {
-  ListNode *list_node = new ListNode;
+  ListNode *list_node = vat_new<ListNode>(current_allocator());
   list_node->type = AstNodeType::ListNode;
   list_node->list = list;
   list_node->ctype.basetype = PType::List;
@@ -320,7 +361,7 @@ AstNode *make_list(std::vector<AstNode *> list, CType *ctype) {
 }
 
 AstNode *make_promise_node(int promise_id) {
-  PromiseNode *promise_node = new PromiseNode;
+  PromiseNode *promise_node = vat_new<PromiseNode>(current_allocator());
   promise_node->type = AstNodeType::PromiseNode;
   promise_node->promise_id = promise_id;
 
@@ -333,6 +374,7 @@ AstNode *make_promise_resolution_node(std::string sym,
   promise_res_node->type = AstNodeType::PromiseResNode;
   promise_res_node->body = body;
   promise_res_node->sym = sym;
+  promise_res_node->promise = (SymbolNode *)make_symbol(sym);
 
   return promise_res_node;
 }
@@ -354,13 +396,25 @@ AstNode *make_index_node(AstNode *list, AstNode *accessor) {
   return index_node;
 }
 
-void destroy_ast_obj(AstNode *node) {
-  printf("Destroying\n");
+void destroy_ast_obj(VatAllocator *allocator, AstNode *node) {
   switch(node->type) {
+    case AstNodeType::NumberNode:
+      vat_delete(allocator, (NumberNode *)node);
+      break;
     case AstNodeType::StringNode:{
       auto str_nd = safe_ncast<StringNode*>(node, AstNodeType::StringNode);
-      delete str_nd;
+      vat_delete(allocator, str_nd);
+    } break;
+    case AstNodeType::ListNode:{
+      auto lst_nd = safe_ncast<ListNode*>(node, AstNodeType::ListNode);
+      vat_delete(allocator, lst_nd);
     } break;
+    case AstNodeType::EntityRefNode:
+      vat_delete(allocator, (EntityRefNode *)node);
+      break;
+    case AstNodeType::PromiseNode:
+      vat_delete(allocator, (PromiseNode *)node);
+      break;
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include "common.h"
 #include "hylic_tokenizer.h"
+#include "selector.h"
 #include <cassert>
 #include <map>
 #include <memory>
@@ -107,6 +108,11 @@ struct CType {
   std::list<Token *>::iterator end;
 };
 
+// Where a node sits in its vat's heap, see gc.cpp.  Parsed nodes and
+// anything never registered with a vat are Unmanaged and never collected.
+// Exported nodes are copies owned by a message in flight between vats.
+enum class GcGen : u8 { Unmanaged, Young, Old, Exported };
+
 struct AstNode {
   AstNodeType type;
   AstNode *parent;
@@ -114,6 +120,7 @@ struct AstNode {
   CType ctype;
 
   bool marked = false;
+  GcGen gc_gen = GcGen::Unmanaged;
 
   std::list<Token *>::iterator start;
   std::list<Token *>::iterator end;
@@ -124,6 +131,9 @@ struct InoCap {
   CType *ctype;
 };
 
+// Compiled body, see hylic_compiler.h
+struct Bytecode;
+
 struct HylicModule {
   std::string abs_module_path;
   std::map<std::string, HylicModule *> imports;
@@ -174,10 +184,16 @@ struct FuncStmt : AstNode {
 
   std::vector<AstNode *> body;
   bool pure;
+
+  // Frame size, args take the first slots
+  int n_slots = 0;
+
+  Bytecode *bytecode = nullptr;
 };
 
 struct ForStmt : AstNode {
   std::string sym;
+  int sym_slot = -1;
   AstNode *generator;
   std::vector<AstNode *> body;
 };
@@ -208,8 +224,14 @@ struct ValueNode : AstNode {
   ValueType value_type;
 };
 
+// Where a symbol lives, filled in by the resolver after typesolving
+enum class SlotKind { Unresolved, Local, Field };
+
 struct SymbolNode : AstNode {
   std::string sym;
+
+  SlotKind slot_kind = SlotKind::Unresolved;
+  int slot = -1;
 };
 
 struct NumberNode : ValueNode {
@@ -218,6 +240,8 @@ struct NumberNode : ValueNode {
 
 struct ListNode : ValueNode {
   std::vector<AstNode *> list;
+  // Already in its vat's remembered set
+  bool remembered = false;
 };
 
 struct StringNode : ValueNode {
@@ -249,12 +273,20 @@ struct UsertypeValueNode : ValueNode {
 
 struct PromiseResNode : AstNode {
   std::string sym;
+  // The promise being waited on, looked up in the enclosing function
+  SymbolNode *promise;
   std::vector<AstNode *> body;
+
+  // The body runs later in a frame of its own, with the result in slot 0
+  int n_slots = 1;
+
+  Bytecode *bytecode = nullptr;
 };
 
 struct MessageNode : AstNode {
   AstNode* entity_ref;
   std::string function_name;
+  Selector selector;
 
   MessageDistance message_distance;
   CommMode comm_mode;
@@ -286,7 +318,11 @@ struct EntityDef : AstNode {
   std::string name;
   HylicModule* module;
   std::map<std::string, FuncStmt *> functions;
+  // functions indexed by selector, rebuilt whenever functions changes
+  std::vector<FuncStmt *> vtable;
   std::map<std::string, AstNode *> data;
+  // Index into Entity::fields for data and inocaps
+  std::map<std::string, int> field_slots;
 
   std::vector<std::string> preamble;
   std::vector<std::string> postamble;
@@ -341,6 +377,9 @@ AstNode *make_undefined();
 AstNode *make_self();
 AstNode *make_range(AstNode* range_start, AstNode* range_end);
 AstNode *make_comment(std::string comment);
+void build_vtable(EntityDef *entity_def);
+void build_field_slots(EntityDef *entity_def);
+FuncStmt *find_function(EntityDef *entity_def, Selector sel);
 AstNode *make_message_node(AstNode* entity_ref, std::string function_name, CommMode comm_mode, std::vector<AstNode *> args);
 AstNode *make_create_entity(std::string entity_name, bool new_vat);
 AstNode *make_entity_ref(int node_id, int vat_id, int entity_id);
@@ -353,7 +392,8 @@ AstNode *make_promise_resolution_node(std::string sym, std::vector<AstNode *> bo
 AstNode *make_foreign_func_call(AstNode * (*foreign_func)(EvalContext *, std::vector<AstNode *>), std::vector<AstNode *> args, CType ret_type);
 
 // Destroy
-void destroy_ast_obj(AstNode* node);
+// Node must have come from allocator, the vat's own when the GC sweeps
+void destroy_ast_obj(VatAllocator *allocator, AstNode* node);
 
 std::string ast_type_to_string(AstNodeType t);
 std::string ctype_to_string(CType * ctype);
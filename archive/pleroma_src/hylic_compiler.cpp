@@ -1,147 +1,404 @@
 #include "hylic_compiler.h"
 #include "hylic_ast.h"
+#include <cassert>
+#include <stdio.h>
 #include <tuple>
 
-// Instructions
-namespace Hlcn {
-const u32 Exit = 0x00;
-const u32 Call = 0x06;
+// One per Bytecode being built, promise callbacks get their own
+struct CompileContext {
+  Bytecode *bc;
 };
 
-void cc_u64(CompileContext *cc, u64 value) {
-  cc->comp_out.put(value << 56);
-  cc->comp_out.put(value << 48);
-  cc->comp_out.put(value << 40);
-  cc->comp_out.put(value << 32);
-  cc->comp_out.put(value << 24);
-  cc->comp_out.put(value << 16);
-  cc->comp_out.put(value << 8);
-  cc->comp_out.put(value);
+void compile_node(CompileContext *cc, AstNode *in_node);
+
+int cc_emit(CompileContext *cc, Hlcn op, int a = 0, int b = 0, int c = 0) {
+  Instr instr;
+  instr.op = op;
+  instr.a = a;
+  instr.b = b;
+  instr.c = c;
+  cc->bc->code.push_back(instr);
+  return cc->bc->code.size() - 1;
 }
 
-void cc_u32(CompileContext *cc, u32 value) {
-  cc->comp_out.put(value << 24);
-  cc->comp_out.put(value << 16);
-  cc->comp_out.put(value << 8);
-  cc->comp_out.put(value);
+int cc_const(CompileContext *cc, AstNode *node) {
+  cc->bc->consts.push_back(node);
+  return cc->bc->consts.size() - 1;
 }
 
-void cc_constant(CompileContext *cc, NumberNode* node) {
-  cc->comp_out.put(0x08);
-  cc->comp_out.put(node->value);
+int cc_literal(CompileContext *cc, Value value) {
+  cc->bc->literals.push_back(value);
+  return cc->bc->literals.size() - 1;
 }
 
-void cc_operator(CompileContext *cc, OperatorExpr* node) {
-  compile_node(cc, node->term1);
-  compile_node(cc, node->term2);
+int cc_here(CompileContext *cc) {
+  return cc->bc->code.size();
+}
 
-  switch(node->op) {
-  case OperatorExpr::Op::Plus:
-    cc->comp_out.put(0x02);
-    break;
-  case OperatorExpr::Op::Minus:
-    cc->comp_out.put(0x03);
+// Points a jump emitted earlier at the next instruction
+void cc_patch(CompileContext *cc, int instr_pos) {
+  Instr &instr = cc->bc->code[instr_pos];
+  if (instr.op == Hlcn::ForNext || instr.op == Hlcn::ForRangeNext) {
+    instr.c = cc_here(cc);
+  } else {
+    instr.a = cc_here(cc);
+  }
+}
+
+void cc_fail(CompileContext *cc, std::string msg) {
+  cc_emit(cc, Hlcn::Fail, cc_const(cc, make_string(msg)));
+}
+
+int cc_hidden_slot(CompileContext *cc) {
+  return cc->bc->n_slots++;
+}
+
+// Same value eval_block gives: a return ends the block with its expression,
+// anything else leaves a Nop
+void cc_block(CompileContext *cc, std::vector<AstNode *> &block) {
+  for (auto stmt : block) {
+    if (stmt->type == AstNodeType::ReturnNode) {
+      compile_node(cc, ((ReturnNode *)stmt)->expr);
+      return;
+    }
+
+    compile_node(cc, stmt);
+    cc_emit(cc, Hlcn::Pop);
+  }
+
+  cc_emit(cc, Hlcn::PushNop);
+}
+
+void cc_symbol(CompileContext *cc, SymbolNode *node) {
+  switch (node->slot_kind) {
+  case SlotKind::Local:
+    cc_emit(cc, Hlcn::LoadLocal, node->slot, cc_const(cc, node));
     break;
-  case OperatorExpr::Op::Times:
-    cc->comp_out.put(0x04);
+  case SlotKind::Field:
+    cc_emit(cc, Hlcn::LoadField, node->slot);
     break;
-  case OperatorExpr::Op::Divide:
-    cc->comp_out.put(0x05);
+  case SlotKind::Unresolved:
+    cc_emit(cc, Hlcn::LoadName, cc_const(cc, node));
     break;
   }
 }
 
-void cc_message(CompileContext *cc, MessageNode* node) {
-  if (node->function_name == "Exit") {
-    cc->comp_out.put(Hlcn::Exit);
-    cc->comp_out.put(0x0);
+void cc_assignment(CompileContext *cc, AssignmentStmt *node) {
+  if (node->sym->type == AstNodeType::SymbolNode) {
+    auto sym = (SymbolNode *)node->sym;
+    compile_node(cc, node->value);
+
+    if (sym->slot_kind == SlotKind::Local) {
+      cc_emit(cc, Hlcn::StoreLocal, sym->slot);
+    } else if (sym->slot_kind == SlotKind::Field) {
+      cc_emit(cc, Hlcn::StoreField, sym->slot);
+    } else {
+      cc_fail(cc, "Assignment to unresolved symbol: " + sym->sym);
+    }
+  } else if (node->sym->type == AstNodeType::IndexNode &&
+             ((IndexNode *)node->sym)->list->type == AstNodeType::SymbolNode) {
+    auto ind_node = (IndexNode *)node->sym;
+    compile_node(cc, node->value);
+    cc_symbol(cc, (SymbolNode *)ind_node->list);
+    compile_node(cc, ind_node->accessor);
+    cc_emit(cc, Hlcn::StoreIndex);
+  } else {
+    cc_fail(cc, "Invalid assignment.");
+  }
+}
+
+void cc_while(CompileContext *cc, WhileStmt *node) {
+  int loop_top = cc_here(cc);
+  compile_node(cc, node->generator);
+  int exit_jump = cc_emit(cc, Hlcn::JumpIfFalse);
+
+  cc_block(cc, node->body);
+  cc_emit(cc, Hlcn::Pop);
+  cc_emit(cc, Hlcn::Jump, loop_top);
+
+  cc_patch(cc, exit_jump);
+  cc_emit(cc, Hlcn::PushNop);
+}
+
+// Counts from start to end without building the list eval would
+void cc_for_range(CompileContext *cc, ForStmt *node) {
+  auto range = (RangeNode *)node->generator;
+  int current_slot = cc_hidden_slot(cc);
+  int end_slot = cc_hidden_slot(cc);
+
+  compile_node(cc, range->range_start);
+  compile_node(cc, range->range_end);
+  cc_emit(cc, Hlcn::ForRangeInit, current_slot, end_slot);
+
+  int loop_top = cc_here(cc);
+  int exit_jump = cc_emit(cc, Hlcn::ForRangeNext, current_slot, end_slot);
+  cc_emit(cc, Hlcn::StoreLocal, node->sym_slot);
+  cc_emit(cc, Hlcn::Pop);
+
+  cc_block(cc, node->body);
+  cc_emit(cc, Hlcn::Pop);
+  cc_emit(cc, Hlcn::Jump, loop_top);
+
+  cc_patch(cc, exit_jump);
+  cc_emit(cc, Hlcn::PushNop);
+}
+
+void cc_for(CompileContext *cc, ForStmt *node) {
+  if (node->generator->type == AstNodeType::RangeNode) {
+    cc_for_range(cc, node);
     return;
   }
 
-  if (node->comm_mode == CommMode::Sync) {
-    cc->comp_out.put(Hlcn::Call);
+  // The list being walked lives in a slot the body can't see
+  int list_slot = cc_hidden_slot(cc);
+  int iter = cc->bc->n_iters++;
 
-    // thunk
-    cc->function_thunks.push_back(std::make_tuple(node->function_name, cc->comp_out.tellp()));
-    cc_u64(cc, 0x0);
-    //cc->comp_out.put(cc->functions[node->function_name]);
-    //printf("Calling %d\n", cc->functions[node->function_name]);
-  } else if (node->comm_mode == CommMode::Async) {
-  } else {
-    panic("NYI");
+  compile_node(cc, node->generator);
+  cc_emit(cc, Hlcn::StoreLocal, list_slot);
+  cc_emit(cc, Hlcn::Pop);
+  cc_emit(cc, Hlcn::ForInit, iter);
+
+  int loop_top = cc_here(cc);
+  int exit_jump = cc_emit(cc, Hlcn::ForNext, iter, list_slot);
+  cc_emit(cc, Hlcn::StoreLocal, node->sym_slot);
+  cc_emit(cc, Hlcn::Pop);
+
+  cc_block(cc, node->body);
+  cc_emit(cc, Hlcn::Pop);
+  cc_emit(cc, Hlcn::Jump, loop_top);
+
+  cc_patch(cc, exit_jump);
+  cc_emit(cc, Hlcn::PushNop);
+}
+
+void cc_match(CompileContext *cc, MatchNode *node) {
+  std::vector<int> end_jumps;
+  bool fell_through = false;
+
+  compile_node(cc, node->match_expr);
+
+  for (auto &[case_expr, case_body] : node->cases) {
+    // TODO Make it so the order doesn't matter for fallthrough
+    if (case_expr->type == AstNodeType::FallthroughExpr) {
+      cc_emit(cc, Hlcn::Pop);
+      cc_block(cc, case_body);
+      fell_through = true;
+      break;
+    }
+
+    cc_emit(cc, Hlcn::Dup);
+    compile_node(cc, case_expr);
+    int next_case = cc_emit(cc, Hlcn::MatchTest);
+
+    cc_emit(cc, Hlcn::Pop);
+    cc_block(cc, case_body);
+    end_jumps.push_back(cc_emit(cc, Hlcn::Jump));
+
+    cc_patch(cc, next_case);
+  }
+
+  if (!fell_through) {
+    cc_emit(cc, Hlcn::Pop);
+    cc_emit(cc, Hlcn::PushNop);
+  }
+
+  for (auto jump : end_jumps) {
+    cc_patch(cc, jump);
   }
 }
 
-void cc_function(CompileContext *cc, FuncStmt* stmt) {
-  for (auto &k: stmt->body) {
-    compile_node(cc, k);
+void cc_message(CompileContext *cc, MessageNode *node) {
+  static const Selector append_sel = intern_selector("append");
+  static const Selector len_sel = intern_selector("len");
+
+  for (auto arg : node->args) {
+    compile_node(cc, arg);
+  }
+
+  // HACK
+  if (node->selector == append_sel) {
+    assert(node->args.size() >= 2);
+    cc_emit(cc, Hlcn::Append, 0, node->args.size());
+    return;
   }
 
-  cc->comp_out.put(0x07);
+  if (node->selector == len_sel) {
+    assert(node->args.size() >= 1);
+    cc_emit(cc, Hlcn::Len, 0, node->args.size());
+    return;
+  }
+
+  compile_node(cc, node->entity_ref);
+  cc_emit(cc, Hlcn::Send, node->selector, node->args.size(), (int)node->comm_mode);
+}
+
+Bytecode *compile_callback(PromiseResNode *node) {
+  CompileContext cc;
+  cc.bc = new Bytecode;
+  cc.bc->n_slots = node->n_slots;
+
+  cc_block(&cc, node->body);
+  cc_emit(&cc, Hlcn::Return);
+
+  return cc.bc;
 }
 
-void compile_node(CompileContext *cc, AstNode* in_node) {
+void compile_node(CompileContext *cc, AstNode *in_node) {
   switch (in_node->type) {
-  case AstNodeType::NumberNode: {
-    auto node = safe_ncast<NumberNode *>(in_node, AstNodeType::NumberNode);
-    cc_constant(cc, node);
-  } break;
+  case AstNodeType::NumberNode:
+  case AstNodeType::StringNode:
+  case AstNodeType::BooleanNode:
+  case AstNodeType::CommentNode:
+  case AstNodeType::TableNode:
+  case AstNodeType::EntityDef:
+  case AstNodeType::EntityRefNode:
+  case AstNodeType::PromiseNode:
+  case AstNodeType::Nop:
+  // Only reached outside a block, where eval hands back the node itself
+  case AstNodeType::ReturnNode:
+    cc_emit(cc, Hlcn::PushConst, cc_literal(cc, to_value(in_node)));
+    break;
+
+  case AstNodeType::FuncStmt:
+  case AstNodeType::ModuleStmt:
+    cc_emit(cc, Hlcn::PushNop);
+    break;
+
+  case AstNodeType::SymbolNode:
+    cc_symbol(cc, (SymbolNode *)in_node);
+    break;
+
+  case AstNodeType::AssignmentStmt:
+    cc_assignment(cc, (AssignmentStmt *)in_node);
+    break;
+
   case AstNodeType::OperatorExpr: {
-    auto node = safe_ncast<OperatorExpr *>(in_node, AstNodeType::OperatorExpr);
-    cc_operator(cc, node);
+    auto node = (OperatorExpr *)in_node;
+    compile_node(cc, node->term1);
+    compile_node(cc, node->term2);
+    cc_emit(cc, Hlcn::Arith, node->op);
+  } break;
+
+  case AstNodeType::BooleanExpr: {
+    auto node = (BooleanExpr *)in_node;
+    compile_node(cc, node->term1);
+    compile_node(cc, node->term2);
+    cc_emit(cc, Hlcn::Compare, node->op);
   } break;
-  case AstNodeType::EntityDef: {
-    printf("ENT!\n");
-    auto ent_def_node = safe_ncast<EntityDef*>(in_node, AstNodeType::EntityDef);
-    for (auto &[func_name, func_def] : ent_def_node->functions) {
-      auto func_node = safe_ncast<FuncStmt *>(func_def, AstNodeType::FuncStmt);
-      cc->functions[ent_def_node->name + "::" + func_node->name] = cc->comp_out.tellp();
-      printf("%s\n", func_name.c_str());
-      cc_function(cc, func_node);
+
+  case AstNodeType::ListNode: {
+    auto node = (ListNode *)in_node;
+    for (auto elem : node->list) {
+      compile_node(cc, elem);
     }
+    cc_emit(cc, Hlcn::MakeList, cc_const(cc, node), node->list.size());
   } break;
-  case AstNodeType::MessageNode: {
-    auto node = safe_ncast<MessageNode *>(in_node, AstNodeType::MessageNode);
-    cc_message(cc, node);
+
+  case AstNodeType::RangeNode: {
+    auto node = (RangeNode *)in_node;
+    compile_node(cc, node->range_start);
+    compile_node(cc, node->range_end);
+    cc_emit(cc, Hlcn::MakeRange);
   } break;
-  }
-}
 
-void _compile(std::vector<AstNode*> test_body) {
-  CompileContext cc;
-  cc.comp_out.open("../halcyonist/out.plmb", std::ios::binary | std::ios::out);
+  case AstNodeType::IndexNode: {
+    auto node = (IndexNode *)in_node;
+    compile_node(cc, node->list);
+    compile_node(cc, node->accessor);
+    cc_emit(cc, Hlcn::Index);
+  } break;
 
-  for (auto &k: test_body) {
-    compile_node(&cc, k);
-  }
+  case AstNodeType::WhileStmt:
+    cc_while(cc, (WhileStmt *)in_node);
+    break;
 
-  for (auto &z : cc.function_thunks) {
-    std::string func_name = std::get<0>(z);
-    u64 thunk_pos = std::get<1>(z);
+  case AstNodeType::ForStmt:
+    cc_for(cc, (ForStmt *)in_node);
+    break;
 
-    cc.comp_out.seekp(thunk_pos);
-    cc_u64(&cc, cc.functions[func_name]);
-    printf("Fixed it with func pos %d\n", thunk_pos);
-  }
+  case AstNodeType::MatchNode:
+    cc_match(cc, (MatchNode *)in_node);
+    break;
+
+  case AstNodeType::MessageNode:
+    cc_message(cc, (MessageNode *)in_node);
+    break;
+
+  case AstNodeType::SelfNode:
+    cc_emit(cc, Hlcn::Self);
+    break;
+
+  case AstNodeType::CreateEntity:
+    cc_emit(cc, Hlcn::Create, cc_const(cc, in_node));
+    break;
+
+  case AstNodeType::PromiseResNode: {
+    auto node = (PromiseResNode *)in_node;
+    node->bytecode = compile_callback(node);
+    cc_emit(cc, Hlcn::OnPromise, cc_const(cc, node));
+  } break;
+
+  case AstNodeType::ForeignFunc: {
+    auto node = (ForeignFuncCall *)in_node;
+    for (auto arg : node->args) {
+      compile_node(cc, arg);
+    }
+    cc_emit(cc, Hlcn::CallForeign, cc_const(cc, node), node->args.size());
+  } break;
 
-  cc.comp_out.close();
+  case AstNodeType::ModUseNode: {
+    auto node = (ModUseNode *)in_node;
+    cc_emit(cc, Hlcn::EnterModule, cc_const(cc, node));
+    compile_node(cc, node->accessor);
+    cc_emit(cc, Hlcn::LeaveModule);
+  } break;
+
+  default:
+    // eval can't run these either, fail the same way when reached
+    cc_fail(cc, "Failing to evaluate node type " + ast_type_to_string(in_node->type));
+    break;
+  }
 }
 
-void compile(std::map<std::string, AstNode *> program) {
+Bytecode *compile_function(FuncStmt *func) {
+  CompileContext cc;
+  cc.bc = new Bytecode;
+  cc.bc->n_slots = func->n_slots;
+
+  cc_block(&cc, func->body);
+  cc_emit(&cc, Hlcn::Return);
 
-  auto func1 = (FuncStmt*) make_function("tester", {}, {make_operator_expr(OperatorExpr::Op::Plus, make_message_node(nullptr, "blah", CommMode::Sync, {}), make_operator_expr(OperatorExpr::Op::Plus, make_number(4), make_number(6))),}, {}, false);
+  return cc.bc;
+}
 
-  auto func2 = (FuncStmt*) make_function("blah", {}, {make_operator_expr(OperatorExpr::Op::Plus, make_number(9), make_operator_expr(OperatorExpr::Op::Plus, make_number(4), make_number(6))),}, {}, false);
+void compile_module(HylicModule *module) {
+  for (auto &[_, v] : module->entity_defs) {
+    auto entity_def = (EntityDef *)v;
 
-  std::map<std::string, FuncStmt *> funcs = {
-      {"blah", func2},
-      {"tester", func1},
+    for (auto &[fname, func] : entity_def->functions) {
+      // Kernel functions are shared by every load of their module
+      if (!func->bytecode) {
+        func->bytecode = compile_function(func);
+      }
+    }
+  }
+}
+
+const char *hlcn_name(Hlcn op) {
+  static const char *names[] = {
+#define HLCN_NAME(name) #name,
+    HLCN_OPS(HLCN_NAME)
+#undef HLCN_NAME
   };
 
-  auto ex_act = make_actor(nullptr, "TestEnt", funcs, {}, {}, {}, {});
+  return names[(int)op];
+}
 
-  _compile({
-      make_message_node(nullptr, "TestEnt::blah", CommMode::Sync, {}),
-      ex_act,
-  });
+void dump_bytecode(Bytecode *bc) {
+  printf("\nBytecode (%d slots, %d loop counters):\n", bc->n_slots, bc->n_iters);
+  for (size_t k = 0; k < bc->code.size(); ++k) {
+    auto &instr = bc->code[k];
+    printf("\t%4zu %-12s %d %d %d\n", k, hlcn_name(instr.op), instr.a, instr.b, instr.c);
+  }
+  printf("\n");
 }
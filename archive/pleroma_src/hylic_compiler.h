@@ -1,16 +1,78 @@
 #pragma once
 
 #include "hylic_ast.h"
-#include <fstream>
-#include <map>
+#include "hylic_value.h"
 #include <string>
+#include <vector>
 
-struct CompileContext {
-  std::ofstream comp_out;
+// Stack machine instructions.  a/b/c are the operands noted beside each one,
+// "const" operands index Bytecode::consts and "literal" ones
+// Bytecode::literals.  Every expression leaves exactly one value on the
+// operand stack.
+#define HLCN_OPS(X)                                                            \
+  X(PushConst)   /* a: literal */                                              \
+  X(PushNop)                                                                   \
+  X(Pop)                                                                       \
+  X(Dup)                                                                       \
+  X(LoadLocal)   /* a: slot, b: const SymbolNode for the name lookup */        \
+  X(StoreLocal)  /* a: slot, leaves the value */                               \
+  X(LoadField)   /* a: field slot */                                           \
+  X(StoreField)  /* a: field slot, leaves the value */                         \
+  X(LoadName)    /* a: const SymbolNode */                                     \
+  X(StoreIndex)  /* value list index -> value */                               \
+  X(Index)       /* list index -> element */                                   \
+  X(Arith)       /* a: OperatorExpr::Op */                                     \
+  X(Compare)     /* a: BooleanExpr::Op */                                      \
+  X(Jump)        /* a: target */                                               \
+  X(JumpIfFalse) /* a: target, pops the condition */                           \
+  X(ForInit)     /* a: loop counter */                                         \
+  X(ForNext)     /* a: loop counter, b: list slot, c: exit target */           \
+  X(ForRangeInit) /* a: current slot, b: end slot, pops start and end */       \
+  X(ForRangeNext) /* a: current slot, b: end slot, c: exit target */           \
+  X(MatchTest)   /* a: next case target, pops the case and the match value */  \
+  X(MakeList)    /* a: const ListNode literal, b: n elements */                \
+  X(MakeRange)                                                                 \
+  X(Self)                                                                      \
+  X(Send)        /* a: selector, b: n args, c: CommMode */                     \
+  X(Append)      /* b: n args */                                               \
+  X(Len)         /* b: n args */                                               \
+  X(Create)      /* a: const CreateEntityNode */                               \
+  X(OnPromise)   /* a: const PromiseResNode */                                 \
+  X(CallForeign) /* a: const ForeignFuncCall, b: n args */                     \
+  X(EnterModule) /* a: const ModUseNode */                                     \
+  X(LeaveModule)                                                               \
+  X(Fail)        /* a: const StringNode */                                     \
+  X(Return)
 
-  std::map<std::string, u64> functions;
-  std::vector<std::tuple<std::string, u64>> function_thunks;
+enum class Hlcn : u8 {
+#define HLCN_ENUM(name) name,
+  HLCN_OPS(HLCN_ENUM)
+#undef HLCN_ENUM
 };
 
-void compile(std::map<std::string, AstNode*> program);
-void compile_node(CompileContext *cc, AstNode *in_node);
+struct Instr {
+  Hlcn op;
+  s32 a = 0;
+  s32 b = 0;
+  s32 c = 0;
+};
+
+// One function body or promise callback
+struct Bytecode {
+  std::vector<Instr> code;
+  std::vector<AstNode *> consts;
+  std::vector<Value> literals;
+
+  // Frame size, the resolver's slots plus the compiler's hidden ones
+  int n_slots = 0;
+  // For loop counters, kept outside the frame since they aren't values
+  int n_iters = 0;
+};
+
+// Runs after resolve_slots, every function and promise callback in the module
+// gets a Bytecode the VM runs instead of walking the body
+void compile_module(HylicModule *module);
+Bytecode *compile_function(FuncStmt *func);
+
+const char *hlcn_name(Hlcn op);
+void dump_bytecode(Bytecode *bc);
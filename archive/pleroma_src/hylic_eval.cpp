@@ -1,9 +1,9 @@
 #include "hylic_eval.h"
-#include "../other_src/blockingconcurrentqueue.h"
 #include "hylic.h"
 #include "hylic_ast.h"
 #include "other.h"
 #include "pleroma.h"
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <tuple>
@@ -12,8 +12,9 @@
 #include "system.h"
 #include "general_util.h"
 #include "type_util.h"
-
-extern moodycamel::BlockingConcurrentQueue<Vat *> queue;
+#include "scheduler.h"
+#include "hylic_vm.h"
+#include "gc.h"
 
 void set_msg_src(Msg *m, const EntityRefNode &ref) {
   m->src_node_id = ref.node_id;
@@ -40,65 +41,113 @@ void set_msg_target(Msg *m, const EntityAddress &addr) {
 }
 
 int new_promise(EvalContext* context) {
-  int pid = context->vat->promise_id_base;
-  context->vat->promises[pid] = PromiseResult();
-  context->vat->promise_id_base++;
-  return pid;
+  return context->vat->promises.insert();
 }
 
-AstNode *eval_block(EvalContext *context, std::vector<AstNode *> block,
-                    std::vector<std::tuple<std::string, AstNode *>> sub_syms) {
+// Called once the promise's callbacks and dependents have run.  The result
+// takes the promise's place in any field still holding it, then the slot is
+// freed for reuse.
+void release_promise(Vat *vat, int promise_id) {
+  PromiseResult *prom = vat->promises.find(promise_id);
+  assert(prom);
+
+  Value result = prom->results.empty() ? nop_value() : prom->results[0];
+  for (auto [entity_id, slot] : prom->field_holders) {
+    auto find_entity = vat->entities.find(entity_id);
+    if (find_entity == vat->entities.end()) continue;
+
+    // Unless it has been overwritten since
+    Value &field = find_entity->second->fields[slot];
+    if (field.tag == ValueTag::Promise && field.promise_id == promise_id) {
+      field = result;
+    }
+  }
+
+  // Every other promise a fired dependent waited on resolved and was
+  // released earlier, so this is the last one that knows about it
+  auto &deps = prom->dependents;
+  std::sort(deps.begin(), deps.end());
+  deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+  for (auto dpf : deps) {
+    if (dpf->fired) {
+      vat_delete(vat->allocator, dpf);
+    }
+  }
+
+  if (prom->return_msg) {
+    vat_delete(vat->allocator, prom->return_msg);
+    prom->return_msg = nullptr;
+  }
+
+  if (prom->pinned) {
+    prom->callbacks.clear();
+    prom->dependents.clear();
+    prom->field_holders.clear();
+    return;
+  }
+
+  vat->promises.erase(promise_id);
+}
 
-  push_scope(context);
+// Fields are the only place a promise outlives the message that made it
+void store_field(Vat *vat, Entity *entity, int slot, Value val) {
+  entity->fields[slot] = val;
 
-  // load symbols into scope
-  for (auto &[sym, node] : sub_syms) {
-    css(context).table[sym] = node;
+  if (val.tag == ValueTag::Promise) {
+    if (PromiseResult *prom = vat->promises.find(val.promise_id)) {
+      prom->field_holders.push_back({entity->address.entity_id, slot});
+    }
   }
+}
 
-  AstNode *last_val;
+// Locals live in the frame's slots, so a block needs no setup of its own
+Value eval_block(EvalContext *context, const std::vector<AstNode *> &block) {
   for (auto node : block) {
-    last_val = eval(context, node);
-    if (last_val->type == AstNodeType::ReturnNode) {
-      auto v = (ReturnNode *)last_val;
+    Value last_val = eval(context, node);
+    if (last_val.tag == ValueTag::Node && last_val.node->type == AstNodeType::ReturnNode) {
+      auto v = (ReturnNode *)last_val.node;
       return eval(context, v->expr);
     }
   }
 
-  pop_scope(context);
-
-  return make_nop();
+  return nop_value();
 }
 
 void on_promise_do(EvalContext* context, int promise_id, std::vector<AstNode*> body) {
-  context->vat->promises[promise_id].callbacks.push_back((PromiseResNode *)make_promise_resolution_node("anon", body));
+  PromiseResult *prom = context->vat->promises.find(promise_id);
+  assert(prom);
+  prom->callbacks.push_back((PromiseResNode *)make_promise_resolution_node("anon", body));
 }
 
-Entity *resolve_local_entity(EvalContext *context, EntityRefNode *entity_ref) {
-  //printf("Resolving local entity: %d %d %d\n", entity_ref->entity_id, entity_ref->vat_id, entity_ref->node_id);
+Entity *resolve_local_entity(EvalContext *context, Value entity_ref) {
+  //printf("Resolving local entity: %d %d %d\n", entity_ref.ref.entity_id, entity_ref.ref.vat_id, entity_ref.ref_node_id);
   // FIXME - self fix
-  if (entity_ref->entity_id == -1 && entity_ref->vat_id == -1 && entity_ref->node_id == -1) {
+  if (entity_ref.ref.entity_id == -1 && entity_ref.ref.vat_id == -1 && entity_ref.ref_node_id == -1) {
     return context->stack.back().entity;
   } else {
-    auto found_ent = context->vat->entities.find(entity_ref->entity_id);
+    auto found_ent = context->vat->entities.find(entity_ref.ref.entity_id);
     assert(found_ent != context->vat->entities.end());
 
     return found_ent->second;
   }
 }
 
-AstNode *eval_promise_local(EvalContext *context, Entity *entity,
-                            PromiseResult *resolve_node, int promise_id) {
+Value eval_promise_local(EvalContext *context, Entity *entity,
+                          PromiseResult *resolve_node, int promise_id) {
 
-  AstNode* ret;
+  Value ret;
   int iz = 0;
   for (auto &cb : resolve_node->callbacks) {
-    std::vector<std::tuple<std::string, AstNode *>> subs;
-    for (int i = 0; i < resolve_node->results.size(); ++i) {
-      subs.push_back(std::make_tuple(cb->sym, resolve_node->results[i]));
+    bool use_vm = cb->bytecode && context->node->engine == ExecEngine::Vm;
+    push_stack_frame(context, entity, cfs(context).module, NO_SELECTOR, use_vm ? cb->bytecode->n_slots : cb->n_slots);
+
+    // The result goes in slot 0, with several results the last one wins
+    if (!resolve_node->results.empty()) {
+      local_slot(context, 0) = resolve_node->results.back();
     }
 
-    ret = eval_block(context, cb->body, subs);
+    ret = use_vm ? run_bytecode(context, cb->bytecode) : eval_block(context, cb->body);
+    pop_stack_frame(context);
 
     iz++;
   }
@@ -107,11 +156,11 @@ AstNode *eval_promise_local(EvalContext *context, Entity *entity,
     //printf("Executing dependent %d from %d\n", k, promise_id);
     // Actually, just manually send our own message here without calling eval_message_node.  that way we can control the promise id
     if (k->target_depends_on == promise_id) {
-      assert(resolve_node->results[0]->type == AstNodeType::EntityRefNode);
-      EntityRefNode *entity_ref = (EntityRefNode*)resolve_node->results[0];
-      k->target.node_id = entity_ref->node_id;
-      k->target.vat_id = entity_ref->vat_id;
-      k->target.entity_id = entity_ref->entity_id;
+      Value entity_ref = resolve_node->results[0];
+      assert(entity_ref.tag == ValueTag::EntityRef);
+      k->target.node_id = entity_ref.ref_node_id;
+      k->target.vat_id = entity_ref.ref.vat_id;
+      k->target.entity_id = entity_ref.ref.entity_id;
       printf("Got dependent entity target\n");
     } else {
       assert(k->depends_on.find(promise_id) != k->depends_on.end());
@@ -123,7 +172,7 @@ AstNode *eval_promise_local(EvalContext *context, Entity *entity,
     // Message guard
     bool message_ready = true;
     for (auto &zz : k->args) {
-      if (!zz) message_ready = false;
+      if (zz.tag == ValueTag::Empty) message_ready = false;
     }
     if (k->target.node_id == -1) {
       message_ready = false;
@@ -134,91 +183,87 @@ AstNode *eval_promise_local(EvalContext *context, Entity *entity,
     }
     /////////
 
-    printf("Message ready, firing message: %s!\n", k->function_name.c_str());
+    printf("Message ready, firing message: %s!\n", selector_name(k->selector).c_str());
 
     Msg m;
 
     set_msg_target(&m, k->target);
     set_msg_src(&m, cfs(context).entity->address);
 
-    m.function_name = k->function_name;
-
-    for (auto varg : k->args) {
-      m.values.push_back((ValueNode *)varg);
-    }
+    m.selector = k->selector;
 
+    m.values = k->args;
     m.promise_id = k->promise_id;
 
-    context->vat->out_messages.push(m);
+    context->vat->out_messages.push_back(m);
+    k->fired = true;
   }
 
   return ret;
 }
 
-AstNode *eval_func_local(EvalContext *context, Entity *entity, std::string function_name, std::vector<AstNode *> args) {
+Value eval_func_local(EvalContext *context, Entity *entity, Selector sel, std::vector<Value> args) {
 
-  auto func = entity->entity_def->functions.find(function_name);
-  if(func == entity->entity_def->functions.end()) {
-    std::string msg = "Attempted to call function '" + function_name + "' on entity '" + entity->entity_def->name + "': function not found.";
+  FuncStmt *func_def_node = find_function(entity->entity_def, sel);
+  if (!func_def_node) {
+    std::string msg = "Attempted to call function '" + selector_name(sel) + "' on entity '" + entity->entity_def->name + "': function not found.";
     throw PleromaException(msg.c_str());
   }
 
-  FuncStmt *func_def_node = (FuncStmt *)func->second;
   if (func_def_node->args.size() != args.size()) {
-    throw PleromaException(std::string("Runtime error: Amount of arguments in function " + entity->entity_def->name + "::" + function_name +  " doesn't match in eval_func_local. Expected " + std::to_string(func_def_node->args.size()) + ", but got " + std::to_string(args.size())).c_str());
+    throw PleromaException(std::string("Runtime error: Amount of arguments in function " + entity->entity_def->name + "::" + selector_name(sel) +  " doesn't match in eval_func_local. Expected " + std::to_string(func_def_node->args.size()) + ", but got " + std::to_string(args.size())).c_str());
   }
 
-  std::vector<std::tuple<std::string, AstNode *>> subs;
-  for (int i = 0; i < func_def_node->args.size(); ++i) {
-    subs.push_back(std::make_tuple(func_def_node->args[i], eval(context, args[i])));
-  }
+  // The compiler may add hidden slots of its own after the resolver's
+  bool use_vm = func_def_node->bytecode && context->node->engine == ExecEngine::Vm;
+  int n_slots = use_vm ? func_def_node->bytecode->n_slots : func_def_node->n_slots;
+
+  push_stack_frame(context, entity, entity->entity_def->module, sel, std::max<int>(n_slots, args.size()));
 
-  push_stack_frame(context, entity, entity->entity_def->module, function_name);
+  for (int i = 0; i < args.size(); ++i) {
+    local_slot(context, i) = args[i];
+  }
 
-  auto res = eval_block(context, func_def_node->body, subs);
+  auto res = use_vm ? run_bytecode(context, func_def_node->bytecode) : eval_block(context, func_def_node->body);
 
   pop_stack_frame(context);
 
   return res;
 }
 
-AstNode *eval_message_node(EvalContext *context, AstNode *node,
-                           CommMode comm_mode, std::string function_name,
-                           std::vector<AstNode *> args) {
+Value eval_message_node(EvalContext *context, Value node,
+                        CommMode comm_mode, Selector sel,
+                        std::vector<Value> args) {
 
   // 1. Determine what type of Entity we have - local, far, alien
   // 2. Determine if the call will be sync/async and if we care about the result
   // 3. Insert a row into the Promise stack if we need to.  Yield if we are
   // doing async, otherwise wait for return
 
-  //printf("Eval msg node : %d %d %d\n", entity_ref->node_id, entity_ref->vat_id, entity_ref->entity_id);
-
   if (comm_mode == CommMode::Sync) {
-    EntityRefNode *entity_ref = safe_ncast<EntityRefNode*>(node, AstNodeType::EntityRefNode);
-    Entity *target_entity;
-    target_entity = resolve_local_entity(context, entity_ref);
-    //printf("%d %d %d\n", target_entity->address.node_id, target_entity->address.vat_id, target_entity->address.entity_id);
-    //printf("%s %s\n", target_entity->entity_def->name.c_str(), function_name.c_str());
+    if (node.tag != ValueTag::EntityRef) {
+      panic("Expected type EntityRefNode, but got " + ast_type_to_string(value_node_type(node)));
+    }
+    Entity *target_entity = resolve_local_entity(context, node);
     assert(target_entity != nullptr);
-    return eval_func_local(context, target_entity, function_name, args);
+    return eval_func_local(context, target_entity, sel, args);
   } else {
 
-    EntityRefNode *entity_ref;
+    Value entity_ref;
     bool promise_ent_address = true;
     bool promise_args = false;
     int pid = new_promise(context);
 
-    if (node->type == AstNodeType::EntityRefNode) {
-      entity_ref = (EntityRefNode *)node;
+    if (node.tag == ValueTag::EntityRef) {
+      entity_ref = node;
       promise_ent_address = false;
-    } else if (node->type == AstNodeType::PromiseNode) {
-      PromiseNode* prom_node = safe_ncast<PromiseNode*>(node, AstNodeType::PromiseNode);
-      auto res = context->vat->promises.find(prom_node->promise_id);
-      assert(res != context->vat->promises.end());
-
-      if (res->second.resolved) {
-        assert(res->second.results[0]->type == AstNodeType::EntityRefNode);
-        entity_ref = (EntityRefNode*)res->second.results[0];
+    } else if (node.tag == ValueTag::Promise) {
+      PromiseResult *res = context->vat->promises.find(node.promise_id);
+      assert(res);
+
+      if (res->resolved) {
+        assert(res->results[0].tag == ValueTag::EntityRef);
+        entity_ref = res->results[0];
         promise_ent_address = false;
       }
     } else {
@@ -226,36 +271,38 @@ AstNode *eval_message_node(EvalContext *context, AstNode *node,
     }
 
     for (auto &zrk : args) {
-      if (zrk->type == AstNodeType::PromiseNode) {
+      if (zrk.tag == ValueTag::Promise) {
         promise_args = true;
       }
     }
 
     if (promise_ent_address || promise_args) {
-      DependPromFunc *dpf = new DependPromFunc;
+      DependPromFunc *dpf = vat_new<DependPromFunc>(context->vat->allocator);
       dpf->promise_id = pid;
-      dpf->function_name = function_name;
+      dpf->selector = sel;
 
       if (promise_ent_address) {
-        PromiseNode *prom_node = (PromiseNode *)node;
-        assert(context->vat->promises.find(prom_node->promise_id) != context->vat->promises.end());
-        context->vat->promises[prom_node->promise_id].dependents.push_back(dpf);
+        PromiseResult *target_prom = context->vat->promises.find(node.promise_id);
+        assert(target_prom);
+        target_prom->dependents.push_back(dpf);
         dpf->target.node_id = -1;
-        dpf->target_depends_on = prom_node->promise_id;
+        dpf->target_depends_on = node.promise_id;
       } else {
-        dpf->target.node_id = entity_ref->node_id;
-        dpf->target.vat_id = entity_ref->vat_id;
-        dpf->target.entity_id = entity_ref->entity_id;
+        dpf->target.node_id = entity_ref.ref_node_id;
+        dpf->target.vat_id = entity_ref.ref.vat_id;
+        dpf->target.entity_id = entity_ref.ref.entity_id;
       }
 
-      // Copy in args we have, stick promises for ones we don't
+      // Copy in args we have, leave the ones we don't empty
       for (int i = 0; i < args.size(); ++i) {
-        if (args[i]->type != AstNodeType::PromiseNode) {
+        if (args[i].tag != ValueTag::Promise) {
           dpf->args.push_back(args[i]);
         } else {
-          auto argument_pid = ((PromiseNode *)args[i])->promise_id;
-          context->vat->promises[argument_pid].dependents.push_back(dpf);
-          dpf->args.push_back(nullptr);
+          auto argument_pid = args[i].promise_id;
+          PromiseResult *arg_prom = context->vat->promises.find(argument_pid);
+          assert(arg_prom);
+          arg_prom->dependents.push_back(dpf);
+          dpf->args.push_back(Value());
           dpf->depends_on[argument_pid] = i;
           printf("Argument %d depends on %d", argument_pid, i);
         }
@@ -264,20 +311,19 @@ AstNode *eval_message_node(EvalContext *context, AstNode *node,
     } else {
       Msg m;
 
-      set_msg_target(&m, *entity_ref);
+      m.node_id = entity_ref.ref_node_id;
+      m.vat_id = entity_ref.ref.vat_id;
+      m.entity_id = entity_ref.ref.entity_id;
       set_msg_src(&m, cfs(context).entity->address);
 
-      m.function_name = function_name;
+      m.selector = sel;
       m.promise_id = pid;
+      m.values = std::move(args);
 
-      for (auto varg : args) {
-        m.values.push_back((ValueNode *)varg);
-      }
-
-      context->vat->out_messages.push(m);
+      context->vat->out_messages.push_back(m);
     }
 
-    return make_promise_node(pid);
+    return promise_value(pid);
 
   }
 
@@ -286,28 +332,273 @@ AstNode *eval_message_node(EvalContext *context, AstNode *node,
   panic("Unhandled message node");
 }
 
+AstNode *eval_message_node(EvalContext *context, AstNode *node,
+                           CommMode comm_mode, Selector sel,
+                           std::vector<AstNode *> args) {
+  std::vector<Value> vargs;
+  for (auto arg : args) {
+    vargs.push_back(to_value(arg));
+  }
+
+  return box_value(eval_message_node(context, to_value(node), comm_mode, sel, vargs));
+}
+
 void register_gc_obj(EvalContext *context, AstNode* obj) {
-  context->vat->all_objects.push_back(obj);
+  assert(current_allocator() == context->vat->allocator);
+  gc_register(context->vat, obj);
+}
+
+// Boxes a value going into a list, a node made for it belongs to the vat
+AstNode *box_element(EvalContext *context, Value val) {
+  AstNode *node = box_value(val);
+  if (in(val.tag, {ValueTag::Number, ValueTag::EntityRef, ValueTag::Promise})) {
+    register_gc_obj(context, node);
+  }
+
+  if (val.tag == ValueTag::Promise) {
+    if (PromiseResult *prom = context->vat->promises.find(val.promise_id)) {
+      prom->pinned = true;
+    }
+  }
+  return node;
 }
 
 //void register_gc_ent(EvalContext *context, Entity *ent) {
 //}
 
-AstNode *eval(EvalContext *context, AstNode *obj) {
+// Node semantics shared by eval and the bytecode VM, so both engines agree on
+// what every operation does
+
+Value eval_operator(EvalContext *context, OperatorExpr::Op op, Value n1, Value n2) {
+  if (n1.tag == ValueTag::Number && n2.tag == ValueTag::Number) {
+    if (op == OperatorExpr::Plus) {
+      return number_value(n1.number + n2.number);
+    }
+  } else if (n1.tag == ValueTag::Node && n1.node->type == AstNodeType::StringNode &&
+             n2.tag == ValueTag::Node && n2.node->type == AstNodeType::StringNode) {
+    if (op == OperatorExpr::Plus) {
+      auto tmp_str = make_string(((StringNode *)n2.node)->value + ((StringNode *)n1.node)->value);
+      register_gc_obj(context, tmp_str);
+      return node_value(tmp_str);
+    }
+  }
+
+  panic("Unsupported operator for " + ast_type_to_string(value_node_type(n1)) + " and " + ast_type_to_string(value_node_type(n2)));
+}
+
+bool is_string_value(Value v) {
+  return v.tag == ValueTag::Node && v.node->type == AstNodeType::StringNode;
+}
+
+Value eval_comparison(BooleanExpr::Op op, Value term1, Value term2) {
+  if (op == BooleanExpr::GreaterThan ||
+      op == BooleanExpr::LessThan ||
+      op == BooleanExpr::GreaterThanEqual ||
+      op == BooleanExpr::LessThanEqual) {
+
+    s64 n1 = term1.number;
+    s64 n2 = term2.number;
+
+    switch (op) {
+    case BooleanExpr::GreaterThan:
+      return boolean_value(n1 > n2);
+    case BooleanExpr::LessThan:
+      return boolean_value(n1 < n2);
+    case BooleanExpr::GreaterThanEqual:
+      return boolean_value(n1 >= n2);
+    case BooleanExpr::LessThanEqual:
+      return boolean_value(n1 <= n2);
+    default:
+      break;
+    }
+  }
+
+  if (op == BooleanExpr::Equals) {
+    if (term1.tag == ValueTag::Number && term2.tag == ValueTag::Number) {
+      return boolean_value(term1.number == term2.number);
+    } else if (is_string_value(term1) && is_string_value(term2)) {
+      return boolean_value(((StringNode *)term1.node)->value == ((StringNode *)term2.node)->value);
+    } else {
+      assert(false);
+    }
+  }
+
+  return boolean_value(false);
+}
+
+// FIXME only handles strings, numbers and booleans
+bool match_case_equals(Value mexpr, Value mca_eval) {
+  if (is_string_value(mexpr)) {
+    return ((StringNode *)mexpr.node)->value == ((StringNode *)mca_eval.node)->value;
+  } else if (mexpr.tag == ValueTag::Number) {
+    return mexpr.number == mca_eval.number;
+  } else if (mexpr.tag == ValueTag::Boolean) {
+    if (mca_eval.tag != ValueTag::Boolean) {
+      panic("Expected type BooleanNode, but got " + ast_type_to_string(value_node_type(mca_eval)));
+    }
+    return mexpr.boolean == mca_eval.boolean;
+  }
+
+  assert(false);
+  return false;
+}
+
+ListNode *as_list(Value v) {
+  if (v.tag != ValueTag::Node) {
+    panic("Expected type ListNode, but got " + ast_type_to_string(value_node_type(v)));
+  }
+  return safe_ncast<ListNode *>(v.node, AstNodeType::ListNode);
+}
+
+Value eval_index(Value list, Value index) {
+  auto list_node = as_list(list);
+
+  if (index.number >= list_node->list.size()) {
+    printf("%ld\n", index.number);
+    throw PleromaException("Attempted to access array out of bounds.");
+  }
+  return to_value(list_node->list[index.number]);
+}
+
+// List elements are nodes, so anything held inline is boxed on the way in
+void store_index(EvalContext *context, Value list, Value index, Value val) {
+  auto list_node = (ListNode *)list.node;
+  auto node = box_element(context, val);
+  list_node->list[index.number] = node;
+  gc_list_store(context->vat, list_node, node);
+}
+
+Value eval_self(EvalContext *context) {
+  auto eadd = cfs(context).entity->address;
+  return ref_value(eadd.node_id, eadd.vat_id, eadd.entity_id);
+}
+
+Value eval_range(EvalContext *context, Value start, Value end) {
+  if (start.tag != ValueTag::Number || end.tag != ValueTag::Number) {
+    panic("Expected type NumberNode for range bounds");
+  }
+
+  std::vector<AstNode*> new_list;
+  for (int i = start.number; i < end.number; i++) {
+    new_list.push_back(box_element(context, number_value(i)));
+  }
+
+  // FIXME alloc
+  CType *ctype = new CType;
+  ctype->basetype = PType::List;
+  ctype->subtype = lu8();
+  ctype->dtype = DType::Local;
+
+  auto list_node = make_list(new_list, ctype);
+  register_gc_obj(context, list_node);
+  return node_value(list_node);
+}
+
+// A list literal makes a new list each time it's evaluated
+Value eval_list(EvalContext *context, ListNode *literal, const std::vector<Value> &elems) {
+  std::vector<AstNode *> new_list;
+  for (auto &elem : elems) {
+    new_list.push_back(box_element(context, elem));
+  }
+
+  auto list_node = make_list(new_list, literal->ctype.subtype);
+  register_gc_obj(context, list_node);
+  return node_value(list_node);
+}
+
+// HACK builtins until lists get real methods
+Value eval_append(EvalContext *context, Value list, Value val) {
+  auto list_node = (ListNode*) list.node;
+  auto node = box_element(context, val);
+  list_node->list.push_back(node);
+  gc_list_store(context->vat, list_node, node);
+  return nop_value();
+}
+
+Value eval_len(Value list) {
+  auto list_node = (ListNode *)list.node;
+  return number_value(list_node->list.size());
+}
+
+// Kernel functions still take and return nodes
+Value eval_foreign(EvalContext *context, ForeignFuncCall *ffc, const std::vector<Value> &args) {
+  std::vector<AstNode *> boxed_args;
+  for (auto &arg : args) {
+    boxed_args.push_back(box_value(arg));
+  }
+
+  return to_value(ffc->foreign_func(context, boxed_args));
+}
+
+Value eval_create(EvalContext *context, CreateEntityNode *node) {
+  auto creation_ast = cfs(context).module->entity_defs.find(node->entity_def_name);
+
+  if (creation_ast == cfs(context).module->entity_defs.end()) {
+    for (auto &[zz, _] : cfs(context).module->entity_defs) {
+      printf("%s\n", zz.c_str());
+    }
+    panic("Failed to find " + node->entity_def_name);
+  }
+
+  if (node->new_vat) {
+    return promise_new_vat(context, (EntityDef *)creation_ast->second);
+  } else {
+    Entity *ent = create_entity(context, (EntityDef *)creation_ast->second, node->new_vat);
+    return ref_value(ent->address.node_id, ent->address.vat_id, ent->address.entity_id);
+  }
+}
+
+Value eval_on_promise(EvalContext *context, PromiseResNode *node) {
+  auto prom = load_symbol(context, node->promise);
+  assert(prom.tag == ValueTag::Promise);
+
+  PromiseResult *res = context->vat->promises.find(prom.promise_id);
+  assert(res);
+
+  // If available, run now, else stuff the promise into the Promise stack -
+  // will be resolved + run by VM
+  if (res->resolved) {
+    assert(false);
+    // return eval(context, res->result);
+  }
+
+  res->callbacks.push_back(node);
+  return node_value(node);
+}
+
+// Frame for a module access, popped once the accessor is evaluated
+void push_module_frame(EvalContext *context, ModUseNode *node) {
+  //FIXME: appending sys here breaks all user modules
+  auto find_mod = cfs(context).module->imports.find("sys►" + node->mod_name);
+
+  //for (auto &k : cfs(context).module->imports) {
+  //  printf("mod import %s\n", k.first.c_str());
+  //}
+  printf("Inside mod %s\n", node->mod_name.c_str());
+
+  assert(find_mod != cfs(context).module->imports.end());
+
+  push_stack_frame(context, cfs(context).entity, find_mod->second, NO_SELECTOR, 0);
+}
+
+Value eval(EvalContext *context, AstNode *obj) {
+  context->steps++;
+
   if (obj->type == AstNodeType::AssignmentStmt) {
     auto ass_stmt = (AssignmentStmt *)obj;
 
-    AstNode* expr;
+    Value expr;
     SymbolNode *sym;
     if (ass_stmt->sym->type == AstNodeType::SymbolNode) {
       sym = ((SymbolNode*)ass_stmt->sym);
       expr = eval(context, ass_stmt->value);
 
-      std::map<std::string, AstNode *> *find_it = find_symbol_table(context, sym->sym);
-      if (find_it) {
-        (*find_it)[sym->sym] = expr;
+      if (sym->slot_kind == SlotKind::Local) {
+        local_slot(context, sym->slot) = expr;
+      } else if (sym->slot_kind == SlotKind::Field) {
+        store_field(context->vat, cfs(context).entity, sym->slot, expr);
       } else {
-        css(context).table[sym->sym] = expr;
+        throw PleromaException((std::string("Assignment to unresolved symbol: ") + sym->sym).c_str());
       }
     } else if (ass_stmt->sym->type == AstNodeType::IndexNode) {
       IndexNode* ind_node = (IndexNode*) ass_stmt->sym;
@@ -315,12 +606,8 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
         sym = ((SymbolNode *)ind_node->list);
         expr = eval(context, ass_stmt->value);
 
-        auto find_list = (ListNode*)find_symbol(context, sym->sym);
-        int index_value = ((NumberNode*)eval(context, ind_node->accessor))->value;
-
-        find_list->list[index_value] = expr;
-        expr = find_list->list[index_value];
-
+        auto find_list = load_symbol(context, sym);
+        store_index(context, find_list, eval(context, ind_node->accessor), expr);
       }
     } else {
       throw PleromaException("Invalid assignment.");
@@ -335,21 +622,7 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
     auto n1 = eval(context, op_expr->term1);
     auto n2 = eval(context, op_expr->term2);
 
-    if (n1->type == AstNodeType::NumberNode && n2->type == AstNodeType::NumberNode) {
-      if (op_expr->op == OperatorExpr::Plus) {
-        auto tmp_nm = make_number(((NumberNode*)n1)->value + ((NumberNode*)n2)->value);
-        register_gc_obj(context, tmp_nm);
-        return tmp_nm;
-      }
-    } else if (n1->type == AstNodeType::StringNode && n2->type == AstNodeType::StringNode) {
-        if (op_expr->op == OperatorExpr::Plus) {
-          auto tmp_str = make_string(((StringNode *)n2)->value + ((StringNode *)n1)->value);
-          register_gc_obj(context, tmp_str);
-          return tmp_str;
-        }
-    } else{
-      assert(false);
-    }
+    return eval_operator(context, op_expr->op, n1, n2);
   }
 
   if (obj->type == AstNodeType::ModuleStmt) {
@@ -369,141 +642,95 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
     // FIXME
     // load_file(node->module + ".x");
 
-    return make_nop();
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::ReturnNode) {
-    return obj;
+    return node_value(obj);
     // auto node = (ReturnNode*)obj;
     // return eval(node->expr, scope);
   }
 
   if (obj->type == AstNodeType::SelfNode) {
-    auto eadd = cfs(context).entity->address;
-    return make_entity_ref(eadd.node_id, eadd.vat_id, eadd.entity_id);
+    return eval_self(context);
   }
 
   if (obj->type == AstNodeType::CommentNode) {
-    return obj;
+    return node_value(obj);
   }
 
   if (obj->type == AstNodeType::NumberNode) {
-    return obj;
+    return to_value(obj);
   }
 
   if (obj->type == AstNodeType::StringNode) {
-    return obj;
+    return node_value(obj);
   }
 
   if (obj->type == AstNodeType::ListNode) {
     auto table = (ListNode *)obj;
 
-    for (int k = 0; k < table->list.size(); ++k) {
-      table->list[k] = eval(context, table->list[k]);
+    std::vector<Value> elems;
+    for (auto elem : table->list) {
+      elems.push_back(eval(context, elem));
     }
 
-    return obj;
+    return eval_list(context, table, elems);
   }
 
   if (obj->type == AstNodeType::Nop) {
-    return obj;
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::TableNode) {
-    return obj;
+    return node_value(obj);
   }
 
   if (obj->type == AstNodeType::WhileStmt) {
     auto node = (WhileStmt *)obj;
 
-    while (((BooleanNode *)eval(context, node->generator))->value) {
-      eval_block(context, node->body, {});
+    while (eval(context, node->generator).boolean) {
+      eval_block(context, node->body);
     }
 
-    return make_nop();
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::ForStmt) {
     auto node = (ForStmt *)obj;
 
-    auto table = (ListNode *)eval(context, node->generator);
+    auto table = (ListNode *)eval(context, node->generator).node;
 
     for (int k = 0; k < table->list.size(); ++k) {
-      // NOTE push k into sub
-      std::vector<std::tuple<std::string, AstNode *>> subs;
-      subs.push_back(std::make_tuple(node->sym, eval(context, table->list[k])));
-      eval_block(context, node->body, subs);
+      local_slot(context, node->sym_slot) = eval(context, table->list[k]);
+      eval_block(context, node->body);
     }
-    return make_nop();
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::BooleanNode) {
-    return obj;
+    return to_value(obj);
   }
 
   if (obj->type == AstNodeType::IndexNode) {
     IndexNode* ind_node = (IndexNode*)obj;
     assert(obj->type == AstNodeType::IndexNode);
-    ListNode* list_node = (ListNode*)eval(context, ind_node->list);
-    safe_ncast<ListNode*>(list_node, AstNodeType::ListNode);
-    assert(list_node->type == AstNodeType::ListNode);
-
-    auto index = ((NumberNode*)eval(context, ind_node->accessor))->value;
+    Value list_node = eval(context, ind_node->list);
+    as_list(list_node);
 
-    if (index >= list_node->list.size()) {
-      printf("%d\n", index);
-      throw PleromaException("Attempted to access array out of bounds.");
-    }
-    return list_node->list[index];
+    return eval_index(list_node, eval(context, ind_node->accessor));
   }
 
   if (obj->type == AstNodeType::BooleanExpr) {
     auto node = (BooleanExpr *)obj;
     auto term1 = eval(context, node->term1);
     auto term2 = eval(context, node->term2);
-    if (node->op == BooleanExpr::GreaterThan ||
-        node->op == BooleanExpr::LessThan ||
-        node->op == BooleanExpr::GreaterThanEqual ||
-        node->op == BooleanExpr::LessThanEqual) {
-
-      NumberNode *n1 = (NumberNode *)term1;
-      NumberNode *n2 = (NumberNode *)term2;
-
-      switch (node->op) {
-      case BooleanExpr::GreaterThan:
-        return make_boolean(n1->value > n2->value);
-        break;
-      case BooleanExpr::LessThan:
-        return make_boolean(n1->value < n2->value);
-        break;
-      case BooleanExpr::GreaterThanEqual:
-        return make_boolean(n1->value >= n2->value);
-        break;
-      case BooleanExpr::LessThanEqual:
-        return make_boolean(n1->value <= n2->value);
-        break;
-      }
-    }
-
-    if (node->op == BooleanExpr::Equals) {
-      if (term1->type == AstNodeType::NumberNode && term2->type == AstNodeType::NumberNode) {
-        NumberNode *n1 = (NumberNode *)term1;
-        NumberNode *n2 = (NumberNode *)term2;
-        return make_boolean(n1->value == n2->value);
-      } else if (term1->type == AstNodeType::StringNode && term2->type == AstNodeType::StringNode) {
-        StringNode *n1 = (StringNode *)term1;
-        StringNode *n2 = (StringNode *)term2;
-        return make_boolean(n1->value == n2->value);
-      } else {
-        assert(false);
-      }
-    }
 
-    return make_boolean(false);
+    return eval_comparison(node->op, term1, term2);
   }
 
   if (obj->type == AstNodeType::EntityDef) {
-    return obj;
+    return node_value(obj);
   }
 
   if (obj->type == AstNodeType::MatchNode) {
@@ -514,59 +741,40 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
     for (auto match_case : node->cases) {
       // TODO Make it so the order doesn't matter for fallthrough
       if (std::get<0>(match_case)->type == AstNodeType::FallthroughExpr) {
-        return eval_block(context, std::get<1>(match_case), {});
+        return eval_block(context, std::get<1>(match_case));
       } else {
         auto mca_eval = eval(context, std::get<0>(match_case));
 
-        if (mexpr->type == AstNodeType::StringNode) {
-          auto sexpr = (StringNode*) mexpr;
-          auto sexpr_match = (StringNode *)mca_eval;
-          if (sexpr->value == sexpr_match->value) {
-            return eval_block(context, std::get<1>(match_case), {});
-          }
-        } else if (mexpr->type == AstNodeType::NumberNode) {
-          auto sexpr = (NumberNode *)mexpr;
-          auto sexpr_match = (NumberNode *)mca_eval;
-          if (sexpr->value == sexpr_match->value) {
-            return eval_block(context, std::get<1>(match_case), {});
-          }
-        } else if (mexpr->type == AstNodeType::BooleanNode) {
-          auto sexpr = safe_ncast<BooleanNode *>(mexpr, AstNodeType::BooleanNode);
-          auto sexpr_match = safe_ncast<BooleanNode *>(mca_eval, AstNodeType::BooleanNode);
-          if (sexpr->value == sexpr_match->value) {
-            return eval_block(context, std::get<1>(match_case), {});
-          }
-        } else {
-          assert(false);
+        if (match_case_equals(mexpr, mca_eval)) {
+          return eval_block(context, std::get<1>(match_case));
         }
       }
     }
-    return make_nop();
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::FuncStmt) {
-    return make_nop();
+    return nop_value();
   }
 
   if (obj->type == AstNodeType::MessageNode) {
     auto node = (MessageNode *)obj;
-    std::vector<AstNode *> args;
+    std::vector<Value> args;
 
     for (auto arg : node->args) {
       args.push_back(eval(context, arg));
     }
 
+    static const Selector append_sel = intern_selector("append");
+    static const Selector len_sel = intern_selector("len");
+
     // HACK
-    if (node->function_name == "append") {
-      auto list_node = (ListNode*) args[0];
-      auto val = args[1];
-      list_node->list.push_back(val);
-      return make_nop();
+    if (node->selector == append_sel) {
+      return eval_append(context, args[0], args[1]);
     }
 
-    if (node->function_name == "len") {
-      auto list_node = (ListNode *)args[0];
-      return make_number(list_node->list.size());
+    if (node->selector == len_sel) {
+      return eval_len(args[0]);
     }
 
     // Are we calling this on our self?
@@ -574,110 +782,56 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
     // if (node->entity_ref != nullptr) {
     //  ref = (EntityRefNode *)eval(context, node->entity_ref);
     //}
-    AstNode* eref_node = eval(context, node->entity_ref);
+    Value eref_node = eval(context, node->entity_ref);
 
-    printf("%s\n", ast_type_to_string(eref_node->type).c_str());
+    printf("%s\n", ast_type_to_string(value_node_type(eref_node)).c_str());
 
-    return eval_message_node(context, eref_node, node->comm_mode, node->function_name, args);
+    return eval_message_node(context, eref_node, node->comm_mode, node->selector, args);
   }
 
   if (obj->type == AstNodeType::SymbolNode) {
-    return find_symbol(context, ((SymbolNode *)obj)->sym);
+    return load_symbol(context, (SymbolNode *)obj);
   }
 
   if (obj->type == AstNodeType::RangeNode) {
     auto range_node = safe_ncast<RangeNode*>(obj, AstNodeType::RangeNode);
-    auto start_expr = safe_ncast<NumberNode*>(eval(context, range_node->range_start), AstNodeType::NumberNode);
-    auto end_expr = safe_ncast<NumberNode *>(eval(context, range_node->range_end), AstNodeType::NumberNode);
-
-    std::vector<AstNode*> new_list;
-    for (int i = start_expr->value; i < end_expr->value; i++) {
-      new_list.push_back(make_number(i));
-    }
-
-    // FIXME alloc
-    CType *ctype = new CType;
-    ctype->basetype = PType::List;
-    ctype->subtype = lu8();
-    ctype->dtype = DType::Local;
+    auto start_expr = eval(context, range_node->range_start);
+    auto end_expr = eval(context, range_node->range_end);
 
-    return eval(context, make_list(new_list, ctype));
+    return eval_range(context, start_expr, end_expr);
   }
 
   if (obj->type == AstNodeType::CreateEntity) {
-    auto node = (CreateEntityNode *)obj;
-
-    auto creation_ast = cfs(context).module->entity_defs.find(node->entity_def_name);
-
-    if (creation_ast == cfs(context).module->entity_defs.end()) {
-      for (auto &[zz, _] : cfs(context).module->entity_defs) {
-        printf("%s\n", zz.c_str());
-      }
-      panic("Failed to find " + node->entity_def_name);
-    }
-
-    if (node->new_vat) {
-      return promise_new_vat(context, (EntityDef *)creation_ast->second);
-    } else {
-      Entity *ent = create_entity(context, (EntityDef *)creation_ast->second, node->new_vat);
-      return make_entity_ref(ent->address.node_id, ent->address.vat_id, ent->address.entity_id);
-    }
+    return eval_create(context, (CreateEntityNode *)obj);
   }
 
   if (obj->type == AstNodeType::EntityRefNode) {
-    return obj;
+    return to_value(obj);
   }
 
   if (obj->type == AstNodeType::PromiseResNode) {
-    auto node = (PromiseResNode *)obj;
-
-    auto prom_sym = find_symbol(context, node->sym);
-    assert(prom_sym->type == AstNodeType::PromiseNode);
-    auto prom = (PromiseNode *)prom_sym;
-
-    assert(context->vat->promises.find(prom->promise_id) !=
-           context->vat->promises.end());
-
-    // If available, run now, else stuff the promise into the Promise stack -
-    // will be resolved + run by VM
-    if (context->vat->promises[prom->promise_id].resolved) {
-      assert(false);
-      // return eval(context, context->vat->promises[prom->promise_id].result);
-    } else {
-      context->vat->promises[prom->promise_id].callbacks.push_back(node);
-      return obj;
-    }
+    return eval_on_promise(context, (PromiseResNode *)obj);
   }
 
   if (obj->type == AstNodeType::PromiseNode) {
-    return obj;
+    return to_value(obj);
   }
 
   if (obj->type == AstNodeType::ForeignFunc) {
     auto ffc = (ForeignFuncCall *)obj;
 
-    std::vector<AstNode *> args;
+    std::vector<Value> args;
     for (auto k : ffc->args) {
       args.push_back(eval(context, k));
     }
 
-    return ffc->foreign_func(context, args);
+    return eval_foreign(context, ffc, args);
   }
 
   if (obj->type == AstNodeType::ModUseNode) {
     auto node = (ModUseNode *)obj;
 
-    //FIXME: appending sys here breaks all user modules
-    auto find_mod = cfs(context).module->imports.find("sys►" + node->mod_name);
-
-    //for (auto &k : cfs(context).module->imports) {
-    //  printf("mod import %s\n", k.first.c_str());
-    //}
-    printf("Inside mod %s\n", node->mod_name.c_str());
-
-    assert(find_mod != cfs(context).module->imports.end());
-
-    push_stack_frame(context, cfs(context).entity, find_mod->second, "");
+    push_module_frame(context, node);
 
     auto res = eval(context, node->accessor);
     pop_stack_frame(context);
@@ -689,35 +843,54 @@ AstNode *eval(EvalContext *context, AstNode *obj) {
   assert(false);
 }
 
-std::map<std::string, AstNode *> *find_symbol_table(EvalContext *context, std::string sym) {
-for (auto x = cfs(context).scope_stack.rbegin(); x != cfs(context).scope_stack.rend(); x++) {
-    auto found_it = x->table.find(sym);
-    if (found_it != x->table.end()) return &x->table;
-  }
+Value &local_slot(EvalContext *context, int slot) {
+  assert(slot >= 0 && slot < cfs(context).n_slots);
+  return context->slots[cfs(context).slot_base + slot];
+}
 
- if (cfs(context).entity->data.find(sym) != cfs(context).entity->data.end()) {
-   return &cfs(context).entity->data;
+Value &entity_field(Entity *entity, std::string name) {
+  auto found_it = entity->entity_def->field_slots.find(name);
+  if (found_it == entity->entity_def->field_slots.end()) {
+    throw PleromaException((std::string("Entity ") + entity->entity_def->name + " has no variable " + name).c_str());
   }
 
-  return nullptr;
+  return entity->fields[found_it->second];
 }
 
-AstNode *find_symbol(EvalContext *context, std::string sym) {
-  // Search through lexical scopes
-  for (auto x = cfs(context).scope_stack.rbegin(); x != cfs(context).scope_stack.rend(); x++) {
-    auto found_it = x->table.find(sym);
-    if (found_it != x->table.end()) return found_it->second;
+Value load_symbol(EvalContext *context, SymbolNode *node) {
+  if (node->slot_kind == SlotKind::Local) {
+    // Empty if the symbol was never assigned in this frame, or if the node is
+    // running in a frame it wasn't resolved for (module access)
+    if (node->slot < cfs(context).n_slots) {
+      Value val = local_slot(context, node->slot);
+      if (val.tag != ValueTag::Empty) return val;
+    }
+  } else if (node->slot_kind == SlotKind::Field) {
+    return cfs(context).entity->fields[node->slot];
   }
 
-  // Search entity data
-  if (cfs(context).entity->data.find(sym) != cfs(context).entity->data.end()) {
-    return cfs(context).entity->data.find(sym)->second;
+  return find_symbol(context, node->sym);
+}
+
+// Slow path by name, for anything the resolver couldn't place
+Value find_symbol(EvalContext *context, std::string sym) {
+  Entity *entity = cfs(context).entity;
+
+  if (entity) {
+    auto field_it = entity->entity_def->field_slots.find(sym);
+    if (field_it != entity->entity_def->field_slots.end()) {
+      return entity->fields[field_it->second];
+    }
+
+    if (sym == "self") {
+      return ref_value(entity->address.node_id, entity->address.vat_id, entity->address.entity_id);
+    }
   }
 
   // Search file scope
   if (cfs(context).module->entity_defs.find(sym) !=
       cfs(context).module->entity_defs.end()) {
-    return cfs(context).entity->module_scope->entity_defs.find(sym)->second;
+    return node_value(cfs(context).entity->module_scope->entity_defs.find(sym)->second);
   }
 
   dump_locals(context);
@@ -726,26 +899,53 @@ AstNode *find_symbol(EvalContext *context, std::string sym) {
   throw PleromaException((std::string("Failed to find symbol: ") + sym).c_str());
 }
 
-AstNode *promise_new_vat(EvalContext *context, EntityDef *entity_def) {
+Value promise_new_vat(EvalContext *context, EntityDef *entity_def) {
   // FIXME when we do deeper imports
   auto split_name = split_import(entity_def->abs_mod_path);
   auto prog_name = split_name[0];
   auto ent_name = split_name[1];
-  return eval_message_node(context, monad_ref, CommMode::Async, "new-vat", {make_string(prog_name), make_string(ent_name)});
+  return eval_message_node(context, to_value(monad_ref), CommMode::Async, intern_selector("new-vat"), {node_value(make_string(prog_name)), node_value(make_string(ent_name))});
+}
+
+Vat *create_vat(PleromaNode *node, VatPriority priority) {
+  Vat *vat = new Vat;
+  vat->id = node->vat_id_base++;
+  vat->allocator = create_vat_allocator();
+  vat->heap.config = node->gc_config;
+  set_vat_priority(node, vat, priority);
+  register_vat(vat);
+
+  return vat;
+}
+
+void set_vat_priority(PleromaNode *node, Vat *vat, VatPriority priority) {
+  vat->priority = priority;
+
+  if (priority == VatPriority::System) {
+    vat->budget = node->system_budget;
+  } else {
+    vat->budget = node->user_budget;
+  }
+}
+
+bool is_system_entity_def(EntityDef *entity_def) {
+  return split_import(entity_def->abs_mod_path)[0] == "sys";
 }
 
 Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat) {
-  Entity *e = new Entity;
   Vat *vat;
 
   if (new_vat) {
-    vat = new Vat;
-    vat->id = context->node->vat_id_base;
-    context->node->vat_id_base++;
+    vat = create_vat(context->node, is_system_entity_def(entity_def) ? VatPriority::System : VatPriority::User);
   } else {
     vat = context->vat;
   }
 
+  // The new vat isn't runnable until it's woken below, so its allocator is
+  // ours to use until then
+  AllocatorScope vat_scope(vat->allocator);
+  Entity *e = vat_new<Entity>(vat->allocator);
+
   e->entity_def = entity_def;
 
   e->address.entity_id = vat->entity_id_base;
@@ -763,9 +963,10 @@ Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat)
 
   vat->entities[e->address.entity_id] = e;
 
+  e->fields.resize(entity_def->field_slots.size());
   for (auto &[k, v] : entity_def->data) {
     // This just copies the CType
-    e->data[k] = v;
+    e->fields[entity_def->field_slots[k]] = node_value(v);
   }
 
   for (auto &k : entity_def->inocaps) {
@@ -773,7 +974,7 @@ Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat)
     // If far - run get_far_inocap() otherwise if local, just find the symbol and run create
     // Hack for now
     if (k.ctype->entity_name == "monad►Monad") {
-      e->data[k.var_name] = monad_ref;
+      entity_field(e, k.var_name) = to_value(monad_ref);
       //} else if (k.ctype->dtype == DType::Local) {
     } else {
       auto old_vat = context->vat;
@@ -795,7 +996,7 @@ Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat)
       // Old-method
       //Entity* io_ent = create_entity(context, (EntityDef *)entity_def->module->imports[fqn_map[lib_name]]->entity_defs[base_name], false);
       //e->data[k.var_name] = make_entity_ref(io_ent->address.node_id, io_ent->address.vat_id, io_ent->address.entity_id);
-      push_stack_frame(context, e, e->module_scope, "");
+      push_stack_frame(context, e, e->module_scope, NO_SELECTOR, 0);
       assert(monad_ref);
       //if (!monad_ref) {
       //  monad_ref = (EntityRefNode*)make_entity_ref(0, 0, 0);
@@ -804,7 +1005,9 @@ Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat)
       auto helper_ref = make_entity_ref(0, 0, 0);
       helper_ref->ctype = *(k.ctype->subtype);
       //printf("Ctype %s\n", ctype_to_string(&helper_ref->ctype).c_str());
-      e->data[k.var_name] = eval_message_node(context, monad_ref, CommMode::Async, "request-far-entity", {helper_ref});
+      // Passed as a node so the monad still sees its ctype
+      auto far_ent = eval_message_node(context, to_value(monad_ref), CommMode::Async, intern_selector("request-far-entity"), {node_value(helper_ref)});
+      store_field(vat, e, entity_def->field_slots[k.var_name], far_ent);
       pop_stack_frame(context);
 
       // FIXME: see above
@@ -814,11 +1017,16 @@ Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat)
 
   auto old_vat = context->vat;
   context->vat = vat;
-  eval_func_local(context, e, "create", {});
+  // Entities without a constructor are left as their defaults
+  static const Selector create_sel = intern_selector("create");
+  if (find_function(entity_def, create_sel)) {
+    eval_func_local(context, e, create_sel, {});
+  }
   context->vat = old_vat;
 
+  // Flush whatever create sent
   if (new_vat) {
-    queue.enqueue(vat);
+    wake_vat(vat);
   }
 
   //printf("%s (%d, %d, %d)\n", entity_def->name.c_str(), e->address.entity_id, e->address.vat_id, e->address.node_id);
@@ -858,9 +1066,9 @@ void print_value_node(ValueNode *value_node) {
 
 void print_msg(Msg *m) {
   if (m->response) {
-    printf("MsgResponse => %s\n", m->function_name.c_str());
+    printf("MsgResponse => %s\n", selector_name(m->selector).c_str());
   } else {
-    printf("Msg => %s\n", m->function_name.c_str());
+    printf("Msg => %s\n", selector_name(m->selector).c_str());
   }
 
   printf("\tTarget: Node: %d, Vat: %d, Entity: %d\n", m->node_id, m->vat_id,
@@ -869,8 +1077,8 @@ void print_msg(Msg *m) {
          m->src_vat_id, m->src_entity_id);
   printf("\tOther: Promise: %d\n", m->promise_id);
   printf("\tPayload (%zu): ", m->values.size());
-  for (auto k : m->values) {
-    printf("val %d\n", k->value_type);
+  for (auto &k : m->values) {
+    printf("val %d\n", (int)k.tag);
     //print_value_node(k);
   }
   printf("\n\n");
@@ -880,43 +1088,24 @@ void start_context(EvalContext *context, PleromaNode *node, Vat *vat, HylicModul
   context->node = node;
   context->vat = vat;
 
-  push_stack_frame(context, entity, module, "");
-
-  cfs(context).module = module;
-  cfs(context).entity = entity;
-
-  if (entity) {
-    css(context).table = entity->module_scope->entity_defs;
-    if (entity) {
-      css(context).table["self"] = make_entity_ref(entity->address.node_id, entity->address.vat_id, entity->address.entity_id);
-    } else {
-      // FIXME we should not have this
-      css(context).table["self"] = make_entity_ref(-1, -1, -1);
-    }
-  }
-}
-
-void push_scope(EvalContext *context) {
-  cfs(context).scope_stack.push_back(Scope());
-}
-
-void pop_scope(EvalContext *context) {
-  cfs(context).scope_stack.pop_back();
+  push_stack_frame(context, entity, module, NO_SELECTOR, 0);
 }
 
-void push_stack_frame(EvalContext *context, Entity* e, HylicModule* module, std::string func_name) {
+void push_stack_frame(EvalContext *context, Entity* e, HylicModule* module, Selector sel, int n_slots) {
   context->stack.push_back(StackFrame());
   context->stack.back().entity = e;
   context->stack.back().module = module;
+  context->stack.back().selector = sel;
 
-  if (module && e) {
-    context->stack.back().mef_name = module->abs_module_path + "::" + e->entity_def->name + "::" + func_name;
-  }
-
-  push_scope(context);
+  // Capacity is kept between calls, so this only allocates while the stack is
+  // deeper than it has been before
+  context->stack.back().slot_base = context->slots.size();
+  context->stack.back().n_slots = n_slots;
+  context->slots.resize(context->slots.size() + n_slots);
 }
 
 void pop_stack_frame(EvalContext *context) {
+  context->slots.resize(cfs(context).slot_base);
   context->stack.pop_back();
 }
 
@@ -925,16 +1114,12 @@ StackFrame& cfs(EvalContext *context) {
   return context->stack.back();
 }
 
-// Current stack scope
-Scope &css(EvalContext *context) {
-  return context->stack.back().scope_stack.back();
-}
-
 void dump_locals(EvalContext* context) {
   printf("\nLocals:\n");
-  for (auto x = cfs(context).scope_stack.rbegin(); x != cfs(context).scope_stack.rend(); x++) {
-    for (auto &[k, v] : x->table) {
-      printf("\t%s (%s) : %s\n", k.c_str(), ast_type_to_string(v->type).c_str(), stringify_value_node(v).c_str());
+  for (int k = 0; k < cfs(context).n_slots; ++k) {
+    Value v = local_slot(context, k);
+    if (v.tag != ValueTag::Empty) {
+      printf("\tslot %d (%s) : %s\n", k, ast_type_to_string(value_node_type(v)).c_str(), value_to_string(v).c_str());
     }
   }
   printf("\n");
@@ -943,7 +1128,11 @@ void dump_locals(EvalContext* context) {
 void dump_local_stack(EvalContext* context) {
   printf("\nStack (local):\n");
   for (auto x = context->stack.rbegin(); x != context->stack.rend(); x++) {
-    printf("\tFrame: %s\n", x->mef_name.c_str());
+    if (x->module && x->entity) {
+      printf("\tFrame: %s::%s::%s\n", x->module->abs_module_path.c_str(), x->entity->entity_def->name.c_str(), selector_name(x->selector).c_str());
+    } else {
+      printf("\tFrame: \n");
+    }
   }
   printf("\n");
 }
@@ -4,9 +4,15 @@
 #include "common.h"
 #include "hylic_ast.h"
 #include "hylic_parse.h"
+#include "hylic_value.h"
+#include "mailbox.h"
+#include "slab_table.h"
+#include <atomic>
+#include <deque>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 struct EntityAddress {
@@ -19,11 +25,10 @@ struct Entity {
   EntityDef *entity_def;
   EntityAddress address;
 
-  std::map<std::string, AstNode *> data;
+  // Laid out by EntityDef::field_slots
+  std::vector<Value> fields;
   HylicModule* module_scope;
   std::map<std::string, AstNode *> _kdata;
-
-  bool marked = false;
 };
 
 struct Msg {
@@ -39,9 +44,9 @@ struct Msg {
   int src_vat_id = 0;
   int src_node_id = 0;
 
-  std::string function_name;
+  Selector selector = NO_SELECTOR;
 
-  std::vector<ValueNode *> values;
+  std::vector<Value> values;
 };
 
 struct DependPromFunc {
@@ -50,22 +55,123 @@ struct DependPromFunc {
 
   int target_depends_on = -1;
 
-  std::string function_name;
-  std::vector<AstNode *> args;
+  Selector selector;
+  // Empty until the promise it depends on resolves
+  std::vector<Value> args;
   // Promise ID -> result idx
   std::map<int, int> depends_on;
+
+  // Sent once everything it depended on resolved
+  bool fired = false;
 };
 
 struct PromiseResult {
   bool resolved = false;
-  std::vector<ValueNode *> results;
+  std::vector<Value> results;
   std::vector<PromiseResNode*> callbacks;
 
   std::vector<DependPromFunc*> dependents;
 
-  // Return info
-  bool return_msg = false;
-  Msg msg;
+  // Message to answer with the result, set when a function returned this
+  // promise instead of a value
+  Msg *return_msg = nullptr;
+
+  // Entity ID, field slot of every field the promise was stored in.  The
+  // result replaces it there once it resolves.
+  std::vector<std::pair<int, int>> field_holders;
+  // Boxed into a list, which may look it up any time later, so it's never
+  // released
+  bool pinned = false;
+
+  // When the call it waits on left for another node, in steady_clock
+  // nanoseconds, 0 for local calls
+  u64 sent_ns = 0;
+};
+
+// Collector settings, every vat starts from the node's
+struct GcConfig {
+  // Minor collection once this much has been allocated since the last one
+  u64 nursery_bytes = 256 * 1024;
+  // Major collection once the old generation passes this, it grows to twice
+  // what survived each major collection
+  u64 old_bytes = 4 * 1024 * 1024;
+
+  // Spread major collections over dispatches.  Each slice scans or sweeps
+  // step_objects objects, or twice what was allocated since the last slice if
+  // that's more, so the collection keeps ahead of the program
+  bool incremental = false;
+  int step_objects = 4096;
+};
+
+// The HttpLb's server
+struct HttpConfig {
+  u16 port = 8080;
+  // Of each listening socket
+  int backlog = 128;
+  // Each with its own listener on the port, 0 is one per burner
+  int threads = 0;
+  // Of responses kept for routes that asked for it
+  size_t cache_bytes = 16 * 1024 * 1024;
+};
+
+enum class GcPhase { Idle, Marking, Sweeping };
+
+// Bucket k counts pauses shorter than 2^k microseconds, the last one
+// everything longer
+const int GC_PAUSE_BUCKETS = 24;
+
+struct GcStats {
+  u64 n_minor = 0;
+  u64 n_major = 0;
+  // Slices of incremental major collections
+  u64 n_slices = 0;
+  u64 n_freed = 0;
+
+  u64 pause_histogram[GC_PAUSE_BUCKETS] = {};
+  u64 max_pause_us = 0;
+};
+
+// Nodes registered with a vat, split in two generations.  See gc.cpp.
+struct VatHeap {
+  GcConfig config;
+
+  std::vector<AstNode *> young;
+  std::vector<AstNode *> old;
+  u64 young_bytes = 0;
+  u64 old_bytes = 0;
+  u64 old_limit = 0;
+
+  // Old lists young nodes were stored into since the last minor collection
+  std::vector<ListNode *> remembered;
+
+  // Incremental major collection state
+  GcPhase phase = GcPhase::Idle;
+  std::vector<AstNode *> gray;
+  std::vector<AstNode *> sweeping;
+  size_t sweep_pos = 0;
+  u64 allocated_since_slice = 0;
+
+  GcStats stats;
+};
+
+// Round trips of calls to other nodes, from the call leaving its vat to the
+// response arriving back, bucketed by call_rtt_bucket (see node_stats.h)
+const int CALL_RTT_BUCKETS = 128;
+
+struct CallStats {
+  // Counted from every burner
+  std::atomic<u64> rtt_histogram[CALL_RTT_BUCKETS] = {};
+};
+
+// System vats (Monad, NodeMan, Io, ...) are dispatched before user vats
+enum class VatPriority { System = 0, User = 1 };
+
+// How much work a vat may do in one dispatch before it yields its burner.
+// A message always runs to completion, budgets are checked between messages.
+struct VatBudget {
+  int messages = 32;
+  // Evaluated AST nodes or executed VM instructions
+  u64 steps = 100000;
 };
 
 struct Vat {
@@ -73,34 +179,67 @@ struct Vat {
   int run_n = 0;
   int entity_id_base = 0;
 
-  int promise_id_base = 0;
+  // Delivered from any thread, drained by the burner running the vat
+  Mailbox<Msg> messages;
+  std::deque<Msg> out_messages;
 
-  std::mutex message_mtx;
-  std::queue<Msg> messages;
-  std::queue<Msg> out_messages;
+  // Messages delivered but not yet run (plus wakeups), the vat sits in a run
+  // queue exactly while this is non-zero
+  std::atomic<int> n_pending{0};
+  std::atomic<int> n_wakeups{0};
 
-  std::map<int, PromiseResult> promises;
+  // Indexed by promise ID, a promise is released as soon as it resolves and
+  // whatever waited on it has run
+  SlabTable<PromiseResult> promises;
 
   std::map<int, Entity *> entities;
 
   VatAllocator *allocator;
+  VatHeap heap;
 
-  std::vector<Entity*> all_entities;
-  std::vector<AstNode*> all_objects;
+  VatPriority priority = VatPriority::User;
+  VatBudget budget;
 
-  int cycle_since_gc = 0;
+  // Set while a burner is dispatching this vat
+  std::atomic<bool> running{false};
 };
 
-struct Scope {
-  std::map<std::string, AstNode *> table;
-};
+// What runs Hylic function bodies
+enum class ExecEngine { Vm, Ast };
+
+// How calls to other nodes are encoded, see wire.h
+enum class WireFormat { Protobuf, Binary };
 
 struct PleromaNode {
   std::string node_name;
 
   u32 node_id = 0;
 
-  int vat_id_base = 0;
+  // Vats can be created from any burner
+  std::atomic<int> vat_id_base{0};
+
+  // Number of burner threads, 0 uses every hardware thread
+  int n_burners = 0;
+
+  VatBudget system_budget = {256, 1000000};
+  VatBudget user_budget;
+
+  ExecEngine engine = ExecEngine::Vm;
+  WireFormat wire_format = WireFormat::Protobuf;
+
+  GcConfig gc_config;
+  HttpConfig http_config;
+
+  // Packets to other nodes at least this big are compressed when that pays
+  // off, 0 never compresses
+  size_t compress_min_bytes = 1024;
+
+  CallStats call_stats;
+  // Written by the net thread about once a second when set, see node_stats.h
+  std::string stats_path;
+
+  // Calls sent to other nodes unreliably, see NetLane
+  std::unordered_set<Selector> telemetry_selectors;
 
   std::vector<std::string> resources;
 
@@ -110,40 +249,74 @@ struct PleromaNode {
 struct StackFrame {
   HylicModule *module;
   Entity *entity;
-  std::vector<Scope> scope_stack;
 
-  std::string mef_name;
+  // This frame's locals in EvalContext::slots
+  int slot_base = 0;
+  int n_slots = 0;
+
+  Selector selector = NO_SELECTOR;
 };
 
 struct EvalContext {
   PleromaNode *node;
   Vat *vat;
   std::vector<StackFrame> stack;
+  // Locals of every frame on the stack, back to back
+  std::vector<Value> slots;
+
+  // Operand stack and for loop counters of every running VM function, kept
+  // here so their capacity is reused across calls
+  std::vector<Value> vm_stack;
+  std::vector<int> vm_iters;
+
+  // Nodes evaluated (or VM instructions run) in this context, counted against the vat's budget
+  u64 steps = 0;
 };
 
-AstNode *eval(EvalContext *context, AstNode *obj);
-std::map<std::string, AstNode *> *find_symbol_table(EvalContext *context, std::string sym);
-AstNode *find_symbol(EvalContext *context, std::string sym);
+Value eval(EvalContext *context, AstNode *obj);
+Value find_symbol(EvalContext *context, std::string sym);
+Value load_symbol(EvalContext *context, SymbolNode *node);
+Value &local_slot(EvalContext *context, int slot);
+Value &entity_field(Entity *entity, std::string name);
 Entity *create_entity(EvalContext *context, EntityDef *entity_def, bool new_vat);
+Vat *create_vat(PleromaNode *node, VatPriority priority);
+void set_vat_priority(PleromaNode *node, Vat *vat, VatPriority priority);
 void destroy_entity(Entity* e);
-AstNode *eval_func_local(EvalContext *context, Entity *entity, std::string function_name, std::vector<AstNode *> args);
-AstNode *eval_promise_local(EvalContext *context, Entity *entity, PromiseResult *resolve_node, int promise_id);
-AstNode *promise_new_vat(EvalContext *context, EntityDef *entity_def);
+Value eval_func_local(EvalContext *context, Entity *entity, Selector sel, std::vector<Value> args);
+Value eval_promise_local(EvalContext *context, Entity *entity, PromiseResult *resolve_node, int promise_id);
+void release_promise(Vat *vat, int promise_id);
+void store_field(Vat *vat, Entity *entity, int slot, Value val);
+Value promise_new_vat(EvalContext *context, EntityDef *entity_def);
 void print_value_node(ValueNode * value_node);
 void print_msg(Msg * m);
 
 void start_context(EvalContext * context, PleromaNode * node, Vat * vat,
                    HylicModule * module, Entity * entity);
-void push_stack_frame(EvalContext * context, Entity * e, HylicModule * module, std::string func_name);
+void push_stack_frame(EvalContext * context, Entity * e, HylicModule * module, Selector sel, int n_slots);
 void pop_stack_frame(EvalContext * context);
 
-void pop_scope(EvalContext * context);
-void push_scope(EvalContext * context);
-
-AstNode *eval_message_node(EvalContext * context, AstNode * entity_ref, CommMode comm_mode, std::string function_name, std::vector<AstNode *> args);
+Value eval_message_node(EvalContext * context, Value entity_ref, CommMode comm_mode, Selector sel, std::vector<Value> args);
+// Boxed form for kernel code
+AstNode *eval_message_node(EvalContext * context, AstNode * entity_ref, CommMode comm_mode, Selector sel, std::vector<AstNode *> args);
+
+// Shared by eval and the bytecode VM
+Value eval_operator(EvalContext *context, OperatorExpr::Op op, Value n1, Value n2);
+Value eval_comparison(BooleanExpr::Op op, Value term1, Value term2);
+bool match_case_equals(Value mexpr, Value mca_eval);
+Value eval_index(Value list, Value index);
+void store_index(EvalContext *context, Value list, Value index, Value val);
+Value eval_self(EvalContext *context);
+Value eval_range(EvalContext *context, Value start, Value end);
+Value eval_list(EvalContext *context, ListNode *literal, const std::vector<Value> &elems);
+Value eval_append(EvalContext *context, Value list, Value val);
+Value eval_len(Value list);
+Value eval_create(EvalContext *context, CreateEntityNode *node);
+Value eval_on_promise(EvalContext *context, PromiseResNode *node);
+Value eval_foreign(EvalContext *context, ForeignFuncCall *ffc, const std::vector<Value> &args);
+void push_module_frame(EvalContext *context, ModUseNode *node);
+void register_gc_obj(EvalContext *context, AstNode *obj);
 
 StackFrame &cfs(EvalContext * context);
-Scope &css(EvalContext * context);
 
 void dump_locals(EvalContext *context);
 void dump_local_stack(EvalContext *context);
@@ -0,0 +1,218 @@
+#include "hylic_resolver.h"
+#include "hylic_ast.h"
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+
+struct ResolveScope {
+  std::map<std::string, int> table;
+};
+
+// One per frame being laid out, promise callbacks get their own
+struct ResolveContext {
+  EntityDef *entity_def;
+  std::vector<ResolveScope> scope_stack;
+
+  int n_slots = 0;
+};
+
+void push_scope(ResolveContext *context) {
+  context->scope_stack.push_back(ResolveScope());
+}
+
+void pop_scope(ResolveContext *context) {
+  context->scope_stack.pop_back();
+}
+
+int declare_local(ResolveContext *context, std::string sym) {
+  int slot = context->n_slots++;
+  context->scope_stack.back().table[sym] = slot;
+  return slot;
+}
+
+// Same search order eval used to walk at runtime: locals innermost first,
+// then the entity's variables.  Anything else (entity defs, self) is left to
+// the name lookup in find_symbol.
+bool resolve_symbol(ResolveContext *context, SymbolNode *node) {
+  for (auto it = context->scope_stack.rbegin(); it != context->scope_stack.rend(); ++it) {
+    auto found_it = it->table.find(node->sym);
+    if (found_it != it->table.end()) {
+      node->slot_kind = SlotKind::Local;
+      node->slot = found_it->second;
+      return true;
+    }
+  }
+
+  auto field_it = context->entity_def->field_slots.find(node->sym);
+  if (field_it != context->entity_def->field_slots.end()) {
+    node->slot_kind = SlotKind::Field;
+    node->slot = field_it->second;
+    return true;
+  }
+
+  node->slot_kind = SlotKind::Unresolved;
+  node->slot = -1;
+  return false;
+}
+
+void resolve_sub(ResolveContext *context, AstNode *node);
+
+void resolve_block(ResolveContext *context, std::vector<AstNode *> &block) {
+  push_scope(context);
+  for (auto stmt : block) {
+    resolve_sub(context, stmt);
+  }
+  pop_scope(context);
+}
+
+void resolve_sub(ResolveContext *context, AstNode *node) {
+  switch (node->type) {
+
+  case AstNodeType::SymbolNode: {
+    resolve_symbol(context, (SymbolNode *)node);
+  } break;
+
+  case AstNodeType::AssignmentStmt: {
+    auto assmt_node = (AssignmentStmt *)node;
+
+    // The value is evaluated before the target is looked up
+    resolve_sub(context, assmt_node->value);
+
+    if (assmt_node->sym->type == AstNodeType::SymbolNode) {
+      auto sym = (SymbolNode *)assmt_node->sym;
+      if (!resolve_symbol(context, sym)) {
+        sym->slot_kind = SlotKind::Local;
+        sym->slot = declare_local(context, sym->sym);
+      }
+    } else {
+      resolve_sub(context, assmt_node->sym);
+    }
+  } break;
+
+  case AstNodeType::OperatorExpr: {
+    auto op_expr = (OperatorExpr *)node;
+    resolve_sub(context, op_expr->term1);
+    resolve_sub(context, op_expr->term2);
+  } break;
+
+  case AstNodeType::BooleanExpr: {
+    auto bool_expr = (BooleanExpr *)node;
+    resolve_sub(context, bool_expr->term1);
+    resolve_sub(context, bool_expr->term2);
+  } break;
+
+  case AstNodeType::ListNode: {
+    for (auto &k : ((ListNode *)node)->list) {
+      resolve_sub(context, k);
+    }
+  } break;
+
+  case AstNodeType::RangeNode: {
+    auto range_node = (RangeNode *)node;
+    resolve_sub(context, range_node->range_start);
+    resolve_sub(context, range_node->range_end);
+  } break;
+
+  case AstNodeType::IndexNode: {
+    auto index_node = (IndexNode *)node;
+    resolve_sub(context, index_node->list);
+    resolve_sub(context, index_node->accessor);
+  } break;
+
+  case AstNodeType::ReturnNode: {
+    resolve_sub(context, ((ReturnNode *)node)->expr);
+  } break;
+
+  case AstNodeType::WhileStmt: {
+    auto while_node = (WhileStmt *)node;
+    resolve_sub(context, while_node->generator);
+    resolve_block(context, while_node->body);
+  } break;
+
+  case AstNodeType::ForStmt: {
+    auto for_node = (ForStmt *)node;
+    resolve_sub(context, for_node->generator);
+
+    push_scope(context);
+    for_node->sym_slot = declare_local(context, for_node->sym);
+    resolve_block(context, for_node->body);
+    pop_scope(context);
+  } break;
+
+  case AstNodeType::MatchNode: {
+    auto match_node = (MatchNode *)node;
+    resolve_sub(context, match_node->match_expr);
+
+    for (auto &[case_expr, case_body] : match_node->cases) {
+      resolve_sub(context, case_expr);
+      resolve_block(context, case_body);
+    }
+  } break;
+
+  case AstNodeType::MessageNode: {
+    auto msg_node = (MessageNode *)node;
+    resolve_sub(context, msg_node->entity_ref);
+    for (auto &k : msg_node->args) {
+      resolve_sub(context, k);
+    }
+  } break;
+
+  case AstNodeType::ForeignFunc: {
+    for (auto &k : ((ForeignFuncCall *)node)->args) {
+      resolve_sub(context, k);
+    }
+  } break;
+
+  case AstNodeType::ModUseNode: {
+    resolve_sub(context, ((ModUseNode *)node)->accessor);
+  } break;
+
+  case AstNodeType::PromiseResNode: {
+    auto res_node = (PromiseResNode *)node;
+    resolve_symbol(context, res_node->promise);
+
+    // By the time the body runs this frame is long gone
+    ResolveContext cb_context;
+    cb_context.entity_def = context->entity_def;
+    push_scope(&cb_context);
+    int result_slot = declare_local(&cb_context, res_node->sym);
+    assert(result_slot == 0);
+    resolve_block(&cb_context, res_node->body);
+    pop_scope(&cb_context);
+
+    res_node->n_slots = cb_context.n_slots;
+  } break;
+
+  default:
+    // Literals, entity refs, self, create, ... hold no symbols
+    break;
+  }
+}
+
+void resolve_function(EntityDef *entity_def, FuncStmt *func) {
+  ResolveContext context;
+  context.entity_def = entity_def;
+
+  push_scope(&context);
+  for (auto &arg : func->args) {
+    declare_local(&context, arg);
+  }
+
+  resolve_block(&context, func->body);
+  pop_scope(&context);
+
+  func->n_slots = context.n_slots;
+}
+
+void resolve_slots(HylicModule *module) {
+  for (auto &[_, v] : module->entity_defs) {
+    auto entity_def = (EntityDef *)v;
+
+    build_field_slots(entity_def);
+
+    for (auto &[fname, func] : entity_def->functions) {
+      resolve_function(entity_def, func);
+    }
+  }
+}
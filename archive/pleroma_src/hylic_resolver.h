@@ -0,0 +1,8 @@
+#pragma once
+
+#include "hylic_ast.h"
+
+// Runs after typesolve.  Gives every local a slot in its function's frame and
+// every entity variable a slot in Entity::fields, so eval never looks a
+// symbol up by name.
+void resolve_slots(HylicModule *module);
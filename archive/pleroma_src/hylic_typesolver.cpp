@@ -73,6 +73,13 @@ bool exact_match(CType a, CType b) {
   return true;
 }
 
+// Entity parameters take a reference to any entity, near or far, or a
+// promise of one since it resolves before the message is delivered
+bool takes_entity(CType param, CType arg) {
+  if (arg.basetype == PType::Promise && arg.subtype) arg = *arg.subtype;
+  return param.basetype == PType::BaseEntity && (arg.basetype == PType::Entity || arg.basetype == PType::BaseEntity);
+}
+
 CType *typescope_has(TypeContext *context, std::string sym) {
   for (auto it = context->scope_stack.rbegin(); it != context->scope_stack.rend(); ++it) {
     auto found_it = it->table.find(sym);
@@ -333,7 +340,7 @@ CType typesolve_sub(TypeContext* context, AstNode *node) {
     for (int i = 0; i < sig.param_types.size(); ++i) {
       auto t1 = sig.param_types[i];
       auto t2 = typesolve_sub(context, msg_node->args[i]);
-      if (!exact_match(*t1, t2)) {
+      if (!exact_match(*t1, t2) && !takes_entity(*t1, t2)) {
         throw TypesolverException("", 0, 0, "Function parameter types don't match: " + ctype_to_string(t1) + ", " + ctype_to_string(&t2) + " (" + msg_node->function_name.c_str() + ")");
       }
       i++;
@@ -523,4 +530,9 @@ void typesolve(HylicModule* module) {
   for (auto &[k, v] : module->entity_defs) {
     typesolve_sub(&context, v);
   }
+
+  // Kernel functions may have been swapped in since the defs were made
+  for (auto &[k, v] : module->entity_defs) {
+    build_vtable((EntityDef *)v);
+  }
 }
@@ -0,0 +1,100 @@
+#include "hylic_value.h"
+#include "hylic_ast.h"
+
+Value to_value(AstNode *node) {
+  if (!node) return Value();
+
+  switch (node->type) {
+  case AstNodeType::Nop:
+    return nop_value();
+  case AstNodeType::NumberNode:
+    return number_value(((NumberNode *)node)->value);
+  case AstNodeType::BooleanNode:
+    return boolean_value(((BooleanNode *)node)->value);
+  case AstNodeType::EntityRefNode: {
+    auto ref = (EntityRefNode *)node;
+    return ref_value(ref->node_id, ref->vat_id, ref->entity_id);
+  }
+  case AstNodeType::PromiseNode:
+    return promise_value(((PromiseNode *)node)->promise_id);
+  default:
+    return node_value(node);
+  }
+}
+
+AstNode *box_value(Value v) {
+  switch (v.tag) {
+  case ValueTag::Empty:
+    return nullptr;
+  case ValueTag::Nop:
+    return make_nop();
+  case ValueTag::Number:
+    return make_number(v.number);
+  case ValueTag::Boolean:
+    return make_boolean(v.boolean);
+  case ValueTag::EntityRef:
+    return make_entity_ref(v.ref_node_id, v.ref.vat_id, v.ref.entity_id);
+  case ValueTag::Promise:
+    return make_promise_node(v.promise_id);
+  case ValueTag::Node:
+    return v.node;
+  }
+
+  return nullptr;
+}
+
+AstNodeType value_node_type(Value v) {
+  switch (v.tag) {
+  case ValueTag::Nop:
+    return AstNodeType::Nop;
+  case ValueTag::Number:
+    return AstNodeType::NumberNode;
+  case ValueTag::Boolean:
+    return AstNodeType::BooleanNode;
+  case ValueTag::EntityRef:
+    return AstNodeType::EntityRefNode;
+  case ValueTag::Promise:
+    return AstNodeType::PromiseNode;
+  case ValueTag::Node:
+    return v.node->type;
+  case ValueTag::Empty:
+    break;
+  }
+
+  panic("Empty value has no type");
+  return AstNodeType::Nop;
+}
+
+std::string value_to_string(Value v) {
+  switch (v.tag) {
+  case ValueTag::Empty:
+    return "empty";
+  case ValueTag::Nop:
+    return "Nop";
+  case ValueTag::Number:
+    return std::to_string(v.number);
+  case ValueTag::Boolean:
+    return v.boolean ? "#t" : "#f";
+  case ValueTag::EntityRef:
+    return "ref(" + std::to_string(v.ref_node_id) + " " + std::to_string(v.ref.vat_id) + " " + std::to_string(v.ref.entity_id) + ")";
+  case ValueTag::Promise:
+    return "promise(" + std::to_string(v.promise_id) + ")";
+  case ValueTag::Node:
+    break;
+  }
+
+  switch (v.node->type) {
+  case AstNodeType::StringNode:
+    return "\"" + ((StringNode *)v.node)->value + "\"";
+  case AstNodeType::ListNode: {
+    std::string res = "[";
+    for (auto elem : ((ListNode *)v.node)->list) {
+      if (res.size() > 1) res += ", ";
+      res += value_to_string(to_value(elem));
+    }
+    return res + "]";
+  }
+  default:
+    return ast_type_to_string(v.node->type);
+  }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common.h"
+#include "hylic_ast.h"
+#include <string>
+
+// What a Value holds.  Empty is an unset slot (or a message argument still
+// waiting on its promise), Node is anything that lives on the heap: strings,
+// lists, entity defs, ...
+enum class ValueTag : u8 { Empty, Nop, Number, Boolean, EntityRef, Promise, Node };
+
+// Numbers, booleans, entity refs and promises are carried inline, so they go
+// through eval, frames, entity fields and messages without allocating.
+struct Value {
+  ValueTag tag = ValueTag::Empty;
+
+  // An entity ref needs three ids, the node id sits next to the tag
+  s32 ref_node_id = 0;
+
+  struct RefIds {
+    s32 vat_id;
+    s32 entity_id;
+  };
+
+  union {
+    s64 number;
+    bool boolean;
+    RefIds ref;
+    s32 promise_id;
+    AstNode *node;
+  };
+
+  Value() : number(0) {}
+};
+
+static_assert(sizeof(Value) == 16, "Value should stay two words");
+
+inline Value number_value(s64 number) {
+  Value v;
+  v.tag = ValueTag::Number;
+  v.number = number;
+  return v;
+}
+
+inline Value boolean_value(bool boolean) {
+  Value v;
+  v.tag = ValueTag::Boolean;
+  v.boolean = boolean;
+  return v;
+}
+
+inline Value ref_value(s32 node_id, s32 vat_id, s32 entity_id) {
+  Value v;
+  v.tag = ValueTag::EntityRef;
+  v.ref_node_id = node_id;
+  v.ref.vat_id = vat_id;
+  v.ref.entity_id = entity_id;
+  return v;
+}
+
+inline Value promise_value(s32 promise_id) {
+  Value v;
+  v.tag = ValueTag::Promise;
+  v.promise_id = promise_id;
+  return v;
+}
+
+inline Value nop_value() {
+  Value v;
+  v.tag = ValueTag::Nop;
+  return v;
+}
+
+// Keeps the node as it is, even if it could be unboxed.  An EntityRefNode
+// carrying a ctype (request-far-entity) has to travel like this.
+inline Value node_value(AstNode *node) {
+  Value v;
+  if (node) {
+    v.tag = ValueTag::Node;
+    v.node = node;
+  }
+  return v;
+}
+
+// Between Values and nodes, for kernel functions, list elements and the wire.
+// to_value unboxes whatever it can, box_value allocates a node for anything
+// held inline.
+Value to_value(AstNode *node);
+AstNode *box_value(Value v);
+
+// Type the value would have as a node, for checks and error messages
+AstNodeType value_node_type(Value v);
+std::string value_to_string(Value v);
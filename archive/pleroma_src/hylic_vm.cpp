@@ -0,0 +1,322 @@
+#include "hylic_vm.h"
+#include "hylic_ast.h"
+#include "other.h"
+#include <cassert>
+#include <vector>
+
+// Dispatch through a table of label addresses where the compiler allows it,
+// a switch everywhere else
+#if defined(__GNUC__) || defined(__clang__)
+#define HYLIC_VM_COMPUTED_GOTO
+#endif
+
+// Puts the operand stack and loop counters back however the function exits,
+// a PleromaException can unwind through several nested calls
+struct VmStackGuard {
+  EvalContext *context;
+  size_t stack_base;
+  size_t iter_base;
+
+  ~VmStackGuard() {
+    context->vm_stack.resize(stack_base);
+    context->vm_iters.resize(iter_base);
+  }
+};
+
+static inline Value vm_pop(std::vector<Value> &stack) {
+  Value val = stack.back();
+  stack.pop_back();
+  return val;
+}
+
+Value run_bytecode(EvalContext *context, Bytecode *bc) {
+  std::vector<Value> &stack = context->vm_stack;
+  VmStackGuard guard = {context, stack.size(), context->vm_iters.size()};
+  context->vm_iters.resize(guard.iter_base + bc->n_iters, 0);
+
+  const Instr *code = bc->code.data();
+  AstNode *const *consts = bc->consts.data();
+  const Value *literals = bc->literals.data();
+  const Instr *ip = code;
+  const Instr *ins;
+
+  // Cached from the current frame, anything that can push frames or call
+  // into another function may move EvalContext::slots
+  Value *locals;
+  int n_locals;
+  Entity *self;
+
+#define VM_RELOAD_FRAME()                                                      \
+  do {                                                                         \
+    locals = context->slots.data() + cfs(context).slot_base;                   \
+    n_locals = cfs(context).n_slots;                                           \
+    self = cfs(context).entity;                                                \
+  } while (0)
+
+#define VM_POP() vm_pop(stack)
+#define VM_PUSH(v) stack.push_back(v)
+
+  // Pops the top n values into a vector, in the order they were pushed
+#define VM_POP_ARGS(n)                                                         \
+  std::vector<Value> args(stack.end() - (n), stack.end());                     \
+  stack.resize(stack.size() - (n))
+
+  VM_RELOAD_FRAME();
+
+#ifdef HYLIC_VM_COMPUTED_GOTO
+  static void *labels[] = {
+#define HLCN_LABEL(name) &&op_##name,
+    HLCN_OPS(HLCN_LABEL)
+#undef HLCN_LABEL
+  };
+
+#define VM_OP(name) op_##name:
+#define VM_NEXT()                                                              \
+  do {                                                                         \
+    ins = ip++;                                                                \
+    context->steps++;                                                          \
+    goto *labels[(int)ins->op];                                                \
+  } while (0)
+
+  VM_NEXT();
+  {
+#else
+#define VM_OP(name) case Hlcn::name:
+#define VM_NEXT() goto dispatch
+
+dispatch:
+  ins = ip++;
+  context->steps++;
+  switch (ins->op) {
+#endif
+
+  VM_OP(PushConst) {
+    VM_PUSH(literals[ins->a]);
+    VM_NEXT();
+  }
+
+  VM_OP(PushNop) {
+    VM_PUSH(nop_value());
+    VM_NEXT();
+  }
+
+  VM_OP(Pop) {
+    stack.pop_back();
+    VM_NEXT();
+  }
+
+  VM_OP(Dup) {
+    VM_PUSH(stack.back());
+    VM_NEXT();
+  }
+
+  VM_OP(LoadLocal) {
+    // Empty slots go by name, see load_symbol
+    if (ins->a < n_locals && locals[ins->a].tag != ValueTag::Empty) {
+      VM_PUSH(locals[ins->a]);
+    } else {
+      VM_PUSH(load_symbol(context, (SymbolNode *)consts[ins->b]));
+    }
+    VM_NEXT();
+  }
+
+  VM_OP(StoreLocal) {
+    assert(ins->a < n_locals);
+    locals[ins->a] = stack.back();
+    VM_NEXT();
+  }
+
+  VM_OP(LoadField) {
+    VM_PUSH(self->fields[ins->a]);
+    VM_NEXT();
+  }
+
+  VM_OP(StoreField) {
+    store_field(context->vat, self, ins->a, stack.back());
+    VM_NEXT();
+  }
+
+  VM_OP(LoadName) {
+    VM_PUSH(find_symbol(context, ((SymbolNode *)consts[ins->a])->sym));
+    VM_NEXT();
+  }
+
+  VM_OP(StoreIndex) {
+    auto index = VM_POP();
+    auto list = VM_POP();
+    store_index(context, list, index, stack.back());
+    VM_NEXT();
+  }
+
+  VM_OP(Index) {
+    auto index = VM_POP();
+    auto list = VM_POP();
+    VM_PUSH(eval_index(list, index));
+    VM_NEXT();
+  }
+
+  VM_OP(Arith) {
+    auto n2 = VM_POP();
+    auto n1 = VM_POP();
+    VM_PUSH(eval_operator(context, (OperatorExpr::Op)ins->a, n1, n2));
+    VM_NEXT();
+  }
+
+  VM_OP(Compare) {
+    auto term2 = VM_POP();
+    auto term1 = VM_POP();
+    VM_PUSH(eval_comparison((BooleanExpr::Op)ins->a, term1, term2));
+    VM_NEXT();
+  }
+
+  VM_OP(Jump) {
+    ip = code + ins->a;
+    VM_NEXT();
+  }
+
+  VM_OP(JumpIfFalse) {
+    if (!VM_POP().boolean) {
+      ip = code + ins->a;
+    }
+    VM_NEXT();
+  }
+
+  VM_OP(ForInit) {
+    context->vm_iters[guard.iter_base + ins->a] = 0;
+    VM_NEXT();
+  }
+
+  VM_OP(ForNext) {
+    // The length is checked every time round, the body may append
+    auto list = (ListNode *)locals[ins->b].node;
+    int &k = context->vm_iters[guard.iter_base + ins->a];
+    if ((size_t)k < list->list.size()) {
+      VM_PUSH(to_value(list->list[k++]));
+    } else {
+      ip = code + ins->c;
+    }
+    VM_NEXT();
+  }
+
+  VM_OP(ForRangeInit) {
+    auto end = VM_POP();
+    auto start = VM_POP();
+    if (start.tag != ValueTag::Number || end.tag != ValueTag::Number) {
+      panic("Expected type NumberNode for range bounds");
+    }
+    locals[ins->a] = start;
+    locals[ins->b] = end;
+    VM_NEXT();
+  }
+
+  VM_OP(ForRangeNext) {
+    Value &current = locals[ins->a];
+    if (current.number < locals[ins->b].number) {
+      VM_PUSH(current);
+      current.number++;
+    } else {
+      ip = code + ins->c;
+    }
+    VM_NEXT();
+  }
+
+  VM_OP(MatchTest) {
+    auto case_val = VM_POP();
+    auto match_val = VM_POP();
+    if (!match_case_equals(match_val, case_val)) {
+      ip = code + ins->a;
+    }
+    VM_NEXT();
+  }
+
+  VM_OP(MakeList) {
+    VM_POP_ARGS(ins->b);
+    VM_PUSH(eval_list(context, (ListNode *)consts[ins->a], args));
+    VM_NEXT();
+  }
+
+  VM_OP(MakeRange) {
+    auto end = VM_POP();
+    auto start = VM_POP();
+    VM_PUSH(eval_range(context, start, end));
+    VM_NEXT();
+  }
+
+  VM_OP(Self) {
+    VM_PUSH(eval_self(context));
+    VM_NEXT();
+  }
+
+  VM_OP(Send) {
+    auto eref_node = VM_POP();
+    VM_POP_ARGS(ins->b);
+    auto res = eval_message_node(context, eref_node, (CommMode)ins->c, (Selector)ins->a, args);
+    VM_RELOAD_FRAME();
+    VM_PUSH(res);
+    VM_NEXT();
+  }
+
+  VM_OP(Append) {
+    VM_POP_ARGS(ins->b);
+    VM_PUSH(eval_append(context, args[0], args[1]));
+    VM_NEXT();
+  }
+
+  VM_OP(Len) {
+    VM_POP_ARGS(ins->b);
+    VM_PUSH(eval_len(args[0]));
+    VM_NEXT();
+  }
+
+  VM_OP(Create) {
+    auto res = eval_create(context, (CreateEntityNode *)consts[ins->a]);
+    VM_RELOAD_FRAME();
+    VM_PUSH(res);
+    VM_NEXT();
+  }
+
+  VM_OP(OnPromise) {
+    VM_PUSH(eval_on_promise(context, (PromiseResNode *)consts[ins->a]));
+    VM_NEXT();
+  }
+
+  VM_OP(CallForeign) {
+    auto ffc = (ForeignFuncCall *)consts[ins->a];
+    VM_POP_ARGS(ins->b);
+    auto res = eval_foreign(context, ffc, args);
+    VM_RELOAD_FRAME();
+    VM_PUSH(res);
+    VM_NEXT();
+  }
+
+  VM_OP(EnterModule) {
+    push_module_frame(context, (ModUseNode *)consts[ins->a]);
+    VM_RELOAD_FRAME();
+    VM_NEXT();
+  }
+
+  VM_OP(LeaveModule) {
+    pop_stack_frame(context);
+    VM_RELOAD_FRAME();
+    VM_NEXT();
+  }
+
+  VM_OP(Fail) {
+    throw PleromaException(((StringNode *)consts[ins->a])->value.c_str());
+  }
+
+  VM_OP(Return) {
+    return VM_POP();
+  }
+
+  }
+
+#undef VM_OP
+#undef VM_NEXT
+#undef VM_POP_ARGS
+#undef VM_PUSH
+#undef VM_POP
+#undef VM_RELOAD_FRAME
+
+  panic("Fell off the end of a bytecode dispatch");
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "hylic_compiler.h"
+#include "hylic_eval.h"
+
+// Runs a compiled body in the current stack frame, which the caller has
+// pushed with bc->n_slots slots.  Calls out to eval's helpers for anything
+// that touches entities, messages or promises, so both engines behave the same.
+Value run_bytecode(EvalContext *context, Bytecode *bc);
@@ -0,0 +1,157 @@
+#include "lz.h"
+#include <cstring>
+
+// Matches have to end this far from the end, and can't start in the last
+// LZ_MF_LIMIT bytes, same as LZ4 so its decoders accept our output
+const size_t LZ_LAST_LITERALS = 5;
+const size_t LZ_MF_LIMIT = 12;
+const size_t LZ_MAX_OFFSET = 65535;
+
+const int LZ_HASH_BITS = 12;
+
+static u32 read32(const u8 *p) {
+  u32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static u32 hash4(u32 v) {
+  return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// 15 in the nibble, then the rest in bytes of up to 255
+static u8 *write_length(u8 *out, size_t len) {
+  len -= 15;
+  while (len >= 255) {
+    *out++ = 255;
+    len -= 255;
+  }
+  *out++ = (u8)len;
+  return out;
+}
+
+static u8 *write_sequence(u8 *out, const u8 *literals, size_t n_literals, size_t offset, size_t match_len) {
+  u8 *token = out++;
+  *token = (u8)((n_literals >= 15 ? 15 : n_literals) << 4);
+  if (n_literals >= 15) out = write_length(out, n_literals);
+  if (n_literals > 0) memcpy(out, literals, n_literals);
+  out += n_literals;
+
+  // The final sequence
+  if (match_len == 0) return out;
+
+  *out++ = (u8)offset;
+  *out++ = (u8)(offset >> 8);
+
+  size_t extra = match_len - LZ_MIN_MATCH;
+  *token |= (u8)(extra >= 15 ? 15 : extra);
+  if (extra >= 15) out = write_length(out, extra);
+  return out;
+}
+
+size_t lz_compress_bound(size_t len) {
+  return len + len / 255 + 16;
+}
+
+size_t lz_compress(const u8 *src, size_t len, u8 *dst) {
+  u8 *out = dst;
+  size_t anchor = 0;
+
+  if (len > LZ_MF_LIMIT) {
+    // Last position each 4-byte hash was seen at, stale entries are caught by
+    // comparing the bytes
+    u32 table[1 << LZ_HASH_BITS] = {};
+    size_t match_limit = len - LZ_LAST_LITERALS;
+    size_t pos = 1;
+
+    while (pos + LZ_MF_LIMIT < len) {
+      u32 seq = read32(src + pos);
+      u32 h = hash4(seq);
+      size_t cand = table[h];
+      table[h] = (u32)pos;
+
+      if (cand >= pos || pos - cand > LZ_MAX_OFFSET || read32(src + cand) != seq) {
+        // Step faster through data that doesn't compress
+        pos += 1 + ((pos - anchor) >> 6);
+        continue;
+      }
+
+      // Extend backwards over literals that match too
+      while (pos > anchor && cand > 0 && src[pos - 1] == src[cand - 1]) {
+        pos--;
+        cand--;
+      }
+
+      size_t match_len = LZ_MIN_MATCH;
+      while (pos + match_len < match_limit && src[pos + match_len] == src[cand + match_len]) {
+        match_len++;
+      }
+
+      out = write_sequence(out, src + anchor, pos - anchor, pos - cand, match_len);
+      pos += match_len;
+      anchor = pos;
+
+      if (pos + LZ_MF_LIMIT < len) {
+        table[hash4(read32(src + pos - 2))] = (u32)(pos - 2);
+      }
+    }
+  }
+
+  out = write_sequence(out, src + anchor, len - anchor, 0, 0);
+  return out - dst;
+}
+
+// Reads the 255-saturated bytes after a 15 nibble
+static bool read_length(const u8 *&in, const u8 *end, size_t *len, size_t max) {
+  u8 b;
+  do {
+    if (in >= end) return false;
+    b = *in++;
+    *len += b;
+    if (*len > max) return false;
+  } while (b == 255);
+  return true;
+}
+
+bool lz_decompress(const u8 *src, size_t len, u8 *dst, size_t out_len) {
+  const u8 *in = src;
+  const u8 *in_end = src + len;
+  u8 *out = dst;
+  u8 *out_end = dst + out_len;
+
+  while (in < in_end) {
+    u8 token = *in++;
+
+    size_t n_literals = token >> 4;
+    if (n_literals == 15 && !read_length(in, in_end, &n_literals, out_len)) return false;
+    if (n_literals > (size_t)(in_end - in) || n_literals > (size_t)(out_end - out)) return false;
+    memcpy(out, in, n_literals);
+    in += n_literals;
+    out += n_literals;
+
+    if (in == in_end) break;
+
+    if (in_end - in < 2) return false;
+    size_t offset = in[0] | (in[1] << 8);
+    in += 2;
+    if (offset == 0 || offset > (size_t)(out - dst)) return false;
+
+    size_t match_len = token & 15;
+    if (match_len == 15 && !read_length(in, in_end, &match_len, out_len)) return false;
+    match_len += LZ_MIN_MATCH;
+    if (match_len > (size_t)(out_end - out)) return false;
+
+    // Byte by byte, a match may overlap what it is writing
+    const u8 *from = out - offset;
+    if (offset >= match_len) {
+      memcpy(out, from, match_len);
+      out += match_len;
+    } else {
+      for (size_t k = 0; k < match_len; ++k) {
+        *out++ = from[k];
+      }
+    }
+  }
+
+  return out == out_end;
+}
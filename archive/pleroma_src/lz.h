@@ -0,0 +1,25 @@
+#pragma once
+
+#include "common.h"
+#include <cstddef>
+
+// Byte-oriented LZ77 in the LZ4 block format: a sequence is a token byte
+// (literal count in the high nibble, match length - LZ_MIN_MATCH in the low
+// one, 15 meaning more follows in 255-saturated bytes), the literals, then a
+// little-endian u16 offset back into the output and the match length
+// extension.  The last sequence is literals only.  Fast rather than tight,
+// it is meant for packets between nodes.
+
+const size_t LZ_MIN_MATCH = 4;
+
+// Largest output lz_compress can produce for len bytes
+size_t lz_compress_bound(size_t len);
+
+// Writes the compressed form of src into dst, which must hold
+// lz_compress_bound(len) bytes, and returns its length
+size_t lz_compress(const u8 *src, size_t len, u8 *dst);
+
+// Decompresses exactly out_len bytes into dst.  False if the input is
+// malformed or doesn't decompress to exactly out_len bytes, dst may have
+// been written to either way.
+bool lz_decompress(const u8 *src, size_t len, u8 *dst, size_t out_len);
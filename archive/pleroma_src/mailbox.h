@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Unbounded multi-producer single-consumer queue (Vyukov).  Any thread may
+// push, only the burner currently running the vat may pop.  Pushes from the
+// same thread are popped in the order they were made.
+template <class T>
+struct Mailbox {
+  struct Node {
+    std::atomic<Node *> next{nullptr};
+    T value;
+  };
+
+  // Producers swing head, the consumer walks tail towards it
+  std::atomic<Node *> head;
+  Node *tail;
+
+  Mailbox() {
+    Node *stub = new Node;
+    head = stub;
+    tail = stub;
+  }
+
+  ~Mailbox() {
+    while (tail) {
+      Node *next = tail->next.load();
+      delete tail;
+      tail = next;
+    }
+  }
+
+  Mailbox(const Mailbox &) = delete;
+  Mailbox &operator=(const Mailbox &) = delete;
+
+  void push(T value) {
+    Node *node = new Node;
+    node->value = std::move(value);
+
+    Node *prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Can miss a push that is still linking itself in, callers keep their own
+  // count of what is pending and retry later
+  bool pop(T *out) {
+    Node *next = tail->next.load(std::memory_order_acquire);
+    if (!next) return false;
+
+    *out = std::move(next->value);
+    delete tail;
+    tail = next;
+    return true;
+  }
+};
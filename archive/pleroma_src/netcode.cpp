@@ -2,17 +2,26 @@
 #include "../other_src/concurrentqueue.h"
 #include "../shared_src/protoloma.pb.h"
 #include "core/kernel.h"
+#include "gc.h"
 #include "general_util.h"
 #include "hylic.h"
 #include "hylic_ast.h"
 #include "hylic_eval.h"
+#include "lz.h"
+#include "node_stats.h"
 #include "other.h"
 #include "pleroma.h"
+#include "scheduler.h"
+#include "wire.h"
+#include "../other_src/json.hpp"
 #include <arpa/inet.h>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <enet/enet.h>
 #include <enet/types.h>
+#include <google/protobuf/arena.h>
 #include <immintrin.h>
 #include <map>
 #include <string>
@@ -22,19 +31,209 @@
 int pleroma_nodes_n = 1;
 
 moodycamel::ConcurrentQueue<Msg> net_out_queue;
-std::queue<Msg> net_in_queue;
 
-moodycamel::ConcurrentQueue<Vat *> net_vats;
+// Calls going to the same peer are packed into one CallBatch packet, sent
+// once it holds NET_BATCH_MAX_BYTES or its first call has waited
+// NET_BATCH_MAX_DELAY_US
+const size_t NET_BATCH_MAX_BYTES = 32 * 1024;
+const u64 NET_BATCH_MAX_DELAY_US = 250;
+// Outgoing messages handled per net_loop before going back to receiving
+const int NET_MAX_SENDS_PER_LOOP = 4096;
+// Inbound packets are parsed into an arena that starts with this block and is
+// reset for every packet, so parsing a batch that fits takes no allocations
+const size_t NET_RX_ARENA_BLOCK = 256 * 1024;
+
+// Traffic to a peer is split in lanes, each batched separately and sent on
+// its own ENet channel, so control traffic isn't sequenced behind bulk user
+// payloads.  A vat's calls all go on one lane, which keeps them in order.
+enum class NetLane : u8 {
+  // System vats (Monad new-vat, NodeMan create-vat, ...), calls not sent by
+  // any vat like irq-handler, and the cluster's own messages
+  Control = 0,
+  // User vats
+  Data = 1,
+  // Selectors listed under "telemetry" in the node config, unreliable and
+  // sequenced: a late or lost call is dropped, so they should be ones nobody
+  // waits on a response to
+  Telemetry = 2
+};
+const int NET_LANES = 3;
+
+struct NetLaneConfig {
+  enet_uint32 packet_flags;
+  size_t max_bytes;
+  u64 max_delay_us;
+};
+
+const NetLaneConfig net_lanes[NET_LANES] = {
+    // Sent every net_loop
+    {ENET_PACKET_FLAG_RELIABLE, NET_BATCH_MAX_BYTES, 0},
+    {ENET_PACKET_FLAG_RELIABLE, NET_BATCH_MAX_BYTES, NET_BATCH_MAX_DELAY_US},
+    // Kept to a datagram, a lost packet only loses a few calls
+    {0, 1200, NET_BATCH_MAX_DELAY_US},
+};
+
+// Data is only handed to ENet while less than this is unacknowledged.  ENet
+// sends a peer's queued reliable packets in order once its window fills, so
+// an unbounded data backlog there would hold up control packets queued after
+// it.  Held back, the data waits in its batch instead.
+const enet_uint32 NET_DATA_MAX_IN_TRANSIT = 64 * 1024;
+
+// Sent in the upper half of the connect data, the lower half is the port we
+// listen on
+enum NetFeatures : enet_uint32 { NET_FEATURE_LZ = 1 << 16 };
+const enet_uint32 NET_CONNECT_PORT_MASK = 0xFFFF;
+
+// Packets of at least the node's compress_min_bytes going to a peer that
+// connected with NET_FEATURE_LZ are compressed (see lz.h), and sent that way
+// if it saves at least 1/NET_LZ_MIN_SAVING of them.  A compressed packet is
+// NET_LZ_MAGIC, the u32 little-endian length it decompresses to and the lz
+// block.  Neither a protobuf PleromaMessage nor a binary packet starts with
+// NET_LZ_MAGIC.
+const u8 NET_LZ_MAGIC = 0xC4;
+const size_t NET_LZ_HEADER_SIZE = 5;
+const size_t NET_LZ_MIN_SAVING = 8;
+// Compressed packets claiming to be larger than this are dropped
+const size_t NET_LZ_MAX_RAW = 64 * 1024 * 1024;
+// Compression counters are logged at most this often, when they changed
+const int NET_LZ_STATS_INTERVAL_S = 10;
+
+struct NetCompressStats {
+  u64 n_compressed = 0;
+  // Tried, didn't pay off and went out as they were
+  u64 n_incompressible = 0;
+  // Of every packet tried, before and as sent
+  u64 bytes_in = 0;
+  u64 bytes_out = 0;
+  u64 compress_ns = 0;
+
+  u64 n_decompressed = 0;
+  u64 decompress_ns = 0;
+};
+
+// Everything that went over the network, counted as calls and as packets
+// with their size on the wire
+struct NetTrafficStats {
+  u64 calls_sent = 0;
+  u64 calls_received = 0;
+  u64 packets_sent = 0;
+  u64 packets_received = 0;
+  u64 bytes_sent = 0;
+  u64 bytes_received = 0;
+};
+
+// The stats file is rewritten at most this often, when anything changed
+const int NET_STATS_WRITE_INTERVAL_MS = 1000;
+
+// Built as a protobuf CallBatch or a binary packet, whichever the node's
+// wire format is
+struct PeerBatch {
+  CallBatchEncoder calls;
+  WireEncoder encoder;
+  int n_calls = 0;
+  size_t n_bytes = 0;
+  std::chrono::steady_clock::time_point opened;
+};
+
+struct PeerLanes {
+  PeerBatch batches[NET_LANES];
+};
+
+// Host and port a node listens on
+typedef std::tuple<enet_uint32, enet_uint16> NetAddr;
+
+static NetAddr addr_key(ENetAddress address) {
+  return std::make_tuple(address.host, address.port);
+}
 
-std::map<int, std::vector<Msg>> sort_queue;
+// Joining a cluster and letting nodes into it is driven by net_loop events,
+// nothing waits on the network.  A joining node dials the cluster, passing
+// the port it listens on, and sends its HostInfo once connected.  The
+// cluster dials back on that port and, once that connection is up and the
+// HostInfo is in, adds the node and answers with AssignClusterInfo.  A step
+// that takes longer than NET_HANDSHAKE_TIMEOUT_MS is given up on, a joining
+// node starts over.
+const int NET_HANDSHAKE_TIMEOUT_MS = 5000;
+
+enum class HandshakeRole {
+  // We're joining the cluster at this address
+  Join,
+  // This node dialed us, we're dialing back and waiting for its HostInfo
+  Admit,
+  // Just a connection, to a peer we were told about
+  Dial
+};
+
+struct Handshake {
+  HandshakeRole role;
+  // Where the other node listens
+  ENetAddress address;
+  // Our connection to it, and whether it is up yet
+  ENetPeer *out = nullptr;
+  bool out_up = false;
+
+  bool sent_host_info = false;
+  bool got_host_info = false;
+  std::vector<std::string> resources;
+
+  std::chrono::steady_clock::time_point deadline;
+};
+
+// Everything needed to send to one other node
+struct NodeRoute {
+  int node_id;
+  // Where it listens
+  NetAddr addr;
+  // Null until our connection to it is up, calls are batched meanwhile
+  ENetPeer *peer = nullptr;
+  PeerLanes lanes;
+};
 
 struct PleromaNetwork {
   ENetHost *server;
-  std::map<std::tuple<enet_uint32, enet_uint16>, ENetPeer *> peers;
-  std::map<int, std::tuple<enet_uint32, enet_uint16>> node_host_map;
+  // Our connections that are up, by where the other end listens
+  std::map<NetAddr, ENetPeer *> peers;
+  // Indexed by node id, null for this node and nodes we don't know of.  Filled
+  // in as nodes join, from AssignClusterInfo and peer announcements, and
+  // cleared when they leave.
+  std::vector<NodeRoute *> routes;
+  std::map<NetAddr, Handshake> handshakes;
+  // Got our node id from the cluster
+  bool joined = false;
+  // What each node, by the address it listens on, said it supports
+  std::map<NetAddr, enet_uint32> features;
+  // Batched calls queued on some peer and not yet flushed
+  int n_batched = 0;
+  // A batch was left waiting out its delay by the last flush, one that could
+  // go out then.  Batches held back by a full Data lane or a peer still
+  // handshaking don't count, the loop would only spin on them.
+  bool batch_due = false;
   u16 src_port;
+
+  google::protobuf::Arena *rx_arena;
+
+  // Reused for compressing and decompressing packets
+  std::string tx_raw;
+  std::vector<u8> tx_lz;
+  std::vector<u8> rx_raw;
+  NetCompressStats lz_stats;
+  u64 lz_stats_logged = 0;
+  std::chrono::steady_clock::time_point lz_stats_time;
+
+  NetTrafficStats traffic;
+  u64 traffic_written = 0;
+  std::chrono::steady_clock::time_point stats_written_time;
 } pnet;
 
+static void expire_handshakes();
+static void send_message(ENetPeer *peer, const romabuf::PleromaMessage &message);
+static void add_route(int node_id, ENetAddress address);
+static void step_handshake(NetAddr key);
+static void log_compress_stats();
+static void write_node_stats();
+static void on_host_info(ENetPeer *peer, const romabuf::HostInfo &host_info);
+static void on_cluster_info(ENetPeer *peer, const romabuf::AssignClusterInfo &clusterinfo);
+
 std::string host32_to_string(u32 ip) {
   std::string ip_str;
 
@@ -49,56 +248,69 @@ std::string host32_to_string(u32 ip) {
   return ip_str;
 }
 
-void announce_new_peer(enet_uint32 host, enet_uint16 port) {
+static std::string addr_ip(NetAddr addr) {
   ENetAddress address;
-  address.host = host;
-  address.port = port;
-
-  romabuf::PleromaMessage message;
-  auto peer_msg = message.mutable_announce_peer();
+  address.host = std::get<0>(addr);
+  address.port = std::get<1>(addr);
 
   char ip_address[32];
   enet_address_get_host_ip(&address, ip_address, 32);
+  return ip_address;
+}
 
-  peer_msg->set_address(std::string(ip_address));
-  peer_msg->set_port(port);
+// Tells every other node we have a route to about the new one
+void announce_new_peer(int node_id) {
+  NodeRoute *new_route = pnet.routes[node_id];
+
+  romabuf::PleromaMessage message;
+  auto peer_msg = message.mutable_announce_peer();
+  peer_msg->set_address(addr_ip(new_route->addr));
+  peer_msg->set_port(std::get<1>(new_route->addr));
+  peer_msg->set_node_id(node_id);
 
-  for (auto &[k, v] : pnet.peers) {
-    ENetAddress peer_add;
-    peer_add.host = std::get<0>(k);
-    peer_add.port = std::get<1>(k);
-    send_msg(peer_add, message);
+  for (auto route : pnet.routes) {
+    if (route && route != new_route && route->peer) {
+      send_message(route->peer, message);
+    }
   }
 }
 
-void assign_cluster_info_msg(enet_uint32 host, enet_uint16 port) {
-  ENetAddress address;
-  address.host = host;
-  address.port = port;
+void assign_cluster_info_msg(int node_id) {
+  NodeRoute *new_route = pnet.routes[node_id];
 
   romabuf::PleromaMessage message;
   auto peer_msg = message.mutable_assign_cluster_info();
 
-  char ip_address[32];
-  enet_address_get_host_ip(&address, ip_address, 32);
-
   peer_msg->set_monad_entity_id(monad_ref->entity_id);
   peer_msg->set_monad_vat_id(monad_ref->vat_id);
   peer_msg->set_monad_node_id(monad_ref->node_id);
+  peer_msg->set_node_id(node_id);
+
+  // The rest of the cluster, besides us
+  for (auto route : pnet.routes) {
+    if (!route || route == new_route) continue;
+
+    auto node = peer_msg->add_nodes();
+    node->set_node_id(route->node_id);
+    node->set_address(addr_ip(route->addr));
+    node->set_port(std::get<1>(route->addr));
+    auto nodeman = node->mutable_nodeman_addr();
+    nodeman->set_node_id(route->node_id);
+    nodeman->set_vat_id(0);
+    nodeman->set_entity_id(0);
+  }
 
-  // FIXME
-  peer_msg->set_node_id(pleroma_nodes_n);
-  pleroma_nodes_n++;
-
-  send_msg(address, message);
+  send_message(new_route->peer, message);
 }
 
 void net_loop() {
   ENetEvent event;
   romabuf::PleromaMessage message;
 
+  // Don't sit on a batch that is waiting to go out
   // FIXME get rid of wait after moving to new queue system
-  while (enet_host_service(pnet.server, &event, 1) > 0) {
+  enet_uint32 timeout = pnet.batch_due ? 0 : 1;
+  while (enet_host_service(pnet.server, &event, timeout) > 0) {
     switch (event.type) {
     case ENET_EVENT_TYPE_CONNECT:
       printf("handling\n");
@@ -111,90 +323,163 @@ void net_loop() {
       break;
 
     case ENET_EVENT_TYPE_DISCONNECT:
+      handle_disconnection(&event);
       /* Reset the peer's client information. */
       event.peer->data = NULL;
     }
   }
 
+  if (!pnet.handshakes.empty()) {
+    expire_handshakes();
+  }
+
   // Send all outgoing messages
   Msg out_mess;
   int n_received = 0;
   while (net_out_queue.try_dequeue(out_mess)) {
     // Sent from the void
     if (out_mess.node_id == -1) {
+      release_msg(out_mess);
       continue;
     }
+    // Burners deliver their own local messages, these come from startup
+    // and the IRQ thread
     if (out_mess.node_id == this_pleroma_node->node_id) {
-      net_in_queue.push(out_mess);
+      deliver_local_msg(out_mess);
     } else {
       send_node_msg(out_mess);
     }
     n_received++;
 
-    if (n_received > 100)
+    if (n_received >= NET_MAX_SENDS_PER_LOOP)
       break;
   }
 
-  // Put incoming messages into the correct mailboxes
-  while (!net_in_queue.empty()) {
-    auto msg_front = net_in_queue.front();
-    sort_queue[msg_front.vat_id].push_back(msg_front);
-    // printf("%d %d %d\n", msg_front.entity_id, msg_front.vat_id,
-    // msg_front.node_id);
-    net_in_queue.pop();
+  flush_batches(false);
+  log_compress_stats();
+  write_node_stats();
+}
+
+// Strings and lists are owned by the message, see export_msg.  The parser
+// already refuses nesting deep enough to matter here.
+static Value pvalue_to_value(const romabuf::PValue &pval) {
+  switch (pval.value_case()) {
+  case romabuf::PValue::kErefVal: {
+    auto &eref = pval.eref_val();
+    if (eref.has_entity_name()) {
+      return node_value(make_typed_ref(eref.node_id(), eref.vat_id(), eref.entity_id(), eref.entity_name()));
+    }
+    return ref_value(eref.node_id(), eref.vat_id(), eref.entity_id());
   }
-  Vat *vat_node;
-  while (net_vats.try_dequeue(vat_node)) {
-    if (sort_queue.find(vat_node->id) != sort_queue.end()) {
-      for (auto zz : sort_queue[vat_node->id]) {
-        vat_node->messages.push(zz);
-      }
-      sort_queue[vat_node->id].clear();
+  case romabuf::PValue::kNumVal:
+    return number_value(pval.num_val().value());
+  case romabuf::PValue::kBoolVal:
+    return boolean_value(pval.bool_val().value());
+  case romabuf::PValue::kStrVal: {
+    auto str_node = make_string(pval.str_val().value());
+    str_node->gc_gen = GcGen::Exported;
+    return node_value(str_node);
+  }
+  case romabuf::PValue::kListVal: {
+    std::vector<AstNode *> elems;
+    elems.reserve(pval.list_val().values_size());
+    for (auto &elem : pval.list_val().values()) {
+      elems.push_back(box_exported(pvalue_to_value(elem)));
     }
+    auto list_node = make_list(elems, nullptr);
+    list_node->gc_gen = GcGen::Exported;
+    return node_value(list_node);
+  }
+  default:
+    // Sent by a newer node, treated as nothing
+    return nop_value();
+  }
+}
 
-    queue.enqueue(vat_node);
+Msg call_to_msg(const romabuf::Call &call) {
+  // MSMC
+  Msg local_m;
+  local_m.entity_id = call.entity_id();
+  local_m.vat_id = call.vat_id();
+  local_m.node_id = call.node_id();
+
+  local_m.src_entity_id = call.src_entity_id();
+  local_m.src_vat_id = call.src_vat_id();
+  local_m.src_node_id = call.src_node_id();
+
+  local_m.promise_id = call.promise_id();
+  local_m.response = call.response();
+  local_m.selector = intern_selector(call.function_id());
+
+  local_m.values.reserve(call.pvalues_size());
+  for (auto &pval : call.pvalues()) {
+    local_m.values.push_back(pvalue_to_value(pval));
   }
+
+  return local_m;
+}
+
+// Decompresses into pnet.rx_raw
+static bool inflate_packet(const u8 *data, size_t len) {
+  if (len < NET_LZ_HEADER_SIZE) return false;
+
+  size_t raw_len = data[1] | (data[2] << 8) | (data[3] << 16) | ((size_t)data[4] << 24);
+  if (raw_len > NET_LZ_MAX_RAW) return false;
+
+  auto start = std::chrono::steady_clock::now();
+  pnet.rx_raw.resize(raw_len);
+  bool ok = lz_decompress(data + NET_LZ_HEADER_SIZE, len - NET_LZ_HEADER_SIZE, pnet.rx_raw.data(), raw_len);
+
+  pnet.lz_stats.n_decompressed++;
+  pnet.lz_stats.decompress_ns +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  return ok;
 }
 
 void on_receive_packet(ENetEvent *event) {
-  std::string buf = std::string((char *)event->packet->data, event->packet->dataLength);
+  const u8 *data = event->packet->data;
+  size_t len = event->packet->dataLength;
 
-  romabuf::PleromaMessage message;
-  message.ParseFromString(buf);
-
-  if (message.has_call()) {
-    auto call = message.call();
-    // MSMC
-    Msg local_m;
-    local_m.entity_id = call.entity_id();
-    local_m.vat_id = call.vat_id();
-    local_m.node_id = call.node_id();
-
-    local_m.src_entity_id = call.src_entity_id();
-    local_m.src_vat_id = call.src_vat_id();
-    local_m.src_node_id = call.src_node_id();
-
-    local_m.promise_id = call.promise_id();
-    local_m.response = call.response();
-    local_m.function_name = call.function_id();
-
-    for (int i = 0; i < call.pvalues_size(); ++i) {
-      auto pval = call.pvalues(i);
-      if (pval.has_eref_val()) {
-        auto eref = pval.eref_val();
-        local_m.values.push_back((ValueNode *)make_entity_ref(eref.node_id(), eref.vat_id(), eref.entity_id()));
-      }
-      if (pval.has_num_val()) {
-        auto num = pval.num_val();
-        local_m.values.push_back((ValueNode *)make_number(num.value()));
-      }
-      if (pval.has_str_val()) {
-        auto pval_str = pval.str_val();
-        local_m.values.push_back((ValueNode *)make_string(pval_str.value()));
-      }
+  pnet.traffic.packets_received++;
+  pnet.traffic.bytes_received += len;
+
+  if (len > 0 && data[0] == NET_LZ_MAGIC) {
+    if (!inflate_packet(data, len)) {
+      dbp(log_warning, "Dropping malformed compressed packet (%zu bytes)", len);
+      return;
+    }
+    data = pnet.rx_raw.data();
+    len = pnet.rx_raw.size();
+  }
+
+  if (is_wire_packet(data, len)) {
+    auto deliver = [](Msg &&m) {
+      pnet.traffic.calls_received++;
+      deliver_local_msg(std::move(m));
+    };
+    if (!wire_decode(data, len, deliver)) {
+      dbp(log_warning, "Dropping malformed or newer binary packet (%zu bytes)", len);
     }
+    return;
+  }
+
+  // Whatever the last packet left in the arena is dead by now
+  pnet.rx_arena->Reset();
+  auto &message = *google::protobuf::Arena::CreateMessage<romabuf::PleromaMessage>(pnet.rx_arena);
+  message.ParseFromArray(data, len);
 
-    net_in_queue.push(local_m);
+  if (message.has_call_batch()) {
+    pnet.traffic.calls_received += message.call_batch().calls_size();
+    for (auto &call : message.call_batch().calls()) {
+      deliver_local_msg(call_to_msg(call));
+    }
+  } else if (message.has_call()) {
+    pnet.traffic.calls_received++;
+    deliver_local_msg(call_to_msg(message.call()));
+  } else if (message.has_host_info()) {
+    on_host_info(event->peer, message.host_info());
+  } else if (message.has_assign_cluster_info()) {
+    on_cluster_info(event->peer, message.assign_cluster_info());
   } else {
     // announce peer
     printf("Got peer announcement!\n");
@@ -202,7 +487,9 @@ void on_receive_packet(ENetEvent *event) {
     ENetAddress address;
     enet_address_set_host(&address, apeer.address().c_str());
     address.port = apeer.port();
-    if (pnet.peers.find(std::make_tuple(address.host, address.port)) == pnet.peers.end()) {
+    if (apeer.has_node_id()) {
+      add_route(apeer.node_id(), address);
+    } else if (pnet.peers.find(std::make_tuple(address.host, address.port)) == pnet.peers.end()) {
 
       // If it's not our own address
       if (address.host == pnet.server->address.host && address.port == pnet.server->address.port) {
@@ -220,122 +507,296 @@ void init_network() {
     fprintf(stderr, "An error occurred while initializing ENet.\n");
     exit(EXIT_FAILURE);
   }
+
+  google::protobuf::ArenaOptions rx_options;
+  rx_options.initial_block = new char[NET_RX_ARENA_BLOCK];
+  rx_options.initial_block_size = NET_RX_ARENA_BLOCK;
+  pnet.rx_arena = new google::protobuf::Arena(rx_options);
 }
 
-void send_packet(ENetPeer *peer, const char *buf, int buf_len) {
-  ENetPacket *packet = enet_packet_create(buf, buf_len, ENET_PACKET_FLAG_RELIABLE);
-  enet_peer_send(peer, 0, packet);
+static void send_message(ENetPeer *peer, const romabuf::PleromaMessage &message) {
+  std::string buf = message.SerializeAsString();
+  ENetPacket *packet = enet_packet_create(buf.data(), buf.length(), ENET_PACKET_FLAG_RELIABLE);
+  pnet.traffic.packets_sent++;
+  pnet.traffic.bytes_sent += buf.length();
+  enet_peer_send(peer, (enet_uint8)NetLane::Control, packet);
   enet_host_flush(pnet.server);
 }
 
 void send_msg(ENetAddress host, romabuf::PleromaMessage msg) {
-  std::string buf = msg.SerializeAsString();
+  send_message(pnet.peers[std::make_tuple(host.host, host.port)], msg);
+}
 
-  send_packet(pnet.peers[std::make_tuple(host.host, host.port)], buf.c_str(), buf.length() + 1);
+static NetLane msg_lane(const Msg &m) {
+  if (this_pleroma_node->telemetry_selectors.count(m.selector)) {
+    return NetLane::Telemetry;
+  }
+  if (m.src_vat_id < 0) {
+    return NetLane::Control;
+  }
+  Vat *vat = m.src_node_id == (int)this_pleroma_node->node_id ? find_vat(m.src_vat_id) : nullptr;
+  return vat && vat->priority == VatPriority::System ? NetLane::Control : NetLane::Data;
 }
 
-void send_node_msg(Msg m) {
-  romabuf::PleromaMessage message;
-  auto call = message.mutable_call();
-  call->set_node_id(m.node_id);
-  call->set_vat_id(m.vat_id);
-  call->set_entity_id(m.entity_id);
-
-  call->set_src_node_id(m.src_node_id);
-  call->set_src_vat_id(m.src_vat_id);
-  call->set_src_entity_id(m.src_entity_id);
-
-  call->set_response(m.response);
-
-  call->set_function_id(m.function_name);
-  call->set_src_function_id(m.function_name);
-
-  call->set_promise_id(m.promise_id);
-
-  for (auto &k : m.values) {
-    auto pval = call->add_pvalues();
-    if (k->type == AstNodeType::EntityRefNode) {
-      EntityRefNode *node = (EntityRefNode *)k;
-      romabuf::ERefVal e;
-      auto blah = pval->mutable_eref_val();
-      blah->set_node_id(node->node_id);
-      blah->set_vat_id(node->vat_id);
-      blah->set_entity_id(node->entity_id);
-    } else if (k->type == AstNodeType::NumberNode) {
-      NumberNode *node = (NumberNode *)k;
-      romabuf::NumVal n;
-      auto blah = pval->mutable_num_val();
-      blah->set_value(node->value);
-    } else if (k->type == AstNodeType::StringNode) {
-      StringNode *node = (StringNode *)k;
-      romabuf::StrVal n;
-      auto blah = pval->mutable_str_val();
-      blah->set_value(node->value);
-    } else {
-      panic("Unhandled value in netcode send.");
-    }
+static bool lane_open(ENetPeer *peer, NetLane lane) {
+  return lane != NetLane::Data || peer->reliableDataInTransit < NET_DATA_MAX_IN_TRANSIT;
+}
+
+static enet_uint32 peer_features(ENetPeer *peer) {
+  auto found = pnet.features.find(addr_key(peer->address));
+  return found == pnet.features.end() ? 0 : found->second;
+}
+
+// Null if compressing doesn't pay off
+static ENetPacket *compress_packet(enet_uint32 flags, const u8 *head, size_t head_len, const u8 *body, size_t body_len) {
+  auto start = std::chrono::steady_clock::now();
+  size_t len = head_len + body_len;
+
+  const u8 *raw = head;
+  if (body_len > 0) {
+    pnet.tx_raw.assign((const char *)head, head_len);
+    pnet.tx_raw.append((const char *)body, body_len);
+    raw = (const u8 *)pnet.tx_raw.data();
   }
 
-  std::string buf = message.SerializeAsString();
-  send_packet(pnet.peers[pnet.node_host_map[m.node_id]], buf.c_str(), buf.length() + 1);
+  pnet.tx_lz.resize(lz_compress_bound(len));
+  size_t lz_len = lz_compress(raw, len, pnet.tx_lz.data());
+
+  ENetPacket *packet = nullptr;
+  NetCompressStats &stats = pnet.lz_stats;
+  if (NET_LZ_HEADER_SIZE + lz_len <= len - len / NET_LZ_MIN_SAVING) {
+    // Allocated uninitialized and filled in place
+    packet = enet_packet_create(nullptr, NET_LZ_HEADER_SIZE + lz_len, flags);
+    packet->data[0] = NET_LZ_MAGIC;
+    packet->data[1] = (u8)len;
+    packet->data[2] = (u8)(len >> 8);
+    packet->data[3] = (u8)(len >> 16);
+    packet->data[4] = (u8)(len >> 24);
+    memcpy(packet->data + NET_LZ_HEADER_SIZE, pnet.tx_lz.data(), lz_len);
+    stats.n_compressed++;
+    stats.bytes_out += packet->dataLength;
+  } else {
+    stats.n_incompressible++;
+    stats.bytes_out += len;
+  }
+  stats.bytes_in += len;
+  stats.compress_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+  return packet;
 }
 
-void setup_server(std::string ip, u16 port) {
-  ENetAddress address;
-  enet_address_set_host(&address, ip.c_str());
-  address.port = port;
-  pnet.server = enet_host_create(&address, 32, 2, 0, 0);
-  if (pnet.server == NULL) {
-    fprintf(stderr, "An error occurred while trying to create an ENet server host.\n");
-    exit(EXIT_FAILURE);
+// The packet for head followed by body
+static ENetPacket *make_packet(ENetPeer *peer, enet_uint32 flags, const u8 *head, size_t head_len, const u8 *body, size_t body_len) {
+  size_t len = head_len + body_len;
+  size_t min_bytes = this_pleroma_node->compress_min_bytes;
+
+  if (min_bytes > 0 && len >= min_bytes && len <= NET_LZ_MAX_RAW && (peer_features(peer) & NET_FEATURE_LZ)) {
+    ENetPacket *packet = compress_packet(flags, head, head_len, body, body_len);
+    if (packet) return packet;
   }
-  pnet.src_port = port;
+
+  // Allocated uninitialized and filled in place
+  ENetPacket *packet = enet_packet_create(nullptr, len, flags);
+  memcpy(packet->data, head, head_len);
+  if (body_len > 0) memcpy(packet->data + head_len, body, body_len);
+  return packet;
 }
 
-ENetPeer *pconnect(ENetAddress address) {
-  ENetPeer *peer = enet_host_connect(pnet.server, &address, 2, pnet.src_port);
-  assert(peer);
-  return peer;
+static void log_compress_stats() {
+  NetCompressStats &stats = pnet.lz_stats;
+  u64 n_packets = stats.n_compressed + stats.n_incompressible + stats.n_decompressed;
+  if (n_packets == pnet.lz_stats_logged) return;
+
+  auto now = std::chrono::steady_clock::now();
+  if (now - pnet.lz_stats_time < std::chrono::seconds(NET_LZ_STATS_INTERVAL_S)) return;
+  pnet.lz_stats_time = now;
+  pnet.lz_stats_logged = n_packets;
+
+  dbp(log_debug, "Compression: %lu of %lu packets, %lu bytes saved of %lu, %luus compressing; %lu inflated in %luus",
+      stats.n_compressed, stats.n_compressed + stats.n_incompressible, stats.bytes_in - stats.bytes_out, stats.bytes_in,
+      stats.compress_ns / 1000, stats.n_decompressed, stats.decompress_ns / 1000);
 }
 
-bool connection_confirmed() {
-  ENetEvent event;
-  if (enet_host_service(pnet.server, &event, 5000) > 0 && event.type == ENET_EVENT_TYPE_CONNECT) {
-    return true;
+// Replaces the file in one rename so a reader never sees half of it
+static void write_node_stats() {
+  if (this_pleroma_node->stats_path.empty()) return;
+
+  NetTrafficStats &traffic = pnet.traffic;
+  u64 rtt_counts[CALL_RTT_BUCKETS];
+  u64 n_rtts = 0;
+  for (int b = 0; b < CALL_RTT_BUCKETS; ++b) {
+    rtt_counts[b] = this_pleroma_node->call_stats.rtt_histogram[b].load(std::memory_order_relaxed);
+    n_rtts += rtt_counts[b];
+  }
+
+  u64 n_events = traffic.packets_sent + traffic.packets_received + n_rtts;
+  auto now = std::chrono::steady_clock::now();
+  if (n_events == pnet.traffic_written) return;
+  if (now - pnet.stats_written_time < std::chrono::milliseconds(NET_STATS_WRITE_INTERVAL_MS)) return;
+  pnet.stats_written_time = now;
+  pnet.traffic_written = n_events;
+
+  nlohmann::json stats;
+  stats["node_id"] = this_pleroma_node->node_id;
+  stats["calls_sent"] = traffic.calls_sent;
+  stats["calls_received"] = traffic.calls_received;
+  stats["packets_sent"] = traffic.packets_sent;
+  stats["packets_received"] = traffic.packets_received;
+  stats["bytes_sent"] = traffic.bytes_sent;
+  stats["bytes_received"] = traffic.bytes_received;
+
+  NetCompressStats &lz = pnet.lz_stats;
+  stats["compress"] = {{"compressed", lz.n_compressed},
+                       {"incompressible", lz.n_incompressible},
+                       {"bytes_in", lz.bytes_in},
+                       {"bytes_out", lz.bytes_out},
+                       {"compress_us", lz.compress_ns / 1000},
+                       {"decompressed", lz.n_decompressed},
+                       {"decompress_us", lz.decompress_ns / 1000}};
+
+  // Non-empty buckets as [shortest round trip in it, count]
+  nlohmann::json buckets = nlohmann::json::array();
+  for (int b = 0; b < CALL_RTT_BUCKETS; ++b) {
+    if (rtt_counts[b] > 0) {
+      buckets.push_back({call_rtt_bucket_floor(b), rtt_counts[b]});
+    }
+  }
+  stats["rtt_us"] = {{"count", n_rtts}, {"buckets", buckets}};
+
+  std::string tmp_path = this_pleroma_node->stats_path + ".tmp";
+  FILE *f = fopen(tmp_path.c_str(), "w");
+  if (!f) {
+    dbp(log_warning, "Can't write stats to %s", tmp_path.c_str());
+    return;
+  }
+  std::string out = stats.dump();
+  fwrite(out.data(), 1, out.size(), f);
+  fclose(f);
+  rename(tmp_path.c_str(), this_pleroma_node->stats_path.c_str());
+}
+
+// Sends the batch without flushing the host, net_loop flushes once for all
+// of them
+void send_batch(ENetPeer *peer, NetLane lane, PeerBatch &batch) {
+  enet_uint32 flags = net_lanes[(int)lane].packet_flags;
+  ENetPacket *packet;
+  if (batch.encoder.n_calls > 0) {
+    packet = make_packet(peer, flags, (const u8 *)batch.encoder.buf.data(), batch.encoder.buf.size(), nullptr, 0);
+    batch.encoder.n_calls = 0;
   } else {
-    return false;
+    u8 header[CALL_BATCH_HEADER_MAX];
+    size_t header_len = call_batch_header(&batch.calls, header);
+    packet = make_packet(peer, flags, header, header_len, (const u8 *)batch.calls.buf.data(), batch.calls.buf.size());
+    call_batch_begin(&batch.calls);
   }
+  pnet.traffic.packets_sent++;
+  pnet.traffic.bytes_sent += packet->dataLength;
+  pnet.traffic.calls_sent += batch.n_calls;
+  enet_peer_send(peer, (enet_uint8)lane, packet);
+
+  pnet.n_batched -= batch.n_calls;
+  batch.n_calls = 0;
+  batch.n_bytes = 0;
 }
 
-void connect_to_client(ENetAddress address) {
-  dbp(log_debug, "Connecting back to client");
-  ENetPeer *peer = pconnect(address);
+void flush_batches(bool force) {
+  auto now = std::chrono::steady_clock::now();
+  bool sent = false;
+  pnet.batch_due = false;
+
+  // Lanes in order, control first
+  for (int k = 0; k < NET_LANES; ++k) {
+    NetLane lane = (NetLane)k;
+    for (auto route : pnet.routes) {
+      if (!route || !route->peer) continue;
+
+      PeerBatch &batch = route->lanes.batches[k];
+      if (batch.n_calls == 0 || !lane_open(route->peer, lane)) continue;
+
+      u64 waited_us = std::chrono::duration_cast<std::chrono::microseconds>(now - batch.opened).count();
+      if (force || waited_us >= net_lanes[k].max_delay_us) {
+        send_batch(route->peer, lane, batch);
+        sent = true;
+      } else {
+        pnet.batch_due = true;
+      }
+    }
+  }
 
-  if (connection_confirmed()) {
-    dbp(log_debug, "Successfully connected to client");
+  if (sent) {
+    enet_host_flush(pnet.server);
   }
+}
 
-  pnet.peers[std::make_tuple(peer->address.host, peer->address.port)] = peer;
-  // FIXME
-  pnet.node_host_map[1] = std::make_tuple(peer->address.host, peer->address.port);
+static NodeRoute *find_route(int node_id) {
+  if (node_id < 0 || node_id >= (int)pnet.routes.size()) return nullptr;
+  return pnet.routes[node_id];
 }
 
-void connect_to_cluster(ENetAddress address) {
-  ENetPeer *peer = pconnect(address);
+void send_node_msg(Msg m) {
+  NodeRoute *route = find_route(m.node_id);
+  if (!route) {
+    dbp(log_warning, "Dropping message %s for unknown node %d", selector_name(m.selector).c_str(), m.node_id);
+    release_msg(m);
+    return;
+  }
 
-  // Confirm outgoing connection
-  if (connection_confirmed()) {
-    dbp(log_debug, "Outgoing connection succeeded.");
-  } else {
-    throw PleromaException("Failed to connect to remote cluster.");
+  NetLane lane = msg_lane(m);
+  PeerBatch &batch = route->lanes.batches[(int)lane];
+
+  if (batch.n_calls == 0) {
+    batch.opened = std::chrono::steady_clock::now();
   }
 
-  if (connection_confirmed()) {
-    dbp(log_debug, "Incoming connection succeeded.");
+  if (this_pleroma_node->wire_format == WireFormat::Binary) {
+    if (batch.encoder.n_calls == 0) {
+      wire_begin(&batch.encoder);
+    }
+    wire_encode_call(&batch.encoder, m);
+    batch.n_bytes = batch.encoder.buf.size();
   } else {
-    throw PleromaException("Remote cluster failed to connect to this local host.");
+    call_batch_encode(&batch.calls, m);
+    batch.n_bytes = batch.calls.buf.size();
+  }
+  release_msg(m);
+
+  batch.n_calls++;
+  pnet.n_batched++;
+
+  if (route->peer && batch.n_bytes >= net_lanes[(int)lane].max_bytes && lane_open(route->peer, lane)) {
+    send_batch(route->peer, lane, batch);
+    enet_host_flush(pnet.server);
   }
+}
 
+void setup_server(std::string ip, u16 port) {
+  ENetAddress address;
+  enet_address_set_host(&address, ip.c_str());
+  address.port = port;
+  pnet.server = enet_host_create(&address, 32, NET_LANES, 0, 0);
+  if (pnet.server == NULL) {
+    fprintf(stderr, "An error occurred while trying to create an ENet server host.\n");
+    exit(EXIT_FAILURE);
+  }
+  pnet.src_port = port;
+}
+
+ENetPeer *pconnect(ENetAddress address) {
+  ENetPeer *peer = enet_host_connect(pnet.server, &address, NET_LANES, pnet.src_port | NET_FEATURE_LZ);
+  assert(peer);
+  return peer;
+}
+
+static void start_handshake(HandshakeRole role, ENetAddress address) {
+  Handshake &hs = pnet.handshakes[addr_key(address)];
+  hs.role = role;
+  hs.address = address;
+  hs.out = pconnect(address);
+  hs.out_up = false;
+  hs.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(NET_HANDSHAKE_TIMEOUT_MS);
+}
+
+static void send_host_info(ENetPeer *peer) {
   romabuf::PleromaMessage message;
   auto host_info = message.mutable_host_info();
   host_info->set_port(pnet.src_port);
@@ -350,69 +811,247 @@ void connect_to_cluster(ENetAddress address) {
   host_info->set_node_id(0);
   host_info->set_address("blah");
 
-  auto res = host_info->add_resources();
-
   for (auto &k : this_pleroma_node->resources) {
-    res->append(k);
+    host_info->add_resources(k);
   }
 
-  std::string buf = message.SerializeAsString();
-  send_packet(peer, buf.c_str(), buf.length() + 1);
+  send_message(peer, message);
+}
 
-  ENetEvent event;
-  // Receive our cluster number/Monad info
-  if (enet_host_service(pnet.server, &event, 5000) && event.type == ENET_EVENT_TYPE_RECEIVE) {
-    std::string buf = std::string((char *)event.packet->data, event.packet->dataLength);
+// Our connection to the node listening at key is up
+static void set_peer(NetAddr key, ENetPeer *peer) {
+  pnet.peers[key] = peer;
+  for (auto route : pnet.routes) {
+    if (route && route->addr == key) route->peer = peer;
+  }
+}
 
-    romabuf::PleromaMessage message;
-    message.ParseFromString(buf);
-    assert(message.has_assign_cluster_info());
+// Adds the route to a node, and starts connecting to it unless we are
+// already
+static void add_route(int node_id, ENetAddress address) {
+  if (node_id < 0 || node_id == (int)this_pleroma_node->node_id) return;
 
-    // FIXME
-    pnet.node_host_map[0] = std::make_tuple(event.peer->address.host, event.peer->address.port);
+  if (node_id >= (int)pnet.routes.size()) {
+    pnet.routes.resize(node_id + 1, nullptr);
+  }
+  NodeRoute *&route = pnet.routes[node_id];
+  if (!route) {
+    route = new NodeRoute;
+  }
+  route->node_id = node_id;
+  route->addr = addr_key(address);
+
+  auto peer = pnet.peers.find(route->addr);
+  route->peer = peer == pnet.peers.end() ? nullptr : peer->second;
+  if (route->peer) return;
+
+  auto hs = pnet.handshakes.find(route->addr);
+  if (hs == pnet.handshakes.end()) {
+    start_handshake(HandshakeRole::Dial, address);
+  } else if (hs->second.role == HandshakeRole::Admit) {
+    // It dialed us before we heard of it, our connection back is all that's
+    // needed
+    hs->second.role = HandshakeRole::Dial;
+    step_handshake(hs->first);
+  }
+}
 
-    auto clusterinfo = message.assign_cluster_info();
-    monad_ref = (EntityRefNode *)make_entity_ref(clusterinfo.monad_node_id(), clusterinfo.monad_vat_id(), clusterinfo.monad_entity_id());
+// Drops the routes to whatever node listened at key, along with the calls
+// batched for it
+static void remove_routes(NetAddr key) {
+  for (auto &route : pnet.routes) {
+    if (!route || route->addr != key) continue;
 
-    this_pleroma_node->node_id = clusterinfo.node_id();
-    printf("Got the following info: our ID %d (%d %d %d)\n", this_pleroma_node->node_id, monad_ref->node_id, monad_ref->vat_id,
-           monad_ref->entity_id);
+    for (auto &batch : route->lanes.batches) {
+      pnet.n_batched -= batch.n_calls;
+    }
+    dbp(log_warning, "Node %d left the cluster", route->node_id);
+    delete route;
+    route = nullptr;
   }
-
-  pnet.peers[std::make_tuple(peer->address.host, peer->address.port)] = peer;
 }
 
-void handle_connection(ENetEvent *event) {
-  dbp(log_debug, "New node connecting...");
-  u32 connect_back_port = event->data;
+static void admit_node(Handshake &hs) {
+  PleromaNode *new_node = new PleromaNode;
+  new_node->resources = hs.resources;
+
+  new_node->node_id = pleroma_nodes_n;
+  new_node->nodeman_addr.node_id = pleroma_nodes_n;
+  new_node->nodeman_addr.vat_id = 0;
+  new_node->nodeman_addr.entity_id = 0;
+  printf("Received nodeman addr: %d %d %d\n", new_node->nodeman_addr.node_id, new_node->nodeman_addr.vat_id, new_node->nodeman_addr.entity_id);
+  add_new_pnode(new_node);
+  pleroma_nodes_n++;
 
-  connect_to_client(mk_netaddr(host32_to_string(event->peer->address.host), connect_back_port));
+  add_route(new_node->node_id, hs.address);
 
   dbp(log_debug, "Sending cluster info...");
-  // TODO insert cluster info into kernel list here + sync over Raft
-  ENetEvent event_in;
-  if (enet_host_service(pnet.server, &event_in, 5000) && event_in.type == ENET_EVENT_TYPE_RECEIVE) {
-    std::string buf = std::string((char *)event_in.packet->data, event_in.packet->dataLength);
-    std::string((char *)event_in.packet->data, event_in.packet->dataLength);
-
-    romabuf::PleromaMessage message;
-    message.ParseFromString(buf);
-    assert(message.has_host_info());
-
-    PleromaNode *new_node = new PleromaNode;
-    for (auto &k : message.host_info().resources()) {
-      new_node->resources.push_back(k);
+  assign_cluster_info_msg(new_node->node_id);
+  announce_new_peer(new_node->node_id);
+}
+
+// Moves a handshake on as far as what has arrived allows, returns true once
+// it is done with
+static bool advance_handshake(Handshake &hs) {
+  if (!hs.out_up) return false;
+
+  switch (hs.role) {
+  case HandshakeRole::Dial:
+    set_peer(addr_key(hs.address), hs.out);
+    return true;
+
+  case HandshakeRole::Join:
+    // The cluster holds on to it until its connection back to us is up
+    if (!hs.sent_host_info) {
+      send_host_info(hs.out);
+      hs.sent_host_info = true;
     }
+    return false;
 
-    new_node->node_id = pleroma_nodes_n;
-    new_node->nodeman_addr.node_id = pleroma_nodes_n;
-    new_node->nodeman_addr.vat_id = 0;
-    new_node->nodeman_addr.entity_id = 0;
-    printf("Received nodeman addr: %d %d %d\n", new_node->nodeman_addr.node_id, new_node->nodeman_addr.vat_id, new_node->nodeman_addr.entity_id);
-    add_new_pnode(new_node);
+  case HandshakeRole::Admit:
+    if (!hs.got_host_info) return false;
+    set_peer(addr_key(hs.address), hs.out);
+    admit_node(hs);
+    return true;
   }
 
-  assign_cluster_info_msg(event->peer->address.host, event->peer->address.port);
+  return false;
+}
+
+static void step_handshake(NetAddr key) {
+  auto found = pnet.handshakes.find(key);
+  if (found != pnet.handshakes.end() && advance_handshake(found->second)) {
+    pnet.handshakes.erase(found);
+  }
+}
+
+static void expire_handshakes() {
+  auto now = std::chrono::steady_clock::now();
+
+  for (auto it = pnet.handshakes.begin(); it != pnet.handshakes.end();) {
+    Handshake &hs = it->second;
+    if (now < hs.deadline) {
+      ++it;
+      continue;
+    }
+
+    if (hs.role == HandshakeRole::Join) {
+      dbp(log_warning, "Timed out joining the cluster, trying again");
+      enet_peer_reset(hs.out);
+      hs.sent_host_info = false;
+      start_handshake(HandshakeRole::Join, hs.address);
+      ++it;
+      continue;
+    }
+
+    if (hs.role == HandshakeRole::Admit && hs.out_up) {
+      // Dialed us without joining, e.g. after a peer announcement, keep the
+      // connection back as a plain peer
+      set_peer(it->first, hs.out);
+    } else {
+      dbp(log_warning, "Timed out connecting to %s:%d", host32_to_string(hs.address.host).c_str(), hs.address.port);
+      enet_peer_reset(hs.out);
+      remove_routes(it->first);
+    }
+    it = pnet.handshakes.erase(it);
+  }
+}
+
+void connect_to_client(ENetAddress address) {
+  dbp(log_debug, "Connecting back to client");
+  start_handshake(HandshakeRole::Dial, address);
+}
+
+void connect_to_cluster(ENetAddress address) {
+  start_handshake(HandshakeRole::Join, address);
+}
+
+bool joined_cluster() {
+  return pnet.joined;
+}
+
+static void on_cluster_info(ENetPeer *peer, const romabuf::AssignClusterInfo &clusterinfo) {
+  auto found = pnet.handshakes.find(addr_key(peer->address));
+  if (found == pnet.handshakes.end() || found->second.role != HandshakeRole::Join) {
+    dbp(log_warning, "Ignoring cluster info we didn't ask for");
+    return;
+  }
+
+  monad_ref = (EntityRefNode *)make_entity_ref(clusterinfo.monad_node_id(), clusterinfo.monad_vat_id(), clusterinfo.monad_entity_id());
+
+  this_pleroma_node->node_id = clusterinfo.node_id();
+  printf("Got the following info: our ID %d (%d %d %d)\n", this_pleroma_node->node_id, monad_ref->node_id, monad_ref->vat_id,
+         monad_ref->entity_id);
+
+  // Only node 0 admits nodes
+  ENetAddress cluster_address = found->second.address;
+  set_peer(found->first, found->second.out);
+  pnet.handshakes.erase(found);
+  add_route(0, cluster_address);
+
+  for (auto &node : clusterinfo.nodes()) {
+    add_route(node.node_id(), mk_netaddr(node.address(), node.port()));
+  }
+
+  pnet.joined = true;
+}
+
+static void on_host_info(ENetPeer *peer, const romabuf::HostInfo &host_info) {
+  auto found = pnet.handshakes.find(addr_key(peer->address));
+  if (found == pnet.handshakes.end() || found->second.role != HandshakeRole::Admit) {
+    dbp(log_warning, "Ignoring host info from a node that isn't joining");
+    return;
+  }
+
+  Handshake &hs = found->second;
+  hs.resources.assign(host_info.resources().begin(), host_info.resources().end());
+  hs.got_host_info = true;
+  step_handshake(found->first);
+}
+
+void handle_connection(ENetEvent *event) {
+  // One of ours coming up
+  for (auto &[hs_key, hs] : pnet.handshakes) {
+    if (hs.out == event->peer) {
+      hs.out_up = true;
+      step_handshake(hs_key);
+      return;
+    }
+  }
+
+  ENetAddress address = event->peer->address;
+  address.port = event->data & NET_CONNECT_PORT_MASK;
+  NetAddr key = addr_key(address);
+  pnet.features[key] = event->data & ~NET_CONNECT_PORT_MASK;
+
+  // The other half of a connection we have or are making
+  if (pnet.handshakes.count(key) || pnet.peers.count(key)) {
+    return;
+  }
+
+  // Someone new, dial back on the port they listen on and wait for them to
+  // say who they are
+  dbp(log_debug, "New node connecting...");
+  start_handshake(HandshakeRole::Admit, address);
+}
+
+void handle_disconnection(ENetEvent *event) {
+  for (auto &[key, hs] : pnet.handshakes) {
+    if (hs.out == event->peer) {
+      // Left for expire_handshakes to retry or give up on
+      hs.out_up = false;
+      return;
+    }
+  }
+
+  for (auto it = pnet.peers.begin(); it != pnet.peers.end(); ++it) {
+    if (it->second == event->peer) {
+      dbp(log_warning, "Lost connection to %s:%d", host32_to_string(std::get<0>(it->first)).c_str(), std::get<1>(it->first));
+      remove_routes(it->first);
+      pnet.peers.erase(it);
+      return;
+    }
+  }
 }
 
 ENetAddress mk_netaddr(std::string ip, u16 port) {
@@ -7,23 +7,25 @@
 #include <queue>
 #include <string>
 
-#include "../other_src/blockingconcurrentqueue.h"
-
 extern moodycamel::ConcurrentQueue<Msg> net_out_queue;
-extern moodycamel::BlockingConcurrentQueue<Vat *> queue;
-extern std::queue<Msg> net_in_queue;
 
 void init_network();
 void net_loop();
 void setup_server(std::string ip, u16 port);
+// Both only start connecting, net_loop does the rest
 void connect_to_client(ENetAddress);
 void connect_to_cluster(ENetAddress);
+// The cluster has assigned us our node id
+bool joined_cluster();
 
 void send_msg(ENetAddress host, romabuf::PleromaMessage msg);
 
 void on_receive_packet(ENetEvent *event);
+Msg call_to_msg(const romabuf::Call &call);
+// Queues the message on its peer's batch
 void send_node_msg(Msg m);
+// Sends batches that are due, or all of them with force
+void flush_batches(bool force);
 void handle_connection(ENetEvent* event);
+void handle_disconnection(ENetEvent *event);
 ENetAddress mk_netaddr(std::string ip, u16 port);
-
-extern moodycamel::ConcurrentQueue<Vat *> net_vats;
@@ -9,6 +9,52 @@
 
 using json = nlohmann::json;
 
+void read_vat_budget(json &budget_config, VatBudget *budget) {
+  if (budget_config.contains("messages")) {
+    budget->messages = budget_config["messages"];
+  }
+
+  if (budget_config.contains("steps")) {
+    budget->steps = budget_config["steps"];
+  }
+}
+
+void read_gc_config(json &gc_config, GcConfig *config) {
+  if (gc_config.contains("nursery")) {
+    config->nursery_bytes = gc_config["nursery"];
+  }
+
+  if (gc_config.contains("old")) {
+    config->old_bytes = gc_config["old"];
+  }
+
+  if (gc_config.contains("incremental")) {
+    config->incremental = gc_config["incremental"];
+  }
+
+  if (gc_config.contains("step")) {
+    config->step_objects = gc_config["step"];
+  }
+}
+
+void read_http_config(json &http_config, HttpConfig *config) {
+  if (http_config.contains("port")) {
+    config->port = http_config["port"];
+  }
+
+  if (http_config.contains("backlog")) {
+    config->backlog = http_config["backlog"];
+  }
+
+  if (http_config.contains("threads")) {
+    config->threads = http_config["threads"];
+  }
+
+  if (http_config.contains("cache_bytes")) {
+    config->cache_bytes = http_config["cache_bytes"];
+  }
+}
+
 PleromaNode *read_node_config(std::string config_path) {
   PleromaNode* pnode = new PleromaNode;
 
@@ -34,6 +80,73 @@ PleromaNode *read_node_config(std::string config_path) {
     pnode->resources.push_back(k);
   }
 
+  if (json_config.contains("burners")) {
+    pnode->n_burners = json_config["burners"];
+  }
+
+  // "vm" (default) or "ast", the tree walker is kept to check the VM against
+  if (json_config.contains("engine")) {
+    std::string engine_name = json_config["engine"];
+    if (engine_name == "vm") {
+      pnode->engine = ExecEngine::Vm;
+    } else if (engine_name == "ast") {
+      pnode->engine = ExecEngine::Ast;
+    } else {
+      throw PleromaException(("Unknown engine: " + engine_name).c_str());
+    }
+  }
+
+  // "protobuf" (default) or "binary" for calls sent to other nodes, both are
+  // always understood on receive
+  if (json_config.contains("wire")) {
+    std::string wire_name = json_config["wire"];
+    if (wire_name == "protobuf") {
+      pnode->wire_format = WireFormat::Protobuf;
+    } else if (wire_name == "binary") {
+      pnode->wire_format = WireFormat::Binary;
+    } else {
+      throw PleromaException(("Unknown wire format: " + wire_name).c_str());
+    }
+  }
+
+  // Per-dispatch budgets for system and user vats
+  if (json_config.contains("budgets")) {
+    if (json_config["budgets"].contains("system")) {
+      read_vat_budget(json_config["budgets"]["system"], &pnode->system_budget);
+    }
+
+    if (json_config["budgets"].contains("user")) {
+      read_vat_budget(json_config["budgets"]["user"], &pnode->user_budget);
+    }
+  }
+
+  // Where to keep this node's counters, see node_stats.h
+  if (json_config.contains("stats")) {
+    pnode->stats_path = json_config["stats"];
+  }
+
+  // Smallest packet worth compressing, 0 turns compression off
+  if (json_config.contains("compress_min_bytes")) {
+    pnode->compress_min_bytes = json_config["compress_min_bytes"];
+  }
+
+  // Selectors whose calls may be dropped on the way to another node, in
+  // exchange for never waiting on anything else sent there
+  if (json_config.contains("telemetry")) {
+    for (auto &k : json_config["telemetry"]) {
+      pnode->telemetry_selectors.insert(intern_selector(k));
+    }
+  }
+
+  // Heap sizes in bytes, shared by every vat on the node
+  if (json_config.contains("gc")) {
+    read_gc_config(json_config["gc"], &pnode->gc_config);
+  }
+
+  if (json_config.contains("http")) {
+    read_http_config(json_config["http"], &pnode->http_config);
+  }
+
   std::string debug_str = "Node configured (" + config_path + "):\n";
   debug_str += "\tNode name: " + pnode->node_name + "\n";
   debug_str += "\tResources:\n";
@@ -42,6 +155,43 @@ PleromaNode *read_node_config(std::string config_path) {
     debug_str += "\t\t- " + k + "\n";
   }
 
+  if (pnode->n_burners > 0) {
+    debug_str += "\tBurners: " + std::to_string(pnode->n_burners) + "\n";
+  } else {
+    debug_str += "\tBurners: all hardware threads\n";
+  }
+
+  debug_str += std::string("\tEngine: ") + (pnode->engine == ExecEngine::Vm ? "vm" : "ast") + "\n";
+  debug_str += std::string("\tWire format: ") + (pnode->wire_format == WireFormat::Binary ? "binary" : "protobuf") + "\n";
+  if (pnode->compress_min_bytes > 0) {
+    debug_str += "\tCompression: packets of " + std::to_string(pnode->compress_min_bytes) + " bytes and up\n";
+  } else {
+    debug_str += "\tCompression: off\n";
+  }
+  if (!pnode->telemetry_selectors.empty()) {
+    debug_str += "\tTelemetry:";
+    for (auto sel : pnode->telemetry_selectors) {
+      debug_str += " " + selector_name(sel);
+    }
+    debug_str += "\n";
+  }
+  debug_str += "\tSystem vat budget: " + std::to_string(pnode->system_budget.messages) + " messages, " + std::to_string(pnode->system_budget.steps) + " steps\n";
+  debug_str += "\tUser vat budget: " + std::to_string(pnode->user_budget.messages) + " messages, " + std::to_string(pnode->user_budget.steps) + " steps\n";
+
+  debug_str += "\tGC: " + std::to_string(pnode->gc_config.nursery_bytes) + " byte nursery, " + std::to_string(pnode->gc_config.old_bytes) + " byte old generation";
+  if (pnode->gc_config.incremental) {
+    debug_str += ", incremental (" + std::to_string(pnode->gc_config.step_objects) + " objects a step)";
+  }
+  debug_str += "\n";
+
+  debug_str += "\tHTTP: port " + std::to_string(pnode->http_config.port) + ", backlog " + std::to_string(pnode->http_config.backlog) + ", ";
+  if (pnode->http_config.threads > 0) {
+    debug_str += std::to_string(pnode->http_config.threads) + " threads\n";
+  } else {
+    debug_str += "a thread per burner\n";
+  }
+  debug_str += "\tHTTP cache: " + std::to_string(pnode->http_config.cache_bytes) + " bytes\n";
+
   dbp(log_debug, debug_str.c_str());
 
   return pnode;
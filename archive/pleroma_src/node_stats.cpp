@@ -0,0 +1,26 @@
+#include "node_stats.h"
+#include <chrono>
+
+int call_rtt_bucket(u64 us) {
+  if (us < 4) return us;
+
+  int log = 63 - __builtin_clzll(us);
+  int bucket = 4 * (log - 1) + ((us >> (log - 2)) & 3);
+  return bucket < CALL_RTT_BUCKETS ? bucket : CALL_RTT_BUCKETS - 1;
+}
+
+u64 call_rtt_bucket_floor(int bucket) {
+  if (bucket < 4) return bucket;
+
+  int log = bucket / 4 + 1;
+  return (u64)(4 + bucket % 4) << (log - 2);
+}
+
+u64 steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record_call_rtt(PleromaNode *node, u64 sent_ns) {
+  u64 us = (steady_ns() - sent_ns) / 1000;
+  node->call_stats.rtt_histogram[call_rtt_bucket(us)].fetch_add(1, std::memory_order_relaxed);
+}
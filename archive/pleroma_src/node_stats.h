@@ -0,0 +1,18 @@
+#pragma once
+
+#include "common.h"
+#include "hylic_eval.h"
+
+// Counters a benchmark or monitor reads without scraping the log.  With
+// "stats" set in the node config, net_loop writes them to that path as JSON
+// about once a second while they change, replacing the file each time.
+
+// Buckets 0-3 hold that many microseconds, past that every power of two is
+// split in four
+int call_rtt_bucket(u64 us);
+// Shortest round trip that lands in the bucket
+u64 call_rtt_bucket_floor(int bucket);
+
+u64 steady_ns();
+// A response arrived for a call that left at sent_ns
+void record_call_rtt(PleromaNode *node, u64 sent_ns);
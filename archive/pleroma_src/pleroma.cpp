@@ -5,6 +5,7 @@
 #include "hylic_eval.h"
 #include "gc.h"
 #include <chrono>
+#include <filesystem>
 #include <locale>
 #include <map>
 #include <queue>
@@ -16,28 +17,24 @@
 
 #include <thread>
 
-#include "hylic_compiler.h"
+#include "difftest.h"
+#include "wirebench.h"
 #include "hylic_typesolver.h"
 #include "netcode.h"
 #include "core/kernel.h"
-#include "../other_src/blockingconcurrentqueue.h"
 #include "node_config.h"
+#include "node_stats.h"
 #include "args.h"
 
 #include "hosted_irq.h"
+#include "scheduler.h"
 
 #include "other.h"
 #include "system.h"
 
-//const auto processor_count = std::thread::hardware_concurrency();
-const auto processor_count = 1;
-const int MAX_STEPS = 3;
-
 PleromaNode *this_pleroma_node;
 
-moodycamel::BlockingConcurrentQueue<Vat*> queue;
-
-Msg create_response(Msg msg_in, AstNode *return_val) {
+Msg create_response(Msg msg_in, Value return_val) {
   Msg response_m;
   response_m.response = true;
 
@@ -50,121 +47,136 @@ Msg create_response(Msg msg_in, AstNode *return_val) {
   response_m.src_node_id = msg_in.node_id;
   response_m.promise_id = msg_in.promise_id;
 
-  response_m.function_name = msg_in.function_name;
+  response_m.selector = msg_in.selector;
 
-  if (in(return_val->type, {AstNodeType::NumberNode, AstNodeType::StringNode, AstNodeType::EntityRefNode, AstNodeType::ListNode})) {
-    response_m.values.push_back((ValueNode *)return_val);
+  if (in(value_node_type(return_val), {AstNodeType::NumberNode, AstNodeType::BooleanNode, AstNodeType::StringNode, AstNodeType::EntityRefNode, AstNodeType::ListNode})) {
+    response_m.values.push_back(return_val);
   } else {
-    panic("Unhandled response value : " + ast_type_to_string(return_val->type));
+    panic("Unhandled response value : " + ast_type_to_string(value_node_type(return_val)));
   }
 
   return response_m;
 }
 
-void process_vq() {
-  while (true) {
-    Vat* our_vat;
-    queue.wait_dequeue(our_vat);
+void process_vq(int burner_id) {
+  bind_burner(burner_id);
 
-    our_vat->cycle_since_gc += 1;
+  const Selector main_sel = intern_selector("main");
 
-    if (our_vat->cycle_since_gc > 500) {
-      run_gc(our_vat);
-      our_vat->cycle_since_gc = 0;
-    }
+  while (Vat *our_vat = next_vat()) {
+    // A vat is only ever queued once, so no other burner can be inside it
+    bool already_running = our_vat->running.exchange(true);
+    assert(!already_running);
 
-    // Take a number of steps
-    for (int k = 0; k < 1; ++k) {
+    // Everything made while running the vat comes out of its allocator
+    AllocatorScope vat_scope(our_vat->allocator);
 
-      while (!our_vat->messages.empty()) {
-        Msg m = our_vat->messages.front();
-        our_vat->messages.pop();
-        print_msg(&m);
+    gc_safepoint(our_vat);
 
-        try {
-          auto find_entity = our_vat->entities.find(m.entity_id);
-          assert(find_entity != our_vat->entities.end());
-          Entity* target_entity = find_entity->second;
-
-          EvalContext context;
-          start_context(&context, this_pleroma_node, our_vat, target_entity->entity_def->module, target_entity);
-
-          // Return vs call
-          if (m.response) {
-            // If we didn't setup a promise to resolve, then ignore the result
-            if (our_vat->promises.find(m.promise_id) != our_vat->promises.end()) {
-              our_vat->promises[m.promise_id].results = m.values;
-              our_vat->promises[m.promise_id].resolved = true;
-              if (our_vat->promises[m.promise_id].callbacks.size() > 0 || our_vat->promises[m.promise_id].dependents.size() > 0) {
-                eval_promise_local(&context, our_vat->entities.find(m.entity_id)->second, &our_vat->promises[m.promise_id], m.promise_id);
-              }
-
-              if (our_vat->promises[m.promise_id].return_msg) {
-                Msg response_m = create_response(our_vat->promises[m.promise_id].msg, our_vat->promises[m.promise_id].results[0]);
-                if (m.function_name != "main") {
-                  auto ref_res = our_vat->promises[m.promise_id].results[0];
-                  our_vat->out_messages.push(response_m);
-                }
-              }
+    // Run messages until the vat runs out of budget, whatever is left waits
+    // for the next dispatch so one busy vat can't starve the others
+    int n_dispatched = 0;
+    u64 n_steps = 0;
 
-              // Get return value here, check if we return a promise node, if we do then we need to connect the two
+    while (n_dispatched < our_vat->budget.messages && n_steps < our_vat->budget.steps) {
+      Msg m;
+      if (!our_vat->messages.pop(&m)) {
+        break;
+      }
+      import_msg(our_vat, m);
+      print_msg(&m);
+
+      try {
+        auto find_entity = our_vat->entities.find(m.entity_id);
+        assert(find_entity != our_vat->entities.end());
+        Entity* target_entity = find_entity->second;
+
+        EvalContext context;
+        start_context(&context, this_pleroma_node, our_vat, target_entity->entity_def->module, target_entity);
+
+        // Return vs call
+        if (m.response) {
+          // If we didn't setup a promise to resolve, or it was already
+          // resolved and released, then ignore the result
+          if (PromiseResult *prom = our_vat->promises.find(m.promise_id)) {
+            if (prom->sent_ns) {
+              record_call_rtt(this_pleroma_node, prom->sent_ns);
             }
-          } else {
-            std::vector<AstNode *> args;
-
-            for (int zz = 0; zz < m.values.size(); ++zz) {
-              args.push_back(m.values[zz]);
+            prom->results = m.values;
+            prom->resolved = true;
+            if (prom->callbacks.size() > 0 || prom->dependents.size() > 0) {
+              eval_promise_local(&context, target_entity, prom, m.promise_id);
             }
 
-            //printf("Got message with func %s\n", m.function_name.c_str());
-            // If the result is a promise, setup promise with callback being the real return, and don't send message
-            auto result = eval_func_local(&context, target_entity, m.function_name, args);
-            //print_msg(&m);
-            //printf("%s\n", ast_type_to_string(result->type).c_str());
-            if (result->type == AstNodeType::PromiseNode) {
-              PromiseNode* prom = (PromiseNode*) result;
-              our_vat->promises[prom->promise_id].return_msg = true;
-              our_vat->promises[prom->promise_id].msg = m;
-            } else {
-              // All return values are singular - we use tuples to represent
-              // multiple return values
-              // FIXME might not work if we handle tuples differently
-              Msg response_m = create_response(m, result);
-
-              // Main cannot be called by any function except ours, move this logic into typechecker
-              if (m.function_name != "main") {
-                our_vat->out_messages.push(response_m);
+            if (prom->return_msg) {
+              Msg response_m = create_response(*prom->return_msg, prom->results[0]);
+              if (m.selector != main_sel) {
+                our_vat->out_messages.push_back(response_m);
               }
             }
+
+            release_promise(our_vat, m.promise_id);
+          }
+        } else {
+          // If the result is a promise, setup promise with callback being the real return, and don't send message
+          auto result = eval_func_local(&context, target_entity, m.selector, m.values);
+          //print_msg(&m);
+          if (result.tag == ValueTag::Promise) {
+            PromiseResult *prom = our_vat->promises.find(result.promise_id);
+            assert(prom);
+            prom->return_msg = vat_new<Msg>(our_vat->allocator, m);
+          } else {
+            // All return values are singular - we use tuples to represent
+            // multiple return values
+            // FIXME might not work if we handle tuples differently
+            Msg response_m = create_response(m, result);
+
+            // Main cannot be called by any function except ours, move this logic into typechecker
+            if (m.selector != main_sel) {
+              our_vat->out_messages.push_back(response_m);
+            }
           }
-        } catch (PleromaException &e) {
-          printf("PleromaException: %s\n", e.what());
-          printf("Calling message: \n");
-          print_msg(&m);
-          throw;
         }
-      }
 
-      while (!our_vat->out_messages.empty()) {
-        Msg m = our_vat->out_messages.front();
-        our_vat->out_messages.pop();
-        //print_msg(&m);
+        n_steps += context.steps;
+        n_dispatched++;
+      } catch (PleromaException &e) {
+        printf("PleromaException: %s\n", e.what());
+        printf("Calling message: \n");
+        print_msg(&m);
+        throw;
+      }
+    }
 
-        // If we're communicating on the same node, we don't have to use the router
-        if (m.node_id == this_pleroma_node->node_id && m.vat_id == our_vat->id) {
-          our_vat->messages.push(m);
+    while (!our_vat->out_messages.empty()) {
+      Msg m = our_vat->out_messages.front();
+      our_vat->out_messages.pop_front();
+      export_msg(m);
+      //print_msg(&m);
+
+      // Messages for this node go straight into the target's mailbox from
+      // the burner, only other nodes' traffic goes through the net thread
+      if (m.node_id == this_pleroma_node->node_id) {
+        if (m.vat_id == our_vat->id) {
+          deliver_msg(our_vat, std::move(m));
         } else {
-          net_out_queue.enqueue(m);
+          deliver_local_msg(std::move(m));
+        }
+      } else {
+        if (!m.response) {
+          if (PromiseResult *prom = our_vat->promises.find(m.promise_id)) {
+            prom->sent_ns = steady_ns();
+          }
         }
+        net_out_queue.enqueue(std::move(m));
       }
-
-      //sleep(1);
-
-      our_vat->run_n++;
     }
 
-    net_vats.enqueue(our_vat);
+    //sleep(1);
 
+    our_vat->run_n++;
+
+    finish_dispatch(our_vat, n_dispatched);
   }
 }
 
@@ -173,10 +185,14 @@ void start_program(std::string program_name, std::string ent_name) {
   m.node_id = monad_ref->node_id;
   m.vat_id = monad_ref->vat_id;
   m.entity_id = monad_ref->entity_id;
-  m.function_name = "start-program";
+  m.selector = intern_selector("start-program");
 
-  m.values.push_back((StringNode*)make_string(program_name));
-  m.values.push_back((StringNode *)make_string(ent_name));
+  // Owned by the message, see export_msg
+  for (auto name : {program_name, ent_name}) {
+    auto name_node = make_string(name);
+    name_node->gc_gen = GcGen::Exported;
+    m.values.push_back(node_value(name_node));
+  }
 
   m.src_entity_id = -1;
   m.src_node_id = -1;
@@ -190,10 +206,9 @@ void inoculate_pleroma(HylicModule *ukernel, std::string ent0) {
 
   EntityDef *ent0_def = (EntityDef *)ukernel->entity_defs[ent0];
 
-  Vat* og_vat = new Vat;
-  og_vat->id = 0;
-  queue.enqueue(og_vat);
-  this_pleroma_node->vat_id_base++;
+  Vat *og_vat = create_vat(this_pleroma_node, VatPriority::System);
+  assert(og_vat->id == 0);
+  AllocatorScope vat_scope(og_vat->allocator);
 
   EvalContext context;
   start_context(&context, this_pleroma_node, og_vat, ukernel, nullptr);
@@ -208,7 +223,7 @@ void inoculate_pleroma(HylicModule *ukernel, std::string ent0) {
 
   Msg m;
   m.entity_id = 0;
-  m.function_name = "hello";
+  m.selector = intern_selector("hello");
   m.node_id = 0;
 
   m.src_entity_id = -1;
@@ -216,19 +231,17 @@ void inoculate_pleroma(HylicModule *ukernel, std::string ent0) {
   m.src_vat_id = -1;
   m.promise_id = -1;
 
-  m.values.push_back((ValueNode *)make_number(0));
+  m.values.push_back(number_value(0));
 
-  og_vat->messages.push(m);
+  deliver_msg(og_vat, m);
 }
 
 EntityAddress start_system_program(HylicModule *ukernel, std::string ent0) {
 
   EntityDef *ent0_def = (EntityDef *)ukernel->entity_defs[ent0];
 
-  Vat *og_vat = new Vat;
-  og_vat->id = this_pleroma_node->vat_id_base;
-  queue.enqueue(og_vat);
-  this_pleroma_node->vat_id_base++;
+  Vat *og_vat = create_vat(this_pleroma_node, VatPriority::System);
+  AllocatorScope vat_scope(og_vat->allocator);
 
   EvalContext context;
   start_context(&context, this_pleroma_node, og_vat, ukernel, nullptr);
@@ -237,10 +250,20 @@ EntityAddress start_system_program(HylicModule *ukernel, std::string ent0) {
   ent->module_scope = ukernel;
 
   og_vat->entities[0] = ent;
+  wake_vat(og_vat);
 
   return ent->address;
 }
 
+int burner_count(PleromaNode *node) {
+  if (node->n_burners > 0) {
+    return node->n_burners;
+  }
+
+  int hw_threads = std::thread::hardware_concurrency();
+  return hw_threads > 0 ? hw_threads : 1;
+}
+
 struct ConnectionInfo {
   std::string host_ip;
   int host_port;
@@ -255,6 +278,8 @@ void start_pleroma(PleromaArgs pleroma_args) {
   this_pleroma_node = read_node_config(pleroma_args.config_path);
   add_new_pnode(this_pleroma_node);
 
+  init_scheduler(burner_count(this_pleroma_node));
+
   load_kernel();
 
   auto monad_mod = load_system_module(SystemModule::Monad);
@@ -274,21 +299,31 @@ void start_pleroma(PleromaArgs pleroma_args) {
   if (pleroma_args.remote_hostname != "") {
     dbp(log_info, "Connecting to network [%s : %d]...", pleroma_args.remote_hostname.c_str(), pleroma_args.remote_port);
     connect_to_cluster(mk_netaddr(pleroma_args.remote_hostname, pleroma_args.remote_port));
+    // Nothing here can start before the cluster gives us our node id
+    while (!joined_cluster()) {
+      net_loop();
+    }
     dbp(log_info, "Successfully connected");
   }
 
   auto ent_add = start_system_program(monad_mod, "NodeMan");
   this_pleroma_node->nodeman_addr = ent_add;
 
-  load_software();
+  // Programs are named after their file, and every node has to load the
+  // same ones since vats are created wherever the Monad places them
+  std::string program_name = std::filesystem::path(pleroma_args.program_path).stem();
+  load_software(program_name, pleroma_args.program_path);
 
-  start_program("helloworld", "UserProgram");
+  if (pleroma_args.entity_name != "none") {
+    start_program(program_name, pleroma_args.entity_name);
+  }
 
-  std::thread burners[processor_count];
+  int n_burners = burner_count(this_pleroma_node);
+  std::vector<std::thread> burners;
 
-  dbp(log_debug, "Starting %d burner processes...", processor_count);
-  for (int k = 0; k < processor_count; ++k) {
-    burners[k] = std::thread(process_vq);
+  dbp(log_debug, "Starting %d burner processes...", n_burners);
+  for (int k = 0; k < n_burners; ++k) {
+    burners.push_back(std::thread(process_vq, k));
   }
 
   std::thread hosted_irq(loop_keyboard);
@@ -299,8 +334,9 @@ void start_pleroma(PleromaArgs pleroma_args) {
   }
 
   dbp(log_debug, "Net loop finished, joining all processes");
-  for (int k = 0; k < processor_count; ++k) {
-    burners[k].join();
+  stop_scheduler();
+  for (auto &burner : burners) {
+    burner.join();
   }
 
   dbp(log_info, "Burners joined, exiting.");
@@ -308,8 +344,6 @@ void start_pleroma(PleromaArgs pleroma_args) {
 
 int main(int argc, char **argv) {
   setlocale(LC_ALL, "");
-  printf("compiling.\n");
-  compile({});
 
   PleromaArgs pargs = parse_args(argc, argv);
 
@@ -337,6 +371,11 @@ int main(int argc, char **argv) {
     std::string target_file = argv[2];
     load_file("test", target_file);
     exit(0);
+  } else if (pargs.command == PCommand::DiffTest) {
+    std::string target_file = argv[2];
+    exit(run_difftest(target_file) == 0 ? 0 : 1);
+  } else if (pargs.command == PCommand::WireBench) {
+    exit(run_wirebench() == 0 ? 0 : 1);
   } else {
     exit(1);
   }
@@ -0,0 +1,207 @@
+#include "scheduler.h"
+#include "general_util.h"
+#include <cassert>
+#include <thread>
+
+VatScheduler scheduler;
+
+struct VatTableChunk {
+  std::atomic<Vat *> vats[VAT_TABLE_CHUNK];
+};
+
+std::atomic<VatTableChunk *> vat_table[VAT_TABLE_CHUNKS];
+// Only taken to add a chunk
+std::mutex vat_table_mtx;
+
+thread_local int burner_id = -1;
+
+void init_scheduler(int n_burners) {
+  assert(n_burners > 0);
+  for (int k = 0; k < n_burners; ++k) {
+    scheduler.burners.push_back(new BurnerQueue);
+  }
+}
+
+int scheduler_burner_count() {
+  return scheduler.burners.size();
+}
+
+void bind_burner(int id) {
+  assert(id >= 0 && (size_t)id < scheduler.burners.size());
+  burner_id = id;
+}
+
+int current_burner_id() {
+  return burner_id;
+}
+
+void schedule_vat(Vat *vat) {
+  int lane = (int)vat->priority;
+
+  if (burner_id >= 0) {
+    // Keep the vat on the burner that woke it, its messages are likely still in cache
+    BurnerQueue *local = scheduler.burners[burner_id];
+    std::lock_guard<std::mutex> lock(local->mtx);
+    local->vats.lanes[lane].push_back(vat);
+  } else {
+    std::lock_guard<std::mutex> lock(scheduler.inject_mtx);
+    scheduler.injected.lanes[lane].push_back(vat);
+  }
+
+  scheduler.work_available.signal();
+}
+
+Vat *pop_front(VatLanes *vl, int lane) {
+  if (vl->lanes[lane].empty()) return nullptr;
+
+  Vat *vat = vl->lanes[lane].front();
+  vl->lanes[lane].pop_front();
+  return vat;
+}
+
+Vat *pop_back(VatLanes *vl, int lane) {
+  if (vl->lanes[lane].empty()) return nullptr;
+
+  Vat *vat = vl->lanes[lane].back();
+  vl->lanes[lane].pop_back();
+  return vat;
+}
+
+Vat *take_local(BurnerQueue *bq, int lane) {
+  std::lock_guard<std::mutex> lock(bq->mtx);
+  return pop_front(&bq->vats, lane);
+}
+
+Vat *take_injected(int lane) {
+  std::lock_guard<std::mutex> lock(scheduler.inject_mtx);
+  return pop_front(&scheduler.injected, lane);
+}
+
+Vat *steal(int thief_id, int lane) {
+  int n_burners = scheduler.burners.size();
+
+  for (int k = 1; k < n_burners; ++k) {
+    BurnerQueue *victim = scheduler.burners[(thief_id + k) % n_burners];
+
+    // Don't fight the owner for its lock, move on to the next victim
+    std::unique_lock<std::mutex> lock(victim->mtx, std::try_to_lock);
+    if (!lock.owns_lock()) continue;
+
+    if (Vat *vat = pop_back(&victim->vats, lane)) return vat;
+  }
+
+  return nullptr;
+}
+
+Vat *next_vat() {
+  assert(burner_id >= 0);
+
+  scheduler.work_available.wait();
+
+  // Holding a count guarantees a vat is queued somewhere, we may just have to
+  // race other burners for it
+  while (scheduler.running) {
+    for (int lane = 0; lane < N_PRIORITIES; ++lane) {
+      if (Vat *vat = take_local(scheduler.burners[burner_id], lane)) return vat;
+      if (Vat *vat = take_injected(lane)) return vat;
+      if (Vat *vat = steal(burner_id, lane)) return vat;
+    }
+
+    std::this_thread::yield();
+  }
+
+  return nullptr;
+}
+
+void register_vat(Vat *vat) {
+  assert(vat->id >= 0 && vat->id < VAT_TABLE_CHUNK * VAT_TABLE_CHUNKS);
+
+  int chunk_idx = vat->id / VAT_TABLE_CHUNK;
+  VatTableChunk *chunk = vat_table[chunk_idx];
+
+  if (!chunk) {
+    std::lock_guard<std::mutex> lock(vat_table_mtx);
+    chunk = vat_table[chunk_idx];
+    if (!chunk) {
+      chunk = new VatTableChunk();
+      vat_table[chunk_idx] = chunk;
+    }
+  }
+
+  chunk->vats[vat->id % VAT_TABLE_CHUNK] = vat;
+}
+
+Vat *find_vat(int vat_id) {
+  if (vat_id < 0 || vat_id >= VAT_TABLE_CHUNK * VAT_TABLE_CHUNKS) return nullptr;
+
+  VatTableChunk *chunk = vat_table[vat_id / VAT_TABLE_CHUNK];
+  if (!chunk) return nullptr;
+
+  return chunk->vats[vat_id % VAT_TABLE_CHUNK];
+}
+
+// n_pending counts pushes minus what a burner has consumed.  Only the push that
+// takes it from 0 queues the vat, and the burner only requeues it if the count
+// is still positive once it is done, so a vat is never queued twice and idle
+// vats are never queued at all.  The count can dip below zero when a burner
+// pops a message before its sender has counted it, that evens out as soon as
+// the sender catches up.
+void deliver_msg(Vat *vat, Msg m) {
+  vat->messages.push(std::move(m));
+
+  if (vat->n_pending.fetch_add(1) == 0) {
+    schedule_vat(vat);
+  }
+}
+
+static std::atomic<NativeMailbox> native_mailboxes[N_NATIVE_MAILBOXES];
+
+static bool is_native_mailbox(int vat_id) { return vat_id <= -2 && vat_id > -2 - N_NATIVE_MAILBOXES; }
+
+void set_native_mailbox(int vat_id, NativeMailbox mailbox) {
+  assert(is_native_mailbox(vat_id));
+  native_mailboxes[-2 - vat_id].store(mailbox);
+}
+
+void deliver_local_msg(Msg m) {
+  if (is_native_mailbox(m.vat_id)) {
+    if (NativeMailbox mailbox = native_mailboxes[-2 - m.vat_id].load()) {
+      mailbox(std::move(m));
+      return;
+    }
+  }
+
+  Vat *vat = find_vat(m.vat_id);
+
+  if (!vat) {
+    dbp(log_warning, "Dropping message %s for unknown vat %d", selector_name(m.selector).c_str(), m.vat_id);
+    return;
+  }
+
+  deliver_msg(vat, std::move(m));
+}
+
+void wake_vat(Vat *vat) {
+  vat->n_wakeups++;
+
+  if (vat->n_pending.fetch_add(1) == 0) {
+    schedule_vat(vat);
+  }
+}
+
+void finish_dispatch(Vat *vat, int n_dispatched) {
+  int n_consumed = n_dispatched + vat->n_wakeups.exchange(0);
+
+  // Must be cleared before the count drops, a sender may requeue the vat the
+  // moment it does
+  vat->running = false;
+
+  if (vat->n_pending.fetch_sub(n_consumed) - n_consumed > 0) {
+    schedule_vat(vat);
+  }
+}
+
+void stop_scheduler() {
+  scheduler.running = false;
+  scheduler.work_available.signal(scheduler.burners.size());
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "hylic_eval.h"
+#include "../other_src/concurrentqueue.h"
+#include "../other_src/lightweightsemaphore.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+const int N_PRIORITIES = 2;
+
+// Vat ids are handed out densely, the registry grows a chunk at a time
+const int VAT_TABLE_CHUNK = 1024;
+const int VAT_TABLE_CHUNKS = 1024;
+
+// Runnable vats, one deque per VatPriority.  System vats always go first.
+struct VatLanes {
+  std::deque<Vat *> lanes[N_PRIORITIES];
+};
+
+// Each burner owns a set of runnable vats.  The owner takes from the front,
+// idle burners steal from the back of someone else's deque.
+struct BurnerQueue {
+  std::mutex mtx;
+  VatLanes vats;
+};
+
+struct VatScheduler {
+  std::vector<BurnerQueue *> burners;
+
+  // Vats scheduled from threads that aren't burners (net loop, startup)
+  std::mutex inject_mtx;
+  VatLanes injected;
+
+  // One count per scheduled vat, a burner takes a count before taking a vat
+  moodycamel::LightweightSemaphore work_available;
+
+  std::atomic<bool> running{true};
+};
+
+void init_scheduler(int n_burners);
+int scheduler_burner_count();
+
+// Called once at the start of each burner thread
+void bind_burner(int burner_id);
+// Id of the burner running on this thread, -1 if not a burner
+int current_burner_id();
+
+void schedule_vat(Vat *vat);
+
+// Id -> vat lookup for delivery, lock-free to read
+void register_vat(Vat *vat);
+Vat *find_vat(int vat_id);
+
+// Puts a message in the vat's mailbox, queueing the vat if it was idle
+void deliver_msg(Vat *vat, Msg m);
+// Delivers to a vat on this node by the message's vat id
+void deliver_local_msg(Msg m);
+
+// Vat ids from -2 down aren't vats but native code on this node taking
+// messages, answers to the HTTP server for one.  The mailbox is called on
+// whichever thread delivers, with the message's values still exported.
+typedef void (*NativeMailbox)(Msg &&m);
+const int N_NATIVE_MAILBOXES = 4;
+void set_native_mailbox(int vat_id, NativeMailbox mailbox);
+// Runs the vat once even with an empty mailbox, to flush work queued outside a dispatch
+void wake_vat(Vat *vat);
+// Called by the burner when it is done with a vat, requeues it if more work arrived
+void finish_dispatch(Vat *vat, int n_dispatched);
+
+// Blocks until a vat is runnable, returns nullptr on shutdown
+Vat *next_vat();
+
+void stop_scheduler();
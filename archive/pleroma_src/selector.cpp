@@ -0,0 +1,51 @@
+#include "selector.h"
+#include <cassert>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+struct SelectorTable {
+  std::shared_mutex mtx;
+  std::unordered_map<std::string, Selector> ids;
+  // Selector -> name, a deque so growing it never moves existing names
+  std::deque<std::string> names;
+
+  SelectorTable() {
+    ids[""] = NO_SELECTOR;
+    names.push_back("");
+  }
+};
+
+// Function-local so interning from other static initializers is safe
+SelectorTable &selector_table() {
+  static SelectorTable table;
+  return table;
+}
+
+Selector intern_selector(const std::string &name) {
+  SelectorTable &table = selector_table();
+
+  {
+    std::shared_lock<std::shared_mutex> lock(table.mtx);
+    auto found = table.ids.find(name);
+    if (found != table.ids.end()) return found->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(table.mtx);
+  auto found = table.ids.find(name);
+  if (found != table.ids.end()) return found->second;
+
+  Selector sel = table.names.size();
+  table.ids[name] = sel;
+  table.names.push_back(name);
+  return sel;
+}
+
+std::string selector_name(Selector sel) {
+  SelectorTable &table = selector_table();
+
+  std::shared_lock<std::shared_mutex> lock(table.mtx);
+  assert(sel < table.names.size());
+  return table.names[sel];
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "common.h"
+#include <string>
+
+// Function names interned into small dense ids, so messages and dispatch never
+// copy or compare strings.  Ids are local to this node, the wire carries names.
+typedef u32 Selector;
+
+// The empty name, used for frames that aren't a function body
+const Selector NO_SELECTOR = 0;
+
+// Safe to call from any thread
+Selector intern_selector(const std::string &name);
+std::string selector_name(Selector sel);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "common.h"
+#include <cassert>
+#include <vector>
+
+// Table of records addressed by a handle that packs a slot index and the
+// slot's generation.  Slots live in fixed size chunks so records never move,
+// freed slots are reused newest first and bump their generation, so a handle
+// to an erased record finds nothing instead of whatever took its slot.
+// Handles are never negative, -1 stays free to mean "none".
+template <class T>
+struct SlabTable {
+  static const int INDEX_BITS = 22;
+  static const int INDEX_MASK = (1 << INDEX_BITS) - 1;
+  static const int GENERATION_MASK = (1 << (31 - INDEX_BITS)) - 1;
+  static const int CHUNK_SIZE = 1024;
+
+  struct Slot {
+    T value;
+    int generation = 0;
+    bool live = false;
+    int next_free = -1;
+  };
+
+  std::vector<Slot *> chunks;
+  int n_slots = 0;
+  int n_live = 0;
+  int free_head = -1;
+
+  SlabTable() = default;
+  SlabTable(const SlabTable &) = delete;
+  SlabTable &operator=(const SlabTable &) = delete;
+
+  ~SlabTable() {
+    for (auto chunk : chunks) {
+      delete[] chunk;
+    }
+  }
+
+  Slot &slot(int index) {
+    return chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+  }
+
+  // Makes a fresh record and returns its handle
+  int insert() {
+    int index = free_head;
+    if (index != -1) {
+      free_head = slot(index).next_free;
+    } else {
+      // More than this many live at once and handles would collide
+      assert(n_slots <= INDEX_MASK);
+      if (n_slots % CHUNK_SIZE == 0) {
+        chunks.push_back(new Slot[CHUNK_SIZE]);
+      }
+      index = n_slots++;
+    }
+
+    Slot &s = slot(index);
+    s.live = true;
+    n_live++;
+    return (s.generation << INDEX_BITS) | index;
+  }
+
+  // nullptr for handles that were never handed out or have been erased
+  T *find(int handle) {
+    if (handle < 0) return nullptr;
+
+    int index = handle & INDEX_MASK;
+    if (index >= n_slots) return nullptr;
+
+    Slot &s = slot(index);
+    if (!s.live || s.generation != (handle >> INDEX_BITS)) return nullptr;
+    return &s.value;
+  }
+
+  void erase(int handle) {
+    assert(find(handle));
+
+    int index = handle & INDEX_MASK;
+    Slot &s = slot(index);
+    // Drops whatever the record held on the heap, the slot itself is reused
+    s.value = T();
+    s.live = false;
+    s.generation = (s.generation + 1) & GENERATION_MASK;
+    s.next_free = free_head;
+    free_head = index;
+    n_live--;
+  }
+
+  int size() const {
+    return n_live;
+  }
+
+  // f(handle, record) for every live record
+  template <class F>
+  void for_each(F f) {
+    for (int index = 0; index < n_slots; ++index) {
+      Slot &s = slot(index);
+      if (s.live) {
+        f((s.generation << INDEX_BITS) | index, s.value);
+      }
+    }
+  }
+};
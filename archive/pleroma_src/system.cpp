@@ -1,6 +1,8 @@
 #include "system.h"
 #include "hylic.h"
 #include "hylic_ast.h"
+#include "hylic_compiler.h"
+#include "hylic_resolver.h"
 #include "hylic_typesolver.h"
 #include "core/kernel.h"
 #include "other.h"
@@ -35,6 +37,7 @@ SystemModule system_import_to_enum(std::string str) {
 
 HylicModule *load_system_module(SystemModule mod) {
   HylicModule *program;
+  AllocatorScope program_scope(nullptr);
 
   TokenStream *stream = tokenize_file(system_module_paths[mod]);
 
@@ -86,6 +89,8 @@ HylicModule *load_system_module(SystemModule mod) {
   }
 
   typesolve(program);
+  resolve_slots(program);
+  compile_module(program);
 
   return program;
 }
@@ -0,0 +1,503 @@
+#include "wire.h"
+#include "gc.h"
+#include "general_util.h"
+#include "hylic_ast.h"
+#include "selector.h"
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+static inline void put_u8(std::string &buf, u8 v) {
+  buf.push_back((char)v);
+}
+
+static inline void put_u16(std::string &buf, u16 v) {
+  put_u8(buf, v & 0xFF);
+  put_u8(buf, v >> 8);
+}
+
+static inline void put_s32(std::string &buf, s32 v) {
+  u32 u = (u32)v;
+  for (int k = 0; k < 4; ++k) {
+    put_u8(buf, (u >> (8 * k)) & 0xFF);
+  }
+}
+
+static inline void put_varint(std::string &buf, u64 v) {
+  while (v >= 0x80) {
+    put_u8(buf, (v & 0x7F) | 0x80);
+    v >>= 7;
+  }
+  put_u8(buf, v);
+}
+
+static inline void put_zigzag(std::string &buf, s64 v) {
+  put_varint(buf, ((u64)v << 1) ^ (u64)(v >> 63));
+}
+
+static inline void put_bytes(std::string &buf, const std::string &s) {
+  put_varint(buf, s.size());
+  buf.append(s);
+}
+
+// Refs boxed for request-far-entity go out like any other ref
+static inline Value unbox_ref(Value v) {
+  if (v.tag == ValueTag::Node && v.node->type == AstNodeType::EntityRefNode) {
+    return to_value(v.node);
+  }
+  return v;
+}
+
+// The entity type a boxed ref carries, if any
+static inline const std::string *ref_type_name(Value v) {
+  if (v.tag == ValueTag::Node && v.node->type == AstNodeType::EntityRefNode && !v.node->ctype.entity_name.empty()) {
+    return &v.node->ctype.entity_name;
+  }
+  return nullptr;
+}
+
+AstNode *make_typed_ref(s32 node_id, s32 vat_id, s32 entity_id, std::string entity_name) {
+  AstNode *ref = make_entity_ref(node_id, vat_id, entity_id);
+  ref->ctype.basetype = PType::Entity;
+  ref->ctype.dtype = DType::Far;
+  ref->ctype.subtype = nullptr;
+  ref->ctype.entity_name = std::move(entity_name);
+  ref->gc_gen = GcGen::Exported;
+  return ref;
+}
+
+static void encode_node(std::string &buf, AstNode *node);
+
+static void encode_value(std::string &buf, Value v) {
+  const std::string *type_name = ref_type_name(v);
+  v = unbox_ref(v);
+
+  if (v.tag == ValueTag::Number) {
+    put_u8(buf, (u8)WireTag::Number);
+    put_zigzag(buf, v.number);
+  } else if (v.tag == ValueTag::Boolean) {
+    put_u8(buf, (u8)WireTag::Boolean);
+    put_u8(buf, v.boolean);
+  } else if (v.tag == ValueTag::EntityRef) {
+    put_u8(buf, (u8)(type_name ? WireTag::TypedEntityRef : WireTag::EntityRef));
+    put_zigzag(buf, v.ref_node_id);
+    put_zigzag(buf, v.ref.vat_id);
+    put_zigzag(buf, v.ref.entity_id);
+    if (type_name) {
+      put_bytes(buf, *type_name);
+    }
+  } else if (v.tag == ValueTag::Node) {
+    encode_node(buf, v.node);
+  } else {
+    panic("Unhandled value in wire encode.");
+  }
+}
+
+static void encode_node(std::string &buf, AstNode *node) {
+  if (node->type == AstNodeType::StringNode) {
+    put_u8(buf, (u8)WireTag::String);
+    put_bytes(buf, ((StringNode *)node)->value);
+  } else if (node->type == AstNodeType::ListNode) {
+    auto list = (ListNode *)node;
+    put_u8(buf, (u8)WireTag::List);
+    put_varint(buf, list->list.size());
+    for (auto elem : list->list) {
+      encode_value(buf, to_value(elem));
+    }
+  } else {
+    encode_value(buf, to_value(node));
+  }
+}
+
+void wire_begin(WireEncoder *enc) {
+  enc->buf.clear();
+  enc->selectors.clear();
+  enc->n_calls = 0;
+
+  put_u8(enc->buf, WIRE_MAGIC);
+  put_u8(enc->buf, WIRE_VERSION);
+}
+
+void wire_encode_call(WireEncoder *enc, const Msg &m) {
+  std::string &buf = enc->buf;
+  assert(m.values.size() <= 0xFF);
+
+  u8 flags = m.response ? WIRE_RESPONSE : 0;
+  auto found = enc->selectors.find(m.selector);
+  u16 sel_index;
+  if (found != enc->selectors.end()) {
+    sel_index = found->second;
+  } else {
+    assert(enc->selectors.size() < 0xFFFF);
+    sel_index = enc->selectors.size();
+    enc->selectors[m.selector] = sel_index;
+    flags |= WIRE_NEW_SELECTOR;
+  }
+
+  put_s32(buf, m.node_id);
+  put_s32(buf, m.vat_id);
+  put_s32(buf, m.entity_id);
+  put_s32(buf, m.src_node_id);
+  put_s32(buf, m.src_vat_id);
+  put_s32(buf, m.src_entity_id);
+  put_s32(buf, m.promise_id);
+  put_u16(buf, sel_index);
+  put_u8(buf, flags);
+  put_u8(buf, m.values.size());
+
+  if (flags & WIRE_NEW_SELECTOR) {
+    put_bytes(buf, selector_name(m.selector));
+  }
+
+  for (auto &v : m.values) {
+    encode_value(buf, v);
+  }
+
+  enc->n_calls++;
+}
+
+bool is_wire_packet(const u8 *data, size_t len) {
+  return len >= 2 && data[0] == WIRE_MAGIC;
+}
+
+// Bounds-checked reads, any of them failing makes the rest fail too
+struct WireReader {
+  const u8 *pos;
+  const u8 *end;
+  bool ok = true;
+
+  bool need(size_t n) {
+    if (ok && (size_t)(end - pos) < n) ok = false;
+    return ok;
+  }
+
+  u8 u8_() {
+    if (!need(1)) return 0;
+    return *pos++;
+  }
+
+  u16 u16_() {
+    if (!need(2)) return 0;
+    u16 v = pos[0] | (pos[1] << 8);
+    pos += 2;
+    return v;
+  }
+
+  s32 s32_() {
+    if (!need(4)) return 0;
+    u32 v = (u32)pos[0] | ((u32)pos[1] << 8) | ((u32)pos[2] << 16) | ((u32)pos[3] << 24);
+    pos += 4;
+    return (s32)v;
+  }
+
+  u64 varint() {
+    u64 v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (!need(1)) return 0;
+      u8 b = *pos++;
+      v |= (u64)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return v;
+    }
+    ok = false;
+    return 0;
+  }
+
+  s64 zigzag() {
+    u64 v = varint();
+    return (s64)(v >> 1) ^ -(s64)(v & 1);
+  }
+
+  std::string bytes() {
+    u64 n = varint();
+    if (!need(n)) return "";
+    std::string s((const char *)pos, n);
+    pos += n;
+    return s;
+  }
+};
+
+// Exported like everything else that arrives over the network
+static AstNode *exported(AstNode *node) {
+  node->gc_gen = GcGen::Exported;
+  return node;
+}
+
+static Value decode_value(WireReader &r, int depth);
+
+static AstNode *decode_node(WireReader &r, int depth) {
+  Value v = decode_value(r, depth);
+  if (!r.ok) return nullptr;
+  return box_exported(v);
+}
+
+static Value decode_value(WireReader &r, int depth) {
+  // Nesting only comes from lists, this keeps a hostile packet off the stack
+  if (depth > 64) {
+    r.ok = false;
+    return Value();
+  }
+
+  switch ((WireTag)r.u8_()) {
+  case WireTag::Number:
+    return number_value(r.zigzag());
+  case WireTag::Boolean: {
+    u8 b = r.u8_();
+    if (b > 1) r.ok = false;
+    return boolean_value(b);
+  }
+  case WireTag::EntityRef: {
+    s32 node_id = r.zigzag();
+    s32 vat_id = r.zigzag();
+    s32 entity_id = r.zigzag();
+    return ref_value(node_id, vat_id, entity_id);
+  }
+  case WireTag::TypedEntityRef: {
+    s32 node_id = r.zigzag();
+    s32 vat_id = r.zigzag();
+    s32 entity_id = r.zigzag();
+    std::string entity_name = r.bytes();
+    if (!r.ok) return Value();
+    return node_value(make_typed_ref(node_id, vat_id, entity_id, std::move(entity_name)));
+  }
+  case WireTag::String: {
+    std::string s = r.bytes();
+    if (!r.ok) return Value();
+    return node_value(exported(make_string(std::move(s))));
+  }
+  case WireTag::List: {
+    u64 n = r.varint();
+    // Every element takes at least two bytes
+    if (n > (u64)(r.end - r.pos) / 2) {
+      r.ok = false;
+      return Value();
+    }
+
+    std::vector<AstNode *> elems;
+    elems.reserve(n);
+    for (u64 k = 0; k < n; ++k) {
+      AstNode *elem = decode_node(r, depth + 1);
+      if (!elem) break;
+      elems.push_back(elem);
+    }
+
+    auto list = exported(make_list(elems, nullptr));
+    if (!r.ok) {
+      Msg partial;
+      partial.values.push_back(node_value(list));
+      release_msg(partial);
+      return Value();
+    }
+    return node_value(list);
+  }
+  default:
+    r.ok = false;
+    return Value();
+  }
+}
+
+bool wire_decode(const u8 *data, size_t len, const std::function<void(Msg &&)> &deliver) {
+  if (!is_wire_packet(data, len) || data[1] > WIRE_VERSION) {
+    return false;
+  }
+
+  WireReader r = {data + 2, data + len};
+  std::vector<Selector> selectors;
+
+  while (r.pos < r.end) {
+    if (!r.need(WIRE_CALL_HEADER_SIZE)) return false;
+
+    Msg m;
+    m.node_id = r.s32_();
+    m.vat_id = r.s32_();
+    m.entity_id = r.s32_();
+    m.src_node_id = r.s32_();
+    m.src_vat_id = r.s32_();
+    m.src_entity_id = r.s32_();
+    m.promise_id = r.s32_();
+    u16 sel_index = r.u16_();
+    u8 flags = r.u8_();
+    u8 n_values = r.u8_();
+
+    m.response = flags & WIRE_RESPONSE;
+
+    if (flags & WIRE_NEW_SELECTOR) {
+      std::string name = r.bytes();
+      if (!r.ok || sel_index != selectors.size()) return false;
+      selectors.push_back(intern_selector(name));
+    }
+    if (sel_index >= selectors.size()) return false;
+    m.selector = selectors[sel_index];
+
+    m.values.reserve(n_values);
+    for (int k = 0; k < n_values; ++k) {
+      Value v = decode_value(r, 0);
+      if (!r.ok) break;
+      m.values.push_back(v);
+    }
+
+    if (!r.ok) {
+      release_msg(m);
+      return false;
+    }
+
+    deliver(std::move(m));
+  }
+
+  return true;
+}
+
+// Field numbers and wire types from protoloma.proto.  Every field number is
+// below 16 so every tag is one byte.
+enum PbWireType : u8 { PB_VARINT = 0, PB_LEN = 2 };
+
+static inline void put_tag(std::string &buf, int field, PbWireType type) {
+  put_u8(buf, (field << 3) | type);
+}
+
+static inline size_t varint_size(u64 v) {
+  size_t n = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    n++;
+  }
+  return n;
+}
+
+// int32 and int64 fields are plain varints, negatives sign extended to 64 bits
+static inline size_t pb_int_size(s64 v) {
+  return varint_size((u64)v);
+}
+
+static inline void put_pb_int(std::string &buf, int field, s64 v) {
+  put_tag(buf, field, PB_VARINT);
+  put_varint(buf, (u64)v);
+}
+
+// Tag, length and body of a length-delimited field
+static inline size_t pb_len_field_size(size_t len) {
+  return 1 + varint_size(len) + len;
+}
+
+static inline void put_pb_len(std::string &buf, int field, size_t len) {
+  put_tag(buf, field, PB_LEN);
+  put_varint(buf, len);
+}
+
+// Records the length of the PValue's oneof member, and those of everything
+// nested in it, in the order write_pvalue writes them.  Returns the length of
+// the PValue.
+static size_t size_pvalue(Value v, std::vector<u32> &sizes) {
+  const std::string *type_name = ref_type_name(v);
+  v = unbox_ref(v);
+  size_t at = sizes.size();
+  sizes.push_back(0);
+
+  size_t len = 0;
+  if (v.tag == ValueTag::Number) {
+    len = 1 + pb_int_size(v.number);
+  } else if (v.tag == ValueTag::Boolean) {
+    len = 2;
+  } else if (v.tag == ValueTag::EntityRef) {
+    len = 3 + pb_int_size(v.ref_node_id) + pb_int_size(v.ref.vat_id) + pb_int_size(v.ref.entity_id);
+    if (type_name) {
+      len += pb_len_field_size(type_name->size());
+    }
+  } else if (v.tag == ValueTag::Node && v.node->type == AstNodeType::StringNode) {
+    len = pb_len_field_size(((StringNode *)v.node)->value.size());
+  } else if (v.tag == ValueTag::Node && v.node->type == AstNodeType::ListNode) {
+    for (auto elem : ((ListNode *)v.node)->list) {
+      len += pb_len_field_size(size_pvalue(to_value(elem), sizes));
+    }
+  } else {
+    panic("Unhandled value in netcode send.");
+  }
+
+  sizes[at] = len;
+  return pb_len_field_size(len);
+}
+
+static void write_pvalue(std::string &buf, Value v, const u32 *&size) {
+  const std::string *type_name = ref_type_name(v);
+  v = unbox_ref(v);
+  u32 len = *size++;
+
+  if (v.tag == ValueTag::Number) {
+    put_pb_len(buf, 1, len);
+    put_pb_int(buf, 1, v.number);
+  } else if (v.tag == ValueTag::Boolean) {
+    put_pb_len(buf, 5, len);
+    put_pb_int(buf, 1, v.boolean);
+  } else if (v.tag == ValueTag::EntityRef) {
+    put_pb_len(buf, 3, len);
+    put_pb_int(buf, 1, v.ref_node_id);
+    put_pb_int(buf, 2, v.ref.vat_id);
+    put_pb_int(buf, 3, v.ref.entity_id);
+    if (type_name) {
+      put_pb_len(buf, 4, type_name->size());
+      buf.append(*type_name);
+    }
+  } else if (v.node->type == AstNodeType::StringNode) {
+    auto &s = ((StringNode *)v.node)->value;
+    put_pb_len(buf, 2, len);
+    put_pb_len(buf, 1, s.size());
+    buf.append(s);
+  } else {
+    put_pb_len(buf, 4, len);
+    for (auto elem : ((ListNode *)v.node)->list) {
+      // The element's own length is the next one recorded
+      put_pb_len(buf, 1, pb_len_field_size(*size));
+      write_pvalue(buf, to_value(elem), size);
+    }
+  }
+}
+
+void call_batch_begin(CallBatchEncoder *enc) {
+  enc->buf.clear();
+  enc->n_calls = 0;
+}
+
+void call_batch_encode(CallBatchEncoder *enc, const Msg &m) {
+  std::string &buf = enc->buf;
+  std::vector<u32> &sizes = enc->sizes;
+  sizes.clear();
+
+  // Selectors are only meaningful on this node
+  std::string function_id = selector_name(m.selector);
+
+  size_t len = 7 + pb_int_size(m.node_id) + pb_int_size(m.vat_id) + pb_int_size(m.entity_id) + pb_int_size(m.src_node_id) +
+               pb_int_size(m.src_vat_id) + pb_int_size(m.src_entity_id) + pb_int_size(m.promise_id) +
+               pb_len_field_size(function_id.size()) + 2;
+  for (auto &v : m.values) {
+    len += pb_len_field_size(size_pvalue(v, sizes));
+  }
+
+  // CallBatch.calls
+  put_pb_len(buf, 1, len);
+
+  put_pb_int(buf, 1, m.node_id);
+  put_pb_int(buf, 2, m.vat_id);
+  put_pb_int(buf, 3, m.entity_id);
+  put_pb_len(buf, 4, function_id.size());
+  buf.append(function_id);
+  put_pb_int(buf, 5, m.src_node_id);
+  put_pb_int(buf, 6, m.src_vat_id);
+  put_pb_int(buf, 7, m.src_entity_id);
+  put_pb_int(buf, 9, m.response);
+  put_pb_int(buf, 10, m.promise_id);
+
+  const u32 *size = sizes.data();
+  for (auto &v : m.values) {
+    put_pb_len(buf, 11, pb_len_field_size(*size));
+    write_pvalue(buf, v, size);
+  }
+
+  enc->n_calls++;
+}
+
+size_t call_batch_header(const CallBatchEncoder *enc, u8 *out) {
+  // PleromaMessage.call_batch
+  std::string header;
+  put_pb_len(header, 5, enc->buf.size());
+  memcpy(out, header.data(), header.size());
+  return header.size();
+}
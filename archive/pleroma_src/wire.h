@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common.h"
+#include "hylic_eval.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compact encoding for calls between nodes, sent instead of a protobuf
+// CallBatch when the node is configured with "wire": "binary".  Every node
+// decodes both, the rest of the protocol stays protobuf.
+//
+// A packet is WIRE_MAGIC, WIRE_VERSION, then calls back to back.  A call is a
+// fixed little-endian header
+//
+//   s32 node_id, vat_id, entity_id
+//   s32 src_node_id, src_vat_id, src_entity_id
+//   s32 promise_id
+//   u16 selector   index into the packet's selector table
+//   u8  flags      WIRE_RESPONSE, WIRE_NEW_SELECTOR
+//   u8  n_values
+//
+// followed, with WIRE_NEW_SELECTOR, by the selector's name (varint length,
+// bytes) which becomes the next entry in the table, and then the values.
+// Selectors are only meaningful on the node that interned them, so a packet
+// names each one it uses once.
+//
+// A value is a WireTag byte and then
+//   Number     zigzag varint
+//   String     varint length, bytes
+//   EntityRef  zigzag varint node_id, vat_id, entity_id
+//   List       varint count, that many values
+//   Boolean    one byte, 0 or 1
+//   TypedEntityRef  an EntityRef followed by its entity type name (varint
+//              length, bytes)
+
+const u8 WIRE_MAGIC = 0xB1;
+const u8 WIRE_VERSION = 1;
+const size_t WIRE_CALL_HEADER_SIZE = 32;
+
+enum WireFlags : u8 { WIRE_RESPONSE = 1, WIRE_NEW_SELECTOR = 2 };
+
+enum class WireTag : u8 { Number = 1, String = 2, EntityRef = 3, List = 4, Boolean = 5, TypedEntityRef = 6 };
+
+// One packet being built, calls are appended as they are sent
+struct WireEncoder {
+  std::string buf;
+  std::unordered_map<Selector, u16> selectors;
+  int n_calls = 0;
+};
+
+// Clears the encoder and starts a new packet
+void wire_begin(WireEncoder *enc);
+void wire_encode_call(WireEncoder *enc, const Msg &m);
+
+// A protobuf PleromaMessage never starts with WIRE_MAGIC
+bool is_wire_packet(const u8 *data, size_t len);
+
+// Hands every call in the packet to deliver.  Strings and lists come out
+// exported, owned by the message until a vat imports it (see gc.h).  False if
+// the packet is truncated, malformed or from a newer version, calls before
+// the bad one have been delivered already.
+bool wire_decode(const u8 *data, size_t len, const std::function<void(Msg &&)> &deliver);
+
+// Decoded refs that carried their entity type come out boxed with it, the
+// way request-far-entity expects them
+AstNode *make_typed_ref(s32 node_id, s32 vat_id, s32 entity_id, std::string entity_name);
+
+// The protobuf format, written straight into protobuf wire format instead of
+// building romabuf::Call objects first, so a call with a large list costs one
+// pass over the list and no allocations past growing buf.  The packet is the
+// header from call_batch_header followed by buf, and parses as a
+// PleromaMessage holding a CallBatch.
+struct CallBatchEncoder {
+  // The CallBatch's encoded calls entries
+  std::string buf;
+  int n_calls = 0;
+  // Lengths of the nested messages in the call being encoded, worked out
+  // before any of it is written since each one is prefixed with its length
+  std::vector<u32> sizes;
+};
+
+const size_t CALL_BATCH_HEADER_MAX = 6;
+
+void call_batch_begin(CallBatchEncoder *enc);
+void call_batch_encode(CallBatchEncoder *enc, const Msg &m);
+// Writes the bytes that go in front of buf, returns how many
+size_t call_batch_header(const CallBatchEncoder *enc, u8 *out);
@@ -0,0 +1,230 @@
+#include "wirebench.h"
+#include "gc.h"
+#include "hylic_ast.h"
+#include "hylic_eval.h"
+#include "lz.h"
+#include "netcode.h"
+#include "wire.h"
+#include <chrono>
+#include <functional>
+#include <google/protobuf/arena.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+const int WIREBENCH_CALLS = 512;
+const int WIREBENCH_ROUNDS = 200;
+
+struct WireBenchCase {
+  const char *name;
+  std::function<void(Msg &, int)> fill;
+};
+
+// A few KB of text, like a Zeno file chunk
+static std::string file_chunk(int k) {
+  std::string chunk;
+  for (int line = 0; chunk.size() < 4096; ++line) {
+    chunk += "line " + std::to_string(k + line) + ": some file contents, stored by zeno " + std::to_string(line % 7) + "\n";
+  }
+  return chunk;
+}
+
+// Payloads the way a node actually sends them: responses carrying a number,
+// calls passing an entity ref along, a short string, a [str] like
+// ZenoMaster::checkout returns with a nested list on the end, and file
+// contents
+static std::vector<WireBenchCase> bench_cases() {
+  return {
+      {"number", [](Msg &m, int k) { m.values.push_back(number_value(k * 37)); }},
+      {"ref+number",
+       [](Msg &m, int k) {
+         m.values.push_back(ref_value(1, k % 16, k));
+         m.values.push_back(number_value(-k));
+       }},
+      {"string", [](Msg &m, int k) { m.values.push_back(node_value(make_string("payload string " + std::to_string(k)))); }},
+      {"list",
+       [](Msg &m, int k) {
+         std::vector<AstNode *> elems;
+         for (int j = 0; j < 8; ++j) {
+           elems.push_back(make_string("item " + std::to_string(k + j)));
+         }
+         elems.push_back(make_list({make_number(k), make_boolean(k % 2)}, nullptr));
+         m.values.push_back(node_value(make_list(elems, nullptr)));
+       }},
+      {"file", [](Msg &m, int k) { m.values.push_back(node_value(make_string(file_chunk(k)))); }},
+  };
+}
+
+static std::vector<Msg> make_calls(const WireBenchCase &bench_case) {
+  std::vector<Msg> calls;
+  Selector sels[] = {intern_selector("checkout"), intern_selector("print"), intern_selector("request-far-entity")};
+
+  for (int k = 0; k < WIREBENCH_CALLS; ++k) {
+    Msg m;
+    m.node_id = 1;
+    m.vat_id = k % 64;
+    m.entity_id = k % 3;
+    m.src_node_id = 0;
+    m.src_vat_id = 7;
+    m.src_entity_id = 0;
+    m.promise_id = k;
+    m.response = k % 2;
+    m.selector = sels[k % 3];
+    bench_case.fill(m, k);
+    calls.push_back(m);
+  }
+
+  return calls;
+}
+
+// The payloads were made outside any vat, nothing else frees them
+static void free_bench_node(AstNode *node) {
+  if (node->type == AstNodeType::ListNode) {
+    for (auto elem : ((ListNode *)node)->list) {
+      free_bench_node(elem);
+    }
+  }
+  // Shared
+  if (node->type != AstNodeType::BooleanNode) {
+    destroy_ast_obj(nullptr, node);
+  }
+}
+
+static std::string msg_to_string(const Msg &m) {
+  std::string res = std::to_string(m.node_id) + " " + std::to_string(m.vat_id) + " " + std::to_string(m.entity_id) + " " +
+                    std::to_string(m.src_node_id) + " " + std::to_string(m.src_vat_id) + " " + std::to_string(m.src_entity_id) + " " +
+                    std::to_string(m.promise_id) + " " + std::to_string(m.response) + " " + selector_name(m.selector);
+  for (auto &v : m.values) {
+    res += " " + value_to_string(v);
+  }
+  return res;
+}
+
+struct WireBenchResult {
+  double encode_ns = 0;
+  double decode_ns = 0;
+  double bytes = 0;
+  bool matched = true;
+};
+
+template <class F>
+static double ns_per_call(F f) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < WIREBENCH_ROUNDS; ++round) {
+    f();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)(WIREBENCH_ROUNDS * WIREBENCH_CALLS);
+}
+
+// With lz the packet is compressed the way netcode sends it to a peer, and
+// the cost of that is counted in
+static WireBenchResult bench_protobuf(const std::vector<Msg> &calls, bool lz) {
+  WireBenchResult result;
+  CallBatchEncoder encoder;
+  std::string buf;
+  std::vector<u8> lz_buf;
+  size_t lz_len = 0;
+
+  result.encode_ns = ns_per_call([&]() {
+    call_batch_begin(&encoder);
+    for (auto &m : calls) {
+      call_batch_encode(&encoder, m);
+    }
+    u8 header[CALL_BATCH_HEADER_MAX];
+    buf.assign((const char *)header, call_batch_header(&encoder, header));
+    buf.append(encoder.buf);
+    if (lz) {
+      lz_buf.resize(lz_compress_bound(buf.size()));
+      lz_len = lz_compress((const u8 *)buf.data(), buf.size(), lz_buf.data());
+    }
+  });
+  result.bytes = (lz ? lz_len : buf.size()) / (double)calls.size();
+
+  std::string raw(buf.size(), 0);
+  auto unpack = [&]() {
+    if (lz) {
+      result.matched &= lz_decompress(lz_buf.data(), lz_len, (u8 *)raw.data(), raw.size());
+      return raw.data();
+    }
+    return buf.data();
+  };
+
+  google::protobuf::Arena arena;
+  result.decode_ns = ns_per_call([&]() {
+    arena.Reset();
+    auto in = google::protobuf::Arena::CreateMessage<romabuf::PleromaMessage>(&arena);
+    in->ParseFromArray(unpack(), buf.size());
+    for (auto &call : in->call_batch().calls()) {
+      Msg m = call_to_msg(call);
+      release_msg(m);
+    }
+  });
+
+  arena.Reset();
+  auto in = google::protobuf::Arena::CreateMessage<romabuf::PleromaMessage>(&arena);
+  in->ParseFromArray(unpack(), buf.size());
+  for (int k = 0; k < in->call_batch().calls_size(); ++k) {
+    Msg m = call_to_msg(in->call_batch().calls(k));
+    result.matched &= msg_to_string(m) == msg_to_string(calls[k]);
+    release_msg(m);
+  }
+
+  return result;
+}
+
+static WireBenchResult bench_binary(const std::vector<Msg> &calls) {
+  WireBenchResult result;
+  WireEncoder encoder;
+
+  result.encode_ns = ns_per_call([&]() {
+    wire_begin(&encoder);
+    for (auto &m : calls) {
+      wire_encode_call(&encoder, m);
+    }
+  });
+  result.bytes = encoder.buf.size() / (double)calls.size();
+
+  const u8 *data = (const u8 *)encoder.buf.data();
+  result.decode_ns = ns_per_call([&]() {
+    wire_decode(data, encoder.buf.size(), [](Msg &&m) { release_msg(m); });
+  });
+
+  size_t k = 0;
+  bool decoded = wire_decode(data, encoder.buf.size(), [&](Msg &&m) {
+    result.matched &= k < calls.size() && msg_to_string(m) == msg_to_string(calls[k]);
+    k++;
+    release_msg(m);
+  });
+  result.matched &= decoded && k == calls.size();
+
+  return result;
+}
+
+int run_wirebench() {
+  int n_mismatched = 0;
+
+  printf("%d calls a batch, %d rounds\n", WIREBENCH_CALLS, WIREBENCH_ROUNDS);
+  printf("%-12s %-9s %10s %10s %10s\n", "payload", "format", "encode ns", "decode ns", "bytes");
+
+  for (auto &bench_case : bench_cases()) {
+    std::vector<Msg> calls = make_calls(bench_case);
+
+    WireBenchResult results[] = {bench_protobuf(calls, false), bench_binary(calls), bench_protobuf(calls, true)};
+    const char *formats[] = {"protobuf", "binary", "proto+lz"};
+
+    for (int k = 0; k < 3; ++k) {
+      printf("%-12s %-9s %10.1f %10.1f %10.1f%s\n", bench_case.name, formats[k], results[k].encode_ns, results[k].decode_ns,
+             results[k].bytes, results[k].matched ? "" : "  MISMATCH");
+      n_mismatched += !results[k].matched;
+    }
+
+    for (auto &m : calls) {
+      for (auto &v : m.values) {
+        if (v.tag == ValueTag::Node) free_bench_node(v.node);
+      }
+    }
+  }
+
+  return n_mismatched;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Encodes and decodes batches of typical calls with both wire formats, and
+// protobuf compressed the way large packets are sent, and prints the cost
+// per call and the bytes each one takes.  Returns non-zero if a decoded call
+// doesn't match what was encoded.
+int run_wirebench();
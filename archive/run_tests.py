@@ -4,6 +4,9 @@ import sys, os
 import glob
 import subprocess
 
+# --diff also runs every passing test under both execution engines
+diff_engines = "--diff" in sys.argv[1:]
+
 all_succeed = True
 for test_file in sorted(glob.glob("tests/*")):
     # We expect a failure
@@ -16,6 +19,10 @@ for test_file in sorted(glob.glob("tests/*")):
     else:
         success = output_code == 0
 
+    if success and diff_engines and "fail" not in test_file:
+        output = subprocess.run("./pleroma difftest {}".format(test_file), shell = True, capture_output = True)
+        success = output.returncode == 0
+
     if success:
         print("\033[1;32mSuccess:\033[0m {}".format(test_file))
     else:
@@ -8,12 +8,12 @@
 #include <string>
 
 #include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3012000
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3012004 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -23,9 +23,8 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_table_driven.h>
+#include <google/protobuf/generated_message_bases.h>
 #include <google/protobuf/generated_message_util.h>
-#include <google/protobuf/inlined_string_field.h>
 #include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/message.h>
@@ -43,62 +42,62 @@ PROTOBUF_NAMESPACE_CLOSE
 
 // Internal implementation detail -- do not use these members.
 struct TableStruct_protoloma_2eproto {
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTableField entries[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::AuxillaryParseTableField aux[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[13]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
-  static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
-  static const ::PROTOBUF_NAMESPACE_ID::uint32 offsets[];
+  static const uint32_t offsets[];
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_protoloma_2eproto;
 namespace romabuf {
 class AnnouncePeer;
-class AnnouncePeerDefaultTypeInternal;
+struct AnnouncePeerDefaultTypeInternal;
 extern AnnouncePeerDefaultTypeInternal _AnnouncePeer_default_instance_;
 class AssignClusterInfo;
-class AssignClusterInfoDefaultTypeInternal;
+struct AssignClusterInfoDefaultTypeInternal;
 extern AssignClusterInfoDefaultTypeInternal _AssignClusterInfo_default_instance_;
+class BoolVal;
+struct BoolValDefaultTypeInternal;
+extern BoolValDefaultTypeInternal _BoolVal_default_instance_;
 class Call;
-class CallDefaultTypeInternal;
+struct CallDefaultTypeInternal;
 extern CallDefaultTypeInternal _Call_default_instance_;
+class CallBatch;
+struct CallBatchDefaultTypeInternal;
+extern CallBatchDefaultTypeInternal _CallBatch_default_instance_;
 class ERefVal;
-class ERefValDefaultTypeInternal;
+struct ERefValDefaultTypeInternal;
 extern ERefValDefaultTypeInternal _ERefVal_default_instance_;
 class Greeting;
-class GreetingDefaultTypeInternal;
+struct GreetingDefaultTypeInternal;
 extern GreetingDefaultTypeInternal _Greeting_default_instance_;
 class GreetingAck;
-class GreetingAckDefaultTypeInternal;
+struct GreetingAckDefaultTypeInternal;
 extern GreetingAckDefaultTypeInternal _GreetingAck_default_instance_;
 class HostInfo;
-class HostInfoDefaultTypeInternal;
+struct HostInfoDefaultTypeInternal;
 extern HostInfoDefaultTypeInternal _HostInfo_default_instance_;
 class ListVal;
-class ListValDefaultTypeInternal;
+struct ListValDefaultTypeInternal;
 extern ListValDefaultTypeInternal _ListVal_default_instance_;
 class LoadProgram;
-class LoadProgramDefaultTypeInternal;
+struct LoadProgramDefaultTypeInternal;
 extern LoadProgramDefaultTypeInternal _LoadProgram_default_instance_;
 class NumVal;
-class NumValDefaultTypeInternal;
+struct NumValDefaultTypeInternal;
 extern NumValDefaultTypeInternal _NumVal_default_instance_;
 class PValue;
-class PValueDefaultTypeInternal;
+struct PValueDefaultTypeInternal;
 extern PValueDefaultTypeInternal _PValue_default_instance_;
 class PleromaMessage;
-class PleromaMessageDefaultTypeInternal;
+struct PleromaMessageDefaultTypeInternal;
 extern PleromaMessageDefaultTypeInternal _PleromaMessage_default_instance_;
 class StrVal;
-class StrValDefaultTypeInternal;
+struct StrValDefaultTypeInternal;
 extern StrValDefaultTypeInternal _StrVal_default_instance_;
 }  // namespace romabuf
 PROTOBUF_NAMESPACE_OPEN
 template<> ::romabuf::AnnouncePeer* Arena::CreateMaybeMessage<::romabuf::AnnouncePeer>(Arena*);
 template<> ::romabuf::AssignClusterInfo* Arena::CreateMaybeMessage<::romabuf::AssignClusterInfo>(Arena*);
+template<> ::romabuf::BoolVal* Arena::CreateMaybeMessage<::romabuf::BoolVal>(Arena*);
 template<> ::romabuf::Call* Arena::CreateMaybeMessage<::romabuf::Call>(Arena*);
+template<> ::romabuf::CallBatch* Arena::CreateMaybeMessage<::romabuf::CallBatch>(Arena*);
 template<> ::romabuf::ERefVal* Arena::CreateMaybeMessage<::romabuf::ERefVal>(Arena*);
 template<> ::romabuf::Greeting* Arena::CreateMaybeMessage<::romabuf::Greeting>(Arena*);
 template<> ::romabuf::GreetingAck* Arena::CreateMaybeMessage<::romabuf::GreetingAck>(Arena*);
@@ -114,11 +113,12 @@ namespace romabuf {
 
 // ===================================================================
 
-class HostInfo PROTOBUF_FINAL :
+class HostInfo final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.HostInfo) */ {
  public:
-  inline HostInfo() : HostInfo(nullptr) {};
-  virtual ~HostInfo();
+  inline HostInfo() : HostInfo(nullptr) {}
+  ~HostInfo() override;
+  explicit PROTOBUF_CONSTEXPR HostInfo(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   HostInfo(const HostInfo& from);
   HostInfo(HostInfo&& from) noexcept
@@ -131,8 +131,13 @@ class HostInfo PROTOBUF_FINAL :
     return *this;
   }
   inline HostInfo& operator=(HostInfo&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -150,14 +155,14 @@ class HostInfo PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HostInfo& default_instance() {
+    return *internal_default_instance();
   }
-  static const HostInfo& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const HostInfo* internal_default_instance() {
     return reinterpret_cast<const HostInfo*>(
                &_HostInfo_default_instance_);
@@ -170,7 +175,12 @@ class HostInfo PROTOBUF_FINAL :
   }
   inline void Swap(HostInfo* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -178,56 +188,53 @@ class HostInfo PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(HostInfo* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline HostInfo* New() const final {
-    return CreateMaybeMessage<HostInfo>(nullptr);
-  }
-
-  HostInfo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  HostInfo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<HostInfo>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const HostInfo& from);
-  void MergeFrom(const HostInfo& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HostInfo& from) {
+    HostInfo::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(HostInfo* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.HostInfo";
   }
   protected:
-  explicit HostInfo(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit HostInfo(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -271,25 +278,14 @@ class HostInfo PROTOBUF_FINAL :
   public:
   void clear_address();
   const std::string& address() const;
-  void set_address(const std::string& value);
-  void set_address(std::string&& value);
-  void set_address(const char* value);
-  void set_address(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_address(ArgT0&& arg0, ArgT... args);
   std::string* mutable_address();
-  std::string* release_address();
+  PROTOBUF_NODISCARD std::string* release_address();
   void set_allocated_address(std::string* address);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_address();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_address(
-      std::string* address);
   private:
   const std::string& _internal_address() const;
-  void _internal_set_address(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_address(const std::string& value);
   std::string* _internal_mutable_address();
   public:
 
@@ -300,7 +296,7 @@ class HostInfo PROTOBUF_FINAL :
   public:
   void clear_nodeman_addr();
   const ::romabuf::ERefVal& nodeman_addr() const;
-  ::romabuf::ERefVal* release_nodeman_addr();
+  PROTOBUF_NODISCARD ::romabuf::ERefVal* release_nodeman_addr();
   ::romabuf::ERefVal* mutable_nodeman_addr();
   void set_allocated_nodeman_addr(::romabuf::ERefVal* nodeman_addr);
   private:
@@ -317,11 +313,11 @@ class HostInfo PROTOBUF_FINAL :
   bool _internal_has_node_id() const;
   public:
   void clear_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id() const;
-  void set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t node_id() const;
+  void set_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_node_id() const;
-  void _internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_node_id() const;
+  void _internal_set_node_id(int32_t value);
   public:
 
   // required uint32 port = 3;
@@ -330,11 +326,11 @@ class HostInfo PROTOBUF_FINAL :
   bool _internal_has_port() const;
   public:
   void clear_port();
-  ::PROTOBUF_NAMESPACE_ID::uint32 port() const;
-  void set_port(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t port() const;
+  void set_port(uint32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint32 _internal_port() const;
-  void _internal_set_port(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t _internal_port() const;
+  void _internal_set_port(uint32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.HostInfo)
@@ -347,22 +343,26 @@ class HostInfo PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> resources_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr address_;
-  ::romabuf::ERefVal* nodeman_addr_;
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id_;
-  ::PROTOBUF_NAMESPACE_ID::uint32 port_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> resources_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr address_;
+    ::romabuf::ERefVal* nodeman_addr_;
+    int32_t node_id_;
+    uint32_t port_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class NumVal PROTOBUF_FINAL :
+class NumVal final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.NumVal) */ {
  public:
-  inline NumVal() : NumVal(nullptr) {};
-  virtual ~NumVal();
+  inline NumVal() : NumVal(nullptr) {}
+  ~NumVal() override;
+  explicit PROTOBUF_CONSTEXPR NumVal(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   NumVal(const NumVal& from);
   NumVal(NumVal&& from) noexcept
@@ -375,8 +375,13 @@ class NumVal PROTOBUF_FINAL :
     return *this;
   }
   inline NumVal& operator=(NumVal&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -394,14 +399,14 @@ class NumVal PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const NumVal& default_instance() {
+    return *internal_default_instance();
   }
-  static const NumVal& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const NumVal* internal_default_instance() {
     return reinterpret_cast<const NumVal*>(
                &_NumVal_default_instance_);
@@ -414,7 +419,12 @@ class NumVal PROTOBUF_FINAL :
   }
   inline void Swap(NumVal* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -422,57 +432,214 @@ class NumVal PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(NumVal* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline NumVal* New() const final {
-    return CreateMaybeMessage<NumVal>(nullptr);
-  }
-
-  NumVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  NumVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<NumVal>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const NumVal& from);
-  void MergeFrom(const NumVal& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const NumVal& from) {
+    NumVal::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(NumVal* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.NumVal";
   }
   protected:
-  explicit NumVal(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit NumVal(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
   ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kValueFieldNumber = 1,
+  };
+  // required int64 value = 1;
+  bool has_value() const;
   private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  int64_t value() const;
+  void set_value(int64_t value);
+  private:
+  int64_t _internal_value() const;
+  void _internal_set_value(int64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:romabuf.NumVal)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    int64_t value_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_protoloma_2eproto;
+};
+// -------------------------------------------------------------------
+
+class BoolVal final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.BoolVal) */ {
+ public:
+  inline BoolVal() : BoolVal(nullptr) {}
+  ~BoolVal() override;
+  explicit PROTOBUF_CONSTEXPR BoolVal(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  BoolVal(const BoolVal& from);
+  BoolVal(BoolVal&& from) noexcept
+    : BoolVal() {
+    *this = ::std::move(from);
+  }
+
+  inline BoolVal& operator=(const BoolVal& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline BoolVal& operator=(BoolVal&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const BoolVal& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const BoolVal* internal_default_instance() {
+    return reinterpret_cast<const BoolVal*>(
+               &_BoolVal_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(BoolVal& a, BoolVal& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(BoolVal* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(BoolVal* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  BoolVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<BoolVal>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const BoolVal& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const BoolVal& from) {
+    BoolVal::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(BoolVal* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "romabuf.BoolVal";
+  }
+  protected:
+  explicit BoolVal(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
@@ -480,38 +647,42 @@ class NumVal PROTOBUF_FINAL :
   enum : int {
     kValueFieldNumber = 1,
   };
-  // required int32 value = 1;
+  // required bool value = 1;
   bool has_value() const;
   private:
   bool _internal_has_value() const;
   public:
   void clear_value();
-  ::PROTOBUF_NAMESPACE_ID::int32 value() const;
-  void set_value(::PROTOBUF_NAMESPACE_ID::int32 value);
+  bool value() const;
+  void set_value(bool value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_value() const;
-  void _internal_set_value(::PROTOBUF_NAMESPACE_ID::int32 value);
+  bool _internal_value() const;
+  void _internal_set_value(bool value);
   public:
 
-  // @@protoc_insertion_point(class_scope:romabuf.NumVal)
+  // @@protoc_insertion_point(class_scope:romabuf.BoolVal)
  private:
   class _Internal;
 
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::int32 value_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    bool value_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class StrVal PROTOBUF_FINAL :
+class StrVal final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.StrVal) */ {
  public:
-  inline StrVal() : StrVal(nullptr) {};
-  virtual ~StrVal();
+  inline StrVal() : StrVal(nullptr) {}
+  ~StrVal() override;
+  explicit PROTOBUF_CONSTEXPR StrVal(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   StrVal(const StrVal& from);
   StrVal(StrVal&& from) noexcept
@@ -524,8 +695,13 @@ class StrVal PROTOBUF_FINAL :
     return *this;
   }
   inline StrVal& operator=(StrVal&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -543,27 +719,32 @@ class StrVal PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const StrVal& default_instance() {
+    return *internal_default_instance();
   }
-  static const StrVal& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const StrVal* internal_default_instance() {
     return reinterpret_cast<const StrVal*>(
                &_StrVal_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    2;
+    3;
 
   friend void swap(StrVal& a, StrVal& b) {
     a.Swap(&b);
   }
   inline void Swap(StrVal* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -571,56 +752,53 @@ class StrVal PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(StrVal* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline StrVal* New() const final {
-    return CreateMaybeMessage<StrVal>(nullptr);
-  }
-
-  StrVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  StrVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<StrVal>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const StrVal& from);
-  void MergeFrom(const StrVal& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const StrVal& from) {
+    StrVal::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(StrVal* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.StrVal";
   }
   protected:
-  explicit StrVal(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit StrVal(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -636,25 +814,14 @@ class StrVal PROTOBUF_FINAL :
   public:
   void clear_value();
   const std::string& value() const;
-  void set_value(const std::string& value);
-  void set_value(std::string&& value);
-  void set_value(const char* value);
-  void set_value(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_value(ArgT0&& arg0, ArgT... args);
   std::string* mutable_value();
-  std::string* release_value();
+  PROTOBUF_NODISCARD std::string* release_value();
   void set_allocated_value(std::string* value);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_value();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_value(
-      std::string* value);
   private:
   const std::string& _internal_value() const;
-  void _internal_set_value(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_value(const std::string& value);
   std::string* _internal_mutable_value();
   public:
 
@@ -665,18 +832,22 @@ class StrVal PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr value_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ListVal PROTOBUF_FINAL :
+class ListVal final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.ListVal) */ {
  public:
-  inline ListVal() : ListVal(nullptr) {};
-  virtual ~ListVal();
+  inline ListVal() : ListVal(nullptr) {}
+  ~ListVal() override;
+  explicit PROTOBUF_CONSTEXPR ListVal(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ListVal(const ListVal& from);
   ListVal(ListVal&& from) noexcept
@@ -689,8 +860,13 @@ class ListVal PROTOBUF_FINAL :
     return *this;
   }
   inline ListVal& operator=(ListVal&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -708,27 +884,32 @@ class ListVal PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ListVal& default_instance() {
+    return *internal_default_instance();
   }
-  static const ListVal& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const ListVal* internal_default_instance() {
     return reinterpret_cast<const ListVal*>(
                &_ListVal_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    3;
+    4;
 
   friend void swap(ListVal& a, ListVal& b) {
     a.Swap(&b);
   }
   inline void Swap(ListVal* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -736,56 +917,53 @@ class ListVal PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(ListVal* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline ListVal* New() const final {
-    return CreateMaybeMessage<ListVal>(nullptr);
-  }
-
-  ListVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  ListVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<ListVal>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ListVal& from);
-  void MergeFrom(const ListVal& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ListVal& from) {
+    ListVal::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(ListVal* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.ListVal";
   }
   protected:
-  explicit ListVal(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit ListVal(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -819,17 +997,21 @@ class ListVal PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue > values_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue > values_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class ERefVal PROTOBUF_FINAL :
+class ERefVal final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.ERefVal) */ {
  public:
-  inline ERefVal() : ERefVal(nullptr) {};
-  virtual ~ERefVal();
+  inline ERefVal() : ERefVal(nullptr) {}
+  ~ERefVal() override;
+  explicit PROTOBUF_CONSTEXPR ERefVal(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   ERefVal(const ERefVal& from);
   ERefVal(ERefVal&& from) noexcept
@@ -842,8 +1024,13 @@ class ERefVal PROTOBUF_FINAL :
     return *this;
   }
   inline ERefVal& operator=(ERefVal&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -861,27 +1048,32 @@ class ERefVal PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ERefVal& default_instance() {
+    return *internal_default_instance();
   }
-  static const ERefVal& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const ERefVal* internal_default_instance() {
     return reinterpret_cast<const ERefVal*>(
                &_ERefVal_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    4;
+    5;
 
   friend void swap(ERefVal& a, ERefVal& b) {
     a.Swap(&b);
   }
   inline void Swap(ERefVal* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -889,77 +1081,93 @@ class ERefVal PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(ERefVal* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline ERefVal* New() const final {
-    return CreateMaybeMessage<ERefVal>(nullptr);
-  }
-
-  ERefVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  ERefVal* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<ERefVal>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const ERefVal& from);
-  void MergeFrom(const ERefVal& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ERefVal& from) {
+    ERefVal::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(ERefVal* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.ERefVal";
   }
   protected:
-  explicit ERefVal(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit ERefVal(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   // accessors -------------------------------------------------------
 
   enum : int {
+    kEntityNameFieldNumber = 4,
     kNodeIdFieldNumber = 1,
     kVatIdFieldNumber = 2,
     kEntityIdFieldNumber = 3,
   };
+  // optional string entity_name = 4;
+  bool has_entity_name() const;
+  private:
+  bool _internal_has_entity_name() const;
+  public:
+  void clear_entity_name();
+  const std::string& entity_name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_entity_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_entity_name();
+  PROTOBUF_NODISCARD std::string* release_entity_name();
+  void set_allocated_entity_name(std::string* entity_name);
+  private:
+  const std::string& _internal_entity_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_entity_name(const std::string& value);
+  std::string* _internal_mutable_entity_name();
+  public:
+
   // required int32 node_id = 1;
   bool has_node_id() const;
   private:
   bool _internal_has_node_id() const;
   public:
   void clear_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id() const;
-  void set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t node_id() const;
+  void set_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_node_id() const;
-  void _internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_node_id() const;
+  void _internal_set_node_id(int32_t value);
   public:
 
   // required int32 vat_id = 2;
@@ -968,11 +1176,11 @@ class ERefVal PROTOBUF_FINAL :
   bool _internal_has_vat_id() const;
   public:
   void clear_vat_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 vat_id() const;
-  void set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t vat_id() const;
+  void set_vat_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_vat_id() const;
-  void _internal_set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_vat_id() const;
+  void _internal_set_vat_id(int32_t value);
   public:
 
   // required int32 entity_id = 3;
@@ -981,11 +1189,11 @@ class ERefVal PROTOBUF_FINAL :
   bool _internal_has_entity_id() const;
   public:
   void clear_entity_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 entity_id() const;
-  void set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t entity_id() const;
+  void set_entity_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_entity_id() const;
-  void _internal_set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_entity_id() const;
+  void _internal_set_entity_id(int32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.ERefVal)
@@ -998,20 +1206,25 @@ class ERefVal PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 vat_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 entity_id_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr entity_name_;
+    int32_t node_id_;
+    int32_t vat_id_;
+    int32_t entity_id_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class PValue PROTOBUF_FINAL :
+class PValue final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.PValue) */ {
  public:
-  inline PValue() : PValue(nullptr) {};
-  virtual ~PValue();
+  inline PValue() : PValue(nullptr) {}
+  ~PValue() override;
+  explicit PROTOBUF_CONSTEXPR PValue(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   PValue(const PValue& from);
   PValue(PValue&& from) noexcept
@@ -1024,8 +1237,13 @@ class PValue PROTOBUF_FINAL :
     return *this;
   }
   inline PValue& operator=(PValue&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1043,35 +1261,41 @@ class PValue PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PValue& default_instance() {
+    return *internal_default_instance();
   }
-  static const PValue& default_instance();
-
   enum ValueCase {
     kNumVal = 1,
     kStrVal = 2,
     kErefVal = 3,
     kListVal = 4,
+    kBoolVal = 5,
     VALUE_NOT_SET = 0,
   };
 
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const PValue* internal_default_instance() {
     return reinterpret_cast<const PValue*>(
                &_PValue_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    5;
+    6;
 
   friend void swap(PValue& a, PValue& b) {
     a.Swap(&b);
   }
   inline void Swap(PValue* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1079,56 +1303,53 @@ class PValue PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(PValue* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline PValue* New() const final {
-    return CreateMaybeMessage<PValue>(nullptr);
-  }
-
-  PValue* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  PValue* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<PValue>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const PValue& from);
-  void MergeFrom(const PValue& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PValue& from) {
+    PValue::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(PValue* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.PValue";
   }
   protected:
-  explicit PValue(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit PValue(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1139,6 +1360,7 @@ class PValue PROTOBUF_FINAL :
     kStrValFieldNumber = 2,
     kErefValFieldNumber = 3,
     kListValFieldNumber = 4,
+    kBoolValFieldNumber = 5,
   };
   // .romabuf.NumVal num_val = 1;
   bool has_num_val() const;
@@ -1147,7 +1369,7 @@ class PValue PROTOBUF_FINAL :
   public:
   void clear_num_val();
   const ::romabuf::NumVal& num_val() const;
-  ::romabuf::NumVal* release_num_val();
+  PROTOBUF_NODISCARD ::romabuf::NumVal* release_num_val();
   ::romabuf::NumVal* mutable_num_val();
   void set_allocated_num_val(::romabuf::NumVal* num_val);
   private:
@@ -1165,7 +1387,7 @@ class PValue PROTOBUF_FINAL :
   public:
   void clear_str_val();
   const ::romabuf::StrVal& str_val() const;
-  ::romabuf::StrVal* release_str_val();
+  PROTOBUF_NODISCARD ::romabuf::StrVal* release_str_val();
   ::romabuf::StrVal* mutable_str_val();
   void set_allocated_str_val(::romabuf::StrVal* str_val);
   private:
@@ -1183,7 +1405,7 @@ class PValue PROTOBUF_FINAL :
   public:
   void clear_eref_val();
   const ::romabuf::ERefVal& eref_val() const;
-  ::romabuf::ERefVal* release_eref_val();
+  PROTOBUF_NODISCARD ::romabuf::ERefVal* release_eref_val();
   ::romabuf::ERefVal* mutable_eref_val();
   void set_allocated_eref_val(::romabuf::ERefVal* eref_val);
   private:
@@ -1201,7 +1423,7 @@ class PValue PROTOBUF_FINAL :
   public:
   void clear_list_val();
   const ::romabuf::ListVal& list_val() const;
-  ::romabuf::ListVal* release_list_val();
+  PROTOBUF_NODISCARD ::romabuf::ListVal* release_list_val();
   ::romabuf::ListVal* mutable_list_val();
   void set_allocated_list_val(::romabuf::ListVal* list_val);
   private:
@@ -1212,6 +1434,24 @@ class PValue PROTOBUF_FINAL :
       ::romabuf::ListVal* list_val);
   ::romabuf::ListVal* unsafe_arena_release_list_val();
 
+  // .romabuf.BoolVal bool_val = 5;
+  bool has_bool_val() const;
+  private:
+  bool _internal_has_bool_val() const;
+  public:
+  void clear_bool_val();
+  const ::romabuf::BoolVal& bool_val() const;
+  PROTOBUF_NODISCARD ::romabuf::BoolVal* release_bool_val();
+  ::romabuf::BoolVal* mutable_bool_val();
+  void set_allocated_bool_val(::romabuf::BoolVal* bool_val);
+  private:
+  const ::romabuf::BoolVal& _internal_bool_val() const;
+  ::romabuf::BoolVal* _internal_mutable_bool_val();
+  public:
+  void unsafe_arena_set_allocated_bool_val(
+      ::romabuf::BoolVal* bool_val);
+  ::romabuf::BoolVal* unsafe_arena_release_bool_val();
+
   void clear_value();
   ValueCase value_case() const;
   // @@protoc_insertion_point(class_scope:romabuf.PValue)
@@ -1221,6 +1461,7 @@ class PValue PROTOBUF_FINAL :
   void set_has_str_val();
   void set_has_eref_val();
   void set_has_list_val();
+  void set_has_bool_val();
 
   inline bool has_value() const;
   inline void clear_has_value();
@@ -1228,25 +1469,31 @@ class PValue PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  union ValueUnion {
-    ValueUnion() {}
-    ::romabuf::NumVal* num_val_;
-    ::romabuf::StrVal* str_val_;
-    ::romabuf::ERefVal* eref_val_;
-    ::romabuf::ListVal* list_val_;
-  } value_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::uint32 _oneof_case_[1];
+  struct Impl_ {
+    union ValueUnion {
+      constexpr ValueUnion() : _constinit_{} {}
+        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+      ::romabuf::NumVal* num_val_;
+      ::romabuf::StrVal* str_val_;
+      ::romabuf::ERefVal* eref_val_;
+      ::romabuf::ListVal* list_val_;
+      ::romabuf::BoolVal* bool_val_;
+    } value_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint32_t _oneof_case_[1];
 
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class PleromaMessage PROTOBUF_FINAL :
+class PleromaMessage final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.PleromaMessage) */ {
  public:
-  inline PleromaMessage() : PleromaMessage(nullptr) {};
-  virtual ~PleromaMessage();
+  inline PleromaMessage() : PleromaMessage(nullptr) {}
+  ~PleromaMessage() override;
+  explicit PROTOBUF_CONSTEXPR PleromaMessage(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   PleromaMessage(const PleromaMessage& from);
   PleromaMessage(PleromaMessage&& from) noexcept
@@ -1259,8 +1506,13 @@ class PleromaMessage PROTOBUF_FINAL :
     return *this;
   }
   inline PleromaMessage& operator=(PleromaMessage&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1278,35 +1530,41 @@ class PleromaMessage PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PleromaMessage& default_instance() {
+    return *internal_default_instance();
   }
-  static const PleromaMessage& default_instance();
-
   enum MsgCase {
     kCall = 1,
     kAnnouncePeer = 2,
     kAssignClusterInfo = 3,
     kHostInfo = 4,
+    kCallBatch = 5,
     MSG_NOT_SET = 0,
   };
 
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const PleromaMessage* internal_default_instance() {
     return reinterpret_cast<const PleromaMessage*>(
                &_PleromaMessage_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    6;
+    7;
 
   friend void swap(PleromaMessage& a, PleromaMessage& b) {
     a.Swap(&b);
   }
   inline void Swap(PleromaMessage* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1314,56 +1572,53 @@ class PleromaMessage PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(PleromaMessage* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline PleromaMessage* New() const final {
-    return CreateMaybeMessage<PleromaMessage>(nullptr);
-  }
-
-  PleromaMessage* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  PleromaMessage* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<PleromaMessage>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const PleromaMessage& from);
-  void MergeFrom(const PleromaMessage& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const PleromaMessage& from) {
+    PleromaMessage::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(PleromaMessage* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.PleromaMessage";
   }
   protected:
-  explicit PleromaMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit PleromaMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1374,6 +1629,7 @@ class PleromaMessage PROTOBUF_FINAL :
     kAnnouncePeerFieldNumber = 2,
     kAssignClusterInfoFieldNumber = 3,
     kHostInfoFieldNumber = 4,
+    kCallBatchFieldNumber = 5,
   };
   // .romabuf.Call call = 1;
   bool has_call() const;
@@ -1382,7 +1638,7 @@ class PleromaMessage PROTOBUF_FINAL :
   public:
   void clear_call();
   const ::romabuf::Call& call() const;
-  ::romabuf::Call* release_call();
+  PROTOBUF_NODISCARD ::romabuf::Call* release_call();
   ::romabuf::Call* mutable_call();
   void set_allocated_call(::romabuf::Call* call);
   private:
@@ -1400,7 +1656,7 @@ class PleromaMessage PROTOBUF_FINAL :
   public:
   void clear_announce_peer();
   const ::romabuf::AnnouncePeer& announce_peer() const;
-  ::romabuf::AnnouncePeer* release_announce_peer();
+  PROTOBUF_NODISCARD ::romabuf::AnnouncePeer* release_announce_peer();
   ::romabuf::AnnouncePeer* mutable_announce_peer();
   void set_allocated_announce_peer(::romabuf::AnnouncePeer* announce_peer);
   private:
@@ -1418,7 +1674,7 @@ class PleromaMessage PROTOBUF_FINAL :
   public:
   void clear_assign_cluster_info();
   const ::romabuf::AssignClusterInfo& assign_cluster_info() const;
-  ::romabuf::AssignClusterInfo* release_assign_cluster_info();
+  PROTOBUF_NODISCARD ::romabuf::AssignClusterInfo* release_assign_cluster_info();
   ::romabuf::AssignClusterInfo* mutable_assign_cluster_info();
   void set_allocated_assign_cluster_info(::romabuf::AssignClusterInfo* assign_cluster_info);
   private:
@@ -1436,7 +1692,7 @@ class PleromaMessage PROTOBUF_FINAL :
   public:
   void clear_host_info();
   const ::romabuf::HostInfo& host_info() const;
-  ::romabuf::HostInfo* release_host_info();
+  PROTOBUF_NODISCARD ::romabuf::HostInfo* release_host_info();
   ::romabuf::HostInfo* mutable_host_info();
   void set_allocated_host_info(::romabuf::HostInfo* host_info);
   private:
@@ -1447,6 +1703,24 @@ class PleromaMessage PROTOBUF_FINAL :
       ::romabuf::HostInfo* host_info);
   ::romabuf::HostInfo* unsafe_arena_release_host_info();
 
+  // .romabuf.CallBatch call_batch = 5;
+  bool has_call_batch() const;
+  private:
+  bool _internal_has_call_batch() const;
+  public:
+  void clear_call_batch();
+  const ::romabuf::CallBatch& call_batch() const;
+  PROTOBUF_NODISCARD ::romabuf::CallBatch* release_call_batch();
+  ::romabuf::CallBatch* mutable_call_batch();
+  void set_allocated_call_batch(::romabuf::CallBatch* call_batch);
+  private:
+  const ::romabuf::CallBatch& _internal_call_batch() const;
+  ::romabuf::CallBatch* _internal_mutable_call_batch();
+  public:
+  void unsafe_arena_set_allocated_call_batch(
+      ::romabuf::CallBatch* call_batch);
+  ::romabuf::CallBatch* unsafe_arena_release_call_batch();
+
   void clear_msg();
   MsgCase msg_case() const;
   // @@protoc_insertion_point(class_scope:romabuf.PleromaMessage)
@@ -1456,6 +1730,7 @@ class PleromaMessage PROTOBUF_FINAL :
   void set_has_announce_peer();
   void set_has_assign_cluster_info();
   void set_has_host_info();
+  void set_has_call_batch();
 
   inline bool has_msg() const;
   inline void clear_has_msg();
@@ -1463,25 +1738,31 @@ class PleromaMessage PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  union MsgUnion {
-    MsgUnion() {}
-    ::romabuf::Call* call_;
-    ::romabuf::AnnouncePeer* announce_peer_;
-    ::romabuf::AssignClusterInfo* assign_cluster_info_;
-    ::romabuf::HostInfo* host_info_;
-  } msg_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::uint32 _oneof_case_[1];
+  struct Impl_ {
+    union MsgUnion {
+      constexpr MsgUnion() : _constinit_{} {}
+        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+      ::romabuf::Call* call_;
+      ::romabuf::AnnouncePeer* announce_peer_;
+      ::romabuf::AssignClusterInfo* assign_cluster_info_;
+      ::romabuf::HostInfo* host_info_;
+      ::romabuf::CallBatch* call_batch_;
+    } msg_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint32_t _oneof_case_[1];
 
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Call PROTOBUF_FINAL :
+class Call final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.Call) */ {
  public:
-  inline Call() : Call(nullptr) {};
-  virtual ~Call();
+  inline Call() : Call(nullptr) {}
+  ~Call() override;
+  explicit PROTOBUF_CONSTEXPR Call(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Call(const Call& from);
   Call(Call&& from) noexcept
@@ -1494,8 +1775,13 @@ class Call PROTOBUF_FINAL :
     return *this;
   }
   inline Call& operator=(Call&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1513,27 +1799,32 @@ class Call PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Call& default_instance() {
+    return *internal_default_instance();
   }
-  static const Call& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const Call* internal_default_instance() {
     return reinterpret_cast<const Call*>(
                &_Call_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    7;
+    8;
 
   friend void swap(Call& a, Call& b) {
     a.Swap(&b);
   }
   inline void Swap(Call* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1541,56 +1832,53 @@ class Call PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(Call* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline Call* New() const final {
-    return CreateMaybeMessage<Call>(nullptr);
-  }
-
-  Call* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  Call* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Call>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Call& from);
-  void MergeFrom(const Call& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Call& from) {
+    Call::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Call* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.Call";
   }
   protected:
-  explicit Call(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit Call(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1634,54 +1922,32 @@ class Call PROTOBUF_FINAL :
   public:
   void clear_function_id();
   const std::string& function_id() const;
-  void set_function_id(const std::string& value);
-  void set_function_id(std::string&& value);
-  void set_function_id(const char* value);
-  void set_function_id(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_function_id(ArgT0&& arg0, ArgT... args);
   std::string* mutable_function_id();
-  std::string* release_function_id();
+  PROTOBUF_NODISCARD std::string* release_function_id();
   void set_allocated_function_id(std::string* function_id);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_function_id();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_function_id(
-      std::string* function_id);
   private:
   const std::string& _internal_function_id() const;
-  void _internal_set_function_id(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_function_id(const std::string& value);
   std::string* _internal_mutable_function_id();
   public:
 
-  // required string src_function_id = 8;
+  // optional string src_function_id = 8;
   bool has_src_function_id() const;
   private:
   bool _internal_has_src_function_id() const;
   public:
   void clear_src_function_id();
   const std::string& src_function_id() const;
-  void set_src_function_id(const std::string& value);
-  void set_src_function_id(std::string&& value);
-  void set_src_function_id(const char* value);
-  void set_src_function_id(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_src_function_id(ArgT0&& arg0, ArgT... args);
   std::string* mutable_src_function_id();
-  std::string* release_src_function_id();
+  PROTOBUF_NODISCARD std::string* release_src_function_id();
   void set_allocated_src_function_id(std::string* src_function_id);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_src_function_id();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_src_function_id(
-      std::string* src_function_id);
   private:
   const std::string& _internal_src_function_id() const;
-  void _internal_set_src_function_id(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_src_function_id(const std::string& value);
   std::string* _internal_mutable_src_function_id();
   public:
 
@@ -1691,11 +1957,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_node_id() const;
   public:
   void clear_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id() const;
-  void set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t node_id() const;
+  void set_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_node_id() const;
-  void _internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_node_id() const;
+  void _internal_set_node_id(int32_t value);
   public:
 
   // required int32 vat_id = 2;
@@ -1704,11 +1970,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_vat_id() const;
   public:
   void clear_vat_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 vat_id() const;
-  void set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t vat_id() const;
+  void set_vat_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_vat_id() const;
-  void _internal_set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_vat_id() const;
+  void _internal_set_vat_id(int32_t value);
   public:
 
   // required int32 entity_id = 3;
@@ -1717,11 +1983,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_entity_id() const;
   public:
   void clear_entity_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 entity_id() const;
-  void set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t entity_id() const;
+  void set_entity_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_entity_id() const;
-  void _internal_set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_entity_id() const;
+  void _internal_set_entity_id(int32_t value);
   public:
 
   // required int32 src_node_id = 5;
@@ -1730,11 +1996,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_src_node_id() const;
   public:
   void clear_src_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 src_node_id() const;
-  void set_src_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t src_node_id() const;
+  void set_src_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_src_node_id() const;
-  void _internal_set_src_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_src_node_id() const;
+  void _internal_set_src_node_id(int32_t value);
   public:
 
   // required int32 src_vat_id = 6;
@@ -1743,11 +2009,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_src_vat_id() const;
   public:
   void clear_src_vat_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 src_vat_id() const;
-  void set_src_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t src_vat_id() const;
+  void set_src_vat_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_src_vat_id() const;
-  void _internal_set_src_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_src_vat_id() const;
+  void _internal_set_src_vat_id(int32_t value);
   public:
 
   // required int32 src_entity_id = 7;
@@ -1756,11 +2022,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_src_entity_id() const;
   public:
   void clear_src_entity_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 src_entity_id() const;
-  void set_src_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t src_entity_id() const;
+  void set_src_entity_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_src_entity_id() const;
-  void _internal_set_src_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_src_entity_id() const;
+  void _internal_set_src_entity_id(int32_t value);
   public:
 
   // required bool response = 9;
@@ -1782,11 +2048,11 @@ class Call PROTOBUF_FINAL :
   bool _internal_has_promise_id() const;
   public:
   void clear_promise_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 promise_id() const;
-  void set_promise_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t promise_id() const;
+  void set_promise_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_promise_id() const;
-  void _internal_set_promise_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_promise_id() const;
+  void _internal_set_promise_id(int32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.Call)
@@ -1799,28 +2065,196 @@ class Call PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue > pvalues_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr function_id_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr src_function_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 vat_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 entity_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 src_node_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 src_vat_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 src_entity_id_;
-  bool response_;
-  ::PROTOBUF_NAMESPACE_ID::int32 promise_id_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue > pvalues_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr function_id_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr src_function_id_;
+    int32_t node_id_;
+    int32_t vat_id_;
+    int32_t entity_id_;
+    int32_t src_node_id_;
+    int32_t src_vat_id_;
+    int32_t src_entity_id_;
+    bool response_;
+    int32_t promise_id_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class AnnouncePeer PROTOBUF_FINAL :
+class CallBatch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.CallBatch) */ {
+ public:
+  inline CallBatch() : CallBatch(nullptr) {}
+  ~CallBatch() override;
+  explicit PROTOBUF_CONSTEXPR CallBatch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  CallBatch(const CallBatch& from);
+  CallBatch(CallBatch&& from) noexcept
+    : CallBatch() {
+    *this = ::std::move(from);
+  }
+
+  inline CallBatch& operator=(const CallBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline CallBatch& operator=(CallBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const CallBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const CallBatch* internal_default_instance() {
+    return reinterpret_cast<const CallBatch*>(
+               &_CallBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(CallBatch& a, CallBatch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(CallBatch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(CallBatch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  CallBatch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<CallBatch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const CallBatch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const CallBatch& from) {
+    CallBatch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(CallBatch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "romabuf.CallBatch";
+  }
+  protected:
+  explicit CallBatch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kCallsFieldNumber = 1,
+  };
+  // repeated .romabuf.Call calls = 1;
+  int calls_size() const;
+  private:
+  int _internal_calls_size() const;
+  public:
+  void clear_calls();
+  ::romabuf::Call* mutable_calls(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::Call >*
+      mutable_calls();
+  private:
+  const ::romabuf::Call& _internal_calls(int index) const;
+  ::romabuf::Call* _internal_add_calls();
+  public:
+  const ::romabuf::Call& calls(int index) const;
+  ::romabuf::Call* add_calls();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::Call >&
+      calls() const;
+
+  // @@protoc_insertion_point(class_scope:romabuf.CallBatch)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::Call > calls_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_protoloma_2eproto;
+};
+// -------------------------------------------------------------------
+
+class AnnouncePeer final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.AnnouncePeer) */ {
  public:
-  inline AnnouncePeer() : AnnouncePeer(nullptr) {};
-  virtual ~AnnouncePeer();
+  inline AnnouncePeer() : AnnouncePeer(nullptr) {}
+  ~AnnouncePeer() override;
+  explicit PROTOBUF_CONSTEXPR AnnouncePeer(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   AnnouncePeer(const AnnouncePeer& from);
   AnnouncePeer(AnnouncePeer&& from) noexcept
@@ -1833,8 +2267,13 @@ class AnnouncePeer PROTOBUF_FINAL :
     return *this;
   }
   inline AnnouncePeer& operator=(AnnouncePeer&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -1852,27 +2291,32 @@ class AnnouncePeer PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const AnnouncePeer& default_instance() {
+    return *internal_default_instance();
   }
-  static const AnnouncePeer& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const AnnouncePeer* internal_default_instance() {
     return reinterpret_cast<const AnnouncePeer*>(
                &_AnnouncePeer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    8;
+    10;
 
   friend void swap(AnnouncePeer& a, AnnouncePeer& b) {
     a.Swap(&b);
   }
   inline void Swap(AnnouncePeer* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -1880,56 +2324,53 @@ class AnnouncePeer PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(AnnouncePeer* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline AnnouncePeer* New() const final {
-    return CreateMaybeMessage<AnnouncePeer>(nullptr);
-  }
-
-  AnnouncePeer* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  AnnouncePeer* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<AnnouncePeer>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const AnnouncePeer& from);
-  void MergeFrom(const AnnouncePeer& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const AnnouncePeer& from) {
+    AnnouncePeer::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(AnnouncePeer* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.AnnouncePeer";
   }
   protected:
-  explicit AnnouncePeer(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit AnnouncePeer(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -1938,6 +2379,7 @@ class AnnouncePeer PROTOBUF_FINAL :
   enum : int {
     kAddressFieldNumber = 1,
     kPortFieldNumber = 2,
+    kNodeIdFieldNumber = 3,
   };
   // required string address = 1;
   bool has_address() const;
@@ -1946,25 +2388,14 @@ class AnnouncePeer PROTOBUF_FINAL :
   public:
   void clear_address();
   const std::string& address() const;
-  void set_address(const std::string& value);
-  void set_address(std::string&& value);
-  void set_address(const char* value);
-  void set_address(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_address(ArgT0&& arg0, ArgT... args);
   std::string* mutable_address();
-  std::string* release_address();
+  PROTOBUF_NODISCARD std::string* release_address();
   void set_allocated_address(std::string* address);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_address();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_address(
-      std::string* address);
   private:
   const std::string& _internal_address() const;
-  void _internal_set_address(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_address(const std::string& value);
   std::string* _internal_mutable_address();
   public:
 
@@ -1974,11 +2405,24 @@ class AnnouncePeer PROTOBUF_FINAL :
   bool _internal_has_port() const;
   public:
   void clear_port();
-  ::PROTOBUF_NAMESPACE_ID::uint32 port() const;
-  void set_port(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t port() const;
+  void set_port(uint32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint32 _internal_port() const;
-  void _internal_set_port(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t _internal_port() const;
+  void _internal_set_port(uint32_t value);
+  public:
+
+  // optional int32 node_id = 3;
+  bool has_node_id() const;
+  private:
+  bool _internal_has_node_id() const;
+  public:
+  void clear_node_id();
+  int32_t node_id() const;
+  void set_node_id(int32_t value);
+  private:
+  int32_t _internal_node_id() const;
+  void _internal_set_node_id(int32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.AnnouncePeer)
@@ -1991,19 +2435,24 @@ class AnnouncePeer PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr address_;
-  ::PROTOBUF_NAMESPACE_ID::uint32 port_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr address_;
+    uint32_t port_;
+    int32_t node_id_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class AssignClusterInfo PROTOBUF_FINAL :
+class AssignClusterInfo final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.AssignClusterInfo) */ {
  public:
-  inline AssignClusterInfo() : AssignClusterInfo(nullptr) {};
-  virtual ~AssignClusterInfo();
+  inline AssignClusterInfo() : AssignClusterInfo(nullptr) {}
+  ~AssignClusterInfo() override;
+  explicit PROTOBUF_CONSTEXPR AssignClusterInfo(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   AssignClusterInfo(const AssignClusterInfo& from);
   AssignClusterInfo(AssignClusterInfo&& from) noexcept
@@ -2016,8 +2465,13 @@ class AssignClusterInfo PROTOBUF_FINAL :
     return *this;
   }
   inline AssignClusterInfo& operator=(AssignClusterInfo&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -2035,27 +2489,32 @@ class AssignClusterInfo PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const AssignClusterInfo& default_instance() {
+    return *internal_default_instance();
   }
-  static const AssignClusterInfo& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const AssignClusterInfo* internal_default_instance() {
     return reinterpret_cast<const AssignClusterInfo*>(
                &_AssignClusterInfo_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    9;
+    11;
 
   friend void swap(AssignClusterInfo& a, AssignClusterInfo& b) {
     a.Swap(&b);
   }
   inline void Swap(AssignClusterInfo* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -2063,56 +2522,53 @@ class AssignClusterInfo PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(AssignClusterInfo* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
-  // implements Message ----------------------------------------------
-
-  inline AssignClusterInfo* New() const final {
-    return CreateMaybeMessage<AssignClusterInfo>(nullptr);
-  }
+  // implements Message ----------------------------------------------
 
-  AssignClusterInfo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  AssignClusterInfo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<AssignClusterInfo>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const AssignClusterInfo& from);
-  void MergeFrom(const AssignClusterInfo& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const AssignClusterInfo& from) {
+    AssignClusterInfo::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(AssignClusterInfo* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.AssignClusterInfo";
   }
   protected:
-  explicit AssignClusterInfo(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit AssignClusterInfo(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -2149,11 +2605,11 @@ class AssignClusterInfo PROTOBUF_FINAL :
   bool _internal_has_node_id() const;
   public:
   void clear_node_id();
-  ::PROTOBUF_NAMESPACE_ID::uint32 node_id() const;
-  void set_node_id(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t node_id() const;
+  void set_node_id(uint32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint32 _internal_node_id() const;
-  void _internal_set_node_id(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  uint32_t _internal_node_id() const;
+  void _internal_set_node_id(uint32_t value);
   public:
 
   // required int32 monad_node_id = 2;
@@ -2162,11 +2618,11 @@ class AssignClusterInfo PROTOBUF_FINAL :
   bool _internal_has_monad_node_id() const;
   public:
   void clear_monad_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_node_id() const;
-  void set_monad_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t monad_node_id() const;
+  void set_monad_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_monad_node_id() const;
-  void _internal_set_monad_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_monad_node_id() const;
+  void _internal_set_monad_node_id(int32_t value);
   public:
 
   // required int32 monad_vat_id = 3;
@@ -2175,11 +2631,11 @@ class AssignClusterInfo PROTOBUF_FINAL :
   bool _internal_has_monad_vat_id() const;
   public:
   void clear_monad_vat_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_vat_id() const;
-  void set_monad_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t monad_vat_id() const;
+  void set_monad_vat_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_monad_vat_id() const;
-  void _internal_set_monad_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_monad_vat_id() const;
+  void _internal_set_monad_vat_id(int32_t value);
   public:
 
   // required int32 monad_entity_id = 4;
@@ -2188,11 +2644,11 @@ class AssignClusterInfo PROTOBUF_FINAL :
   bool _internal_has_monad_entity_id() const;
   public:
   void clear_monad_entity_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_entity_id() const;
-  void set_monad_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t monad_entity_id() const;
+  void set_monad_entity_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_monad_entity_id() const;
-  void _internal_set_monad_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_monad_entity_id() const;
+  void _internal_set_monad_entity_id(int32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.AssignClusterInfo)
@@ -2205,22 +2661,26 @@ class AssignClusterInfo PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::HostInfo > nodes_;
-  ::PROTOBUF_NAMESPACE_ID::uint32 node_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_node_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_vat_id_;
-  ::PROTOBUF_NAMESPACE_ID::int32 monad_entity_id_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::HostInfo > nodes_;
+    uint32_t node_id_;
+    int32_t monad_node_id_;
+    int32_t monad_vat_id_;
+    int32_t monad_entity_id_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Greeting PROTOBUF_FINAL :
+class Greeting final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.Greeting) */ {
  public:
-  inline Greeting() : Greeting(nullptr) {};
-  virtual ~Greeting();
+  inline Greeting() : Greeting(nullptr) {}
+  ~Greeting() override;
+  explicit PROTOBUF_CONSTEXPR Greeting(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Greeting(const Greeting& from);
   Greeting(Greeting&& from) noexcept
@@ -2233,8 +2693,13 @@ class Greeting PROTOBUF_FINAL :
     return *this;
   }
   inline Greeting& operator=(Greeting&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -2252,27 +2717,32 @@ class Greeting PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Greeting& default_instance() {
+    return *internal_default_instance();
   }
-  static const Greeting& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const Greeting* internal_default_instance() {
     return reinterpret_cast<const Greeting*>(
                &_Greeting_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    10;
+    12;
 
   friend void swap(Greeting& a, Greeting& b) {
     a.Swap(&b);
   }
   inline void Swap(Greeting* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -2280,56 +2750,53 @@ class Greeting PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(Greeting* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline Greeting* New() const final {
-    return CreateMaybeMessage<Greeting>(nullptr);
-  }
-
-  Greeting* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  Greeting* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Greeting>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Greeting& from);
-  void MergeFrom(const Greeting& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Greeting& from) {
+    Greeting::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(Greeting* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.Greeting";
   }
   protected:
-  explicit Greeting(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit Greeting(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -2345,25 +2812,14 @@ class Greeting PROTOBUF_FINAL :
   public:
   void clear_node_name();
   const std::string& node_name() const;
-  void set_node_name(const std::string& value);
-  void set_node_name(std::string&& value);
-  void set_node_name(const char* value);
-  void set_node_name(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_node_name(ArgT0&& arg0, ArgT... args);
   std::string* mutable_node_name();
-  std::string* release_node_name();
+  PROTOBUF_NODISCARD std::string* release_node_name();
   void set_allocated_node_name(std::string* node_name);
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  std::string* unsafe_arena_release_node_name();
-  GOOGLE_PROTOBUF_RUNTIME_DEPRECATED("The unsafe_arena_ accessors for"
-  "    string fields are deprecated and will be removed in a"
-  "    future release.")
-  void unsafe_arena_set_allocated_node_name(
-      std::string* node_name);
   private:
   const std::string& _internal_node_name() const;
-  void _internal_set_node_name(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_node_name(const std::string& value);
   std::string* _internal_mutable_node_name();
   public:
 
@@ -2374,18 +2830,22 @@ class Greeting PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr node_name_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr node_name_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class GreetingAck PROTOBUF_FINAL :
+class GreetingAck final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.GreetingAck) */ {
  public:
-  inline GreetingAck() : GreetingAck(nullptr) {};
-  virtual ~GreetingAck();
+  inline GreetingAck() : GreetingAck(nullptr) {}
+  ~GreetingAck() override;
+  explicit PROTOBUF_CONSTEXPR GreetingAck(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   GreetingAck(const GreetingAck& from);
   GreetingAck(GreetingAck&& from) noexcept
@@ -2398,8 +2858,13 @@ class GreetingAck PROTOBUF_FINAL :
     return *this;
   }
   inline GreetingAck& operator=(GreetingAck&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -2417,27 +2882,32 @@ class GreetingAck PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GreetingAck& default_instance() {
+    return *internal_default_instance();
   }
-  static const GreetingAck& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const GreetingAck* internal_default_instance() {
     return reinterpret_cast<const GreetingAck*>(
                &_GreetingAck_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    11;
+    13;
 
   friend void swap(GreetingAck& a, GreetingAck& b) {
     a.Swap(&b);
   }
   inline void Swap(GreetingAck* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -2445,56 +2915,53 @@ class GreetingAck PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(GreetingAck* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline GreetingAck* New() const final {
-    return CreateMaybeMessage<GreetingAck>(nullptr);
-  }
-
-  GreetingAck* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  GreetingAck* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<GreetingAck>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const GreetingAck& from);
-  void MergeFrom(const GreetingAck& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GreetingAck& from) {
+    GreetingAck::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(GreetingAck* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.GreetingAck";
   }
   protected:
-  explicit GreetingAck(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit GreetingAck(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -2509,11 +2976,11 @@ class GreetingAck PROTOBUF_FINAL :
   bool _internal_has_node_id() const;
   public:
   void clear_node_id();
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id() const;
-  void set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t node_id() const;
+  void set_node_id(int32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_node_id() const;
-  void _internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t _internal_node_id() const;
+  void _internal_set_node_id(int32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:romabuf.GreetingAck)
@@ -2523,18 +2990,21 @@ class GreetingAck PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-  ::PROTOBUF_NAMESPACE_ID::int32 node_id_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    int32_t node_id_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // -------------------------------------------------------------------
 
-class LoadProgram PROTOBUF_FINAL :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:romabuf.LoadProgram) */ {
+class LoadProgram final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:romabuf.LoadProgram) */ {
  public:
-  inline LoadProgram() : LoadProgram(nullptr) {};
-  virtual ~LoadProgram();
+  inline LoadProgram() : LoadProgram(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR LoadProgram(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   LoadProgram(const LoadProgram& from);
   LoadProgram(LoadProgram&& from) noexcept
@@ -2547,8 +3017,13 @@ class LoadProgram PROTOBUF_FINAL :
     return *this;
   }
   inline LoadProgram& operator=(LoadProgram&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -2566,27 +3041,32 @@ class LoadProgram PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LoadProgram& default_instance() {
+    return *internal_default_instance();
   }
-  static const LoadProgram& default_instance();
-
-  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
   static inline const LoadProgram* internal_default_instance() {
     return reinterpret_cast<const LoadProgram*>(
                &_LoadProgram_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    12;
+    14;
 
   friend void swap(LoadProgram& a, LoadProgram& b) {
     a.Swap(&b);
   }
   inline void Swap(LoadProgram* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -2594,56 +3074,39 @@ class LoadProgram PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(LoadProgram* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline LoadProgram* New() const final {
-    return CreateMaybeMessage<LoadProgram>(nullptr);
-  }
-
-  LoadProgram* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  LoadProgram* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<LoadProgram>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void CopyFrom(const LoadProgram& from);
-  void MergeFrom(const LoadProgram& from);
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const LoadProgram& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const LoadProgram& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(LoadProgram* other);
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "romabuf.LoadProgram";
   }
   protected:
-  explicit LoadProgram(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit LoadProgram(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_protoloma_2eproto);
-    return ::descriptor_table_protoloma_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -2656,7 +3119,8 @@ class LoadProgram PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+  };
   friend struct ::TableStruct_protoloma_2eproto;
 };
 // ===================================================================
@@ -2672,170 +3136,145 @@ class LoadProgram PROTOBUF_FINAL :
 
 // required int32 node_id = 1;
 inline bool HostInfo::_internal_has_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool HostInfo::has_node_id() const {
   return _internal_has_node_id();
 }
 inline void HostInfo::clear_node_id() {
-  node_id_ = 0;
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 HostInfo::_internal_node_id() const {
-  return node_id_;
+inline int32_t HostInfo::_internal_node_id() const {
+  return _impl_.node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 HostInfo::node_id() const {
+inline int32_t HostInfo::node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.HostInfo.node_id)
   return _internal_node_id();
 }
-inline void HostInfo::_internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000004u;
-  node_id_ = value;
+inline void HostInfo::_internal_set_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.node_id_ = value;
 }
-inline void HostInfo::set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void HostInfo::set_node_id(int32_t value) {
   _internal_set_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.HostInfo.node_id)
 }
 
 // required string address = 2;
 inline bool HostInfo::_internal_has_address() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool HostInfo::has_address() const {
   return _internal_has_address();
 }
 inline void HostInfo::clear_address() {
-  address_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.address_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& HostInfo::address() const {
   // @@protoc_insertion_point(field_get:romabuf.HostInfo.address)
   return _internal_address();
 }
-inline void HostInfo::set_address(const std::string& value) {
-  _internal_set_address(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HostInfo::set_address(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.address_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.HostInfo.address)
 }
 inline std::string* HostInfo::mutable_address() {
+  std::string* _s = _internal_mutable_address();
   // @@protoc_insertion_point(field_mutable:romabuf.HostInfo.address)
-  return _internal_mutable_address();
+  return _s;
 }
 inline const std::string& HostInfo::_internal_address() const {
-  return address_.Get();
+  return _impl_.address_.Get();
 }
 inline void HostInfo::_internal_set_address(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void HostInfo::set_address(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.HostInfo.address)
-}
-inline void HostInfo::set_address(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.HostInfo.address)
-}
-inline void HostInfo::set_address(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.HostInfo.address)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.address_.Set(value, GetArenaForAllocation());
 }
 inline std::string* HostInfo::_internal_mutable_address() {
-  _has_bits_[0] |= 0x00000001u;
-  return address_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.address_.Mutable(GetArenaForAllocation());
 }
 inline std::string* HostInfo::release_address() {
   // @@protoc_insertion_point(field_release:romabuf.HostInfo.address)
   if (!_internal_has_address()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return address_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.address_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void HostInfo::set_allocated_address(std::string* address) {
   if (address != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  address_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), address,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.HostInfo.address)
-}
-inline std::string* HostInfo::unsafe_arena_release_address() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.HostInfo.address)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000001u;
-  return address_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void HostInfo::unsafe_arena_set_allocated_address(
-    std::string* address) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (address != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
-  } else {
-    _has_bits_[0] &= ~0x00000001u;
+  _impl_.address_.SetAllocated(address, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
   }
-  address_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      address, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.HostInfo.address)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.HostInfo.address)
 }
 
 // required uint32 port = 3;
 inline bool HostInfo::_internal_has_port() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool HostInfo::has_port() const {
   return _internal_has_port();
 }
 inline void HostInfo::clear_port() {
-  port_ = 0u;
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.port_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 HostInfo::_internal_port() const {
-  return port_;
+inline uint32_t HostInfo::_internal_port() const {
+  return _impl_.port_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 HostInfo::port() const {
+inline uint32_t HostInfo::port() const {
   // @@protoc_insertion_point(field_get:romabuf.HostInfo.port)
   return _internal_port();
 }
-inline void HostInfo::_internal_set_port(::PROTOBUF_NAMESPACE_ID::uint32 value) {
-  _has_bits_[0] |= 0x00000008u;
-  port_ = value;
+inline void HostInfo::_internal_set_port(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.port_ = value;
 }
-inline void HostInfo::set_port(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+inline void HostInfo::set_port(uint32_t value) {
   _internal_set_port(value);
   // @@protoc_insertion_point(field_set:romabuf.HostInfo.port)
 }
 
 // required .romabuf.ERefVal nodeman_addr = 4;
 inline bool HostInfo::_internal_has_nodeman_addr() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
-  PROTOBUF_ASSUME(!value || nodeman_addr_ != nullptr);
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.nodeman_addr_ != nullptr);
   return value;
 }
 inline bool HostInfo::has_nodeman_addr() const {
   return _internal_has_nodeman_addr();
 }
 inline void HostInfo::clear_nodeman_addr() {
-  if (nodeman_addr_ != nullptr) nodeman_addr_->Clear();
-  _has_bits_[0] &= ~0x00000002u;
+  if (_impl_.nodeman_addr_ != nullptr) _impl_.nodeman_addr_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
 inline const ::romabuf::ERefVal& HostInfo::_internal_nodeman_addr() const {
-  const ::romabuf::ERefVal* p = nodeman_addr_;
-  return p != nullptr ? *p : *reinterpret_cast<const ::romabuf::ERefVal*>(
-      &::romabuf::_ERefVal_default_instance_);
+  const ::romabuf::ERefVal* p = _impl_.nodeman_addr_;
+  return p != nullptr ? *p : reinterpret_cast<const ::romabuf::ERefVal&>(
+      ::romabuf::_ERefVal_default_instance_);
 }
 inline const ::romabuf::ERefVal& HostInfo::nodeman_addr() const {
   // @@protoc_insertion_point(field_get:romabuf.HostInfo.nodeman_addr)
@@ -2843,79 +3282,89 @@ inline const ::romabuf::ERefVal& HostInfo::nodeman_addr() const {
 }
 inline void HostInfo::unsafe_arena_set_allocated_nodeman_addr(
     ::romabuf::ERefVal* nodeman_addr) {
-  if (GetArena() == nullptr) {
-    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(nodeman_addr_);
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.nodeman_addr_);
   }
-  nodeman_addr_ = nodeman_addr;
+  _impl_.nodeman_addr_ = nodeman_addr;
   if (nodeman_addr) {
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.HostInfo.nodeman_addr)
 }
 inline ::romabuf::ERefVal* HostInfo::release_nodeman_addr() {
-  auto temp = unsafe_arena_release_nodeman_addr();
-  if (GetArena() != nullptr) {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::romabuf::ERefVal* temp = _impl_.nodeman_addr_;
+  _impl_.nodeman_addr_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
     temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
   }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
   return temp;
 }
 inline ::romabuf::ERefVal* HostInfo::unsafe_arena_release_nodeman_addr() {
   // @@protoc_insertion_point(field_release:romabuf.HostInfo.nodeman_addr)
-  _has_bits_[0] &= ~0x00000002u;
-  ::romabuf::ERefVal* temp = nodeman_addr_;
-  nodeman_addr_ = nullptr;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::romabuf::ERefVal* temp = _impl_.nodeman_addr_;
+  _impl_.nodeman_addr_ = nullptr;
   return temp;
 }
 inline ::romabuf::ERefVal* HostInfo::_internal_mutable_nodeman_addr() {
-  _has_bits_[0] |= 0x00000002u;
-  if (nodeman_addr_ == nullptr) {
-    auto* p = CreateMaybeMessage<::romabuf::ERefVal>(GetArena());
-    nodeman_addr_ = p;
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.nodeman_addr_ == nullptr) {
+    auto* p = CreateMaybeMessage<::romabuf::ERefVal>(GetArenaForAllocation());
+    _impl_.nodeman_addr_ = p;
   }
-  return nodeman_addr_;
+  return _impl_.nodeman_addr_;
 }
 inline ::romabuf::ERefVal* HostInfo::mutable_nodeman_addr() {
+  ::romabuf::ERefVal* _msg = _internal_mutable_nodeman_addr();
   // @@protoc_insertion_point(field_mutable:romabuf.HostInfo.nodeman_addr)
-  return _internal_mutable_nodeman_addr();
+  return _msg;
 }
 inline void HostInfo::set_allocated_nodeman_addr(::romabuf::ERefVal* nodeman_addr) {
-  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArena();
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   if (message_arena == nullptr) {
-    delete nodeman_addr_;
+    delete _impl_.nodeman_addr_;
   }
   if (nodeman_addr) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
-      ::PROTOBUF_NAMESPACE_ID::Arena::GetArena(nodeman_addr);
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(nodeman_addr);
     if (message_arena != submessage_arena) {
       nodeman_addr = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
           message_arena, nodeman_addr, submessage_arena);
     }
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
-  nodeman_addr_ = nodeman_addr;
+  _impl_.nodeman_addr_ = nodeman_addr;
   // @@protoc_insertion_point(field_set_allocated:romabuf.HostInfo.nodeman_addr)
 }
 
 // repeated string resources = 5;
 inline int HostInfo::_internal_resources_size() const {
-  return resources_.size();
+  return _impl_.resources_.size();
 }
 inline int HostInfo::resources_size() const {
   return _internal_resources_size();
 }
 inline void HostInfo::clear_resources() {
-  resources_.Clear();
+  _impl_.resources_.Clear();
 }
 inline std::string* HostInfo::add_resources() {
+  std::string* _s = _internal_add_resources();
   // @@protoc_insertion_point(field_add_mutable:romabuf.HostInfo.resources)
-  return _internal_add_resources();
+  return _s;
 }
 inline const std::string& HostInfo::_internal_resources(int index) const {
-  return resources_.Get(index);
+  return _impl_.resources_.Get(index);
 }
 inline const std::string& HostInfo::resources(int index) const {
   // @@protoc_insertion_point(field_get:romabuf.HostInfo.resources)
@@ -2923,184 +3372,191 @@ inline const std::string& HostInfo::resources(int index) const {
 }
 inline std::string* HostInfo::mutable_resources(int index) {
   // @@protoc_insertion_point(field_mutable:romabuf.HostInfo.resources)
-  return resources_.Mutable(index);
+  return _impl_.resources_.Mutable(index);
 }
 inline void HostInfo::set_resources(int index, const std::string& value) {
+  _impl_.resources_.Mutable(index)->assign(value);
   // @@protoc_insertion_point(field_set:romabuf.HostInfo.resources)
-  resources_.Mutable(index)->assign(value);
 }
 inline void HostInfo::set_resources(int index, std::string&& value) {
+  _impl_.resources_.Mutable(index)->assign(std::move(value));
   // @@protoc_insertion_point(field_set:romabuf.HostInfo.resources)
-  resources_.Mutable(index)->assign(std::move(value));
 }
 inline void HostInfo::set_resources(int index, const char* value) {
   GOOGLE_DCHECK(value != nullptr);
-  resources_.Mutable(index)->assign(value);
+  _impl_.resources_.Mutable(index)->assign(value);
   // @@protoc_insertion_point(field_set_char:romabuf.HostInfo.resources)
 }
 inline void HostInfo::set_resources(int index, const char* value, size_t size) {
-  resources_.Mutable(index)->assign(
+  _impl_.resources_.Mutable(index)->assign(
     reinterpret_cast<const char*>(value), size);
   // @@protoc_insertion_point(field_set_pointer:romabuf.HostInfo.resources)
 }
 inline std::string* HostInfo::_internal_add_resources() {
-  return resources_.Add();
+  return _impl_.resources_.Add();
 }
 inline void HostInfo::add_resources(const std::string& value) {
-  resources_.Add()->assign(value);
+  _impl_.resources_.Add()->assign(value);
   // @@protoc_insertion_point(field_add:romabuf.HostInfo.resources)
 }
 inline void HostInfo::add_resources(std::string&& value) {
-  resources_.Add(std::move(value));
+  _impl_.resources_.Add(std::move(value));
   // @@protoc_insertion_point(field_add:romabuf.HostInfo.resources)
 }
 inline void HostInfo::add_resources(const char* value) {
   GOOGLE_DCHECK(value != nullptr);
-  resources_.Add()->assign(value);
+  _impl_.resources_.Add()->assign(value);
   // @@protoc_insertion_point(field_add_char:romabuf.HostInfo.resources)
 }
 inline void HostInfo::add_resources(const char* value, size_t size) {
-  resources_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  _impl_.resources_.Add()->assign(reinterpret_cast<const char*>(value), size);
   // @@protoc_insertion_point(field_add_pointer:romabuf.HostInfo.resources)
 }
 inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
 HostInfo::resources() const {
   // @@protoc_insertion_point(field_list:romabuf.HostInfo.resources)
-  return resources_;
+  return _impl_.resources_;
 }
 inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
 HostInfo::mutable_resources() {
   // @@protoc_insertion_point(field_mutable_list:romabuf.HostInfo.resources)
-  return &resources_;
+  return &_impl_.resources_;
 }
 
 // -------------------------------------------------------------------
 
 // NumVal
 
-// required int32 value = 1;
+// required int64 value = 1;
 inline bool NumVal::_internal_has_value() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool NumVal::has_value() const {
   return _internal_has_value();
 }
 inline void NumVal::clear_value() {
-  value_ = 0;
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.value_ = int64_t{0};
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 NumVal::_internal_value() const {
-  return value_;
+inline int64_t NumVal::_internal_value() const {
+  return _impl_.value_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 NumVal::value() const {
+inline int64_t NumVal::value() const {
   // @@protoc_insertion_point(field_get:romabuf.NumVal.value)
   return _internal_value();
 }
-inline void NumVal::_internal_set_value(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000001u;
-  value_ = value;
+inline void NumVal::_internal_set_value(int64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_ = value;
 }
-inline void NumVal::set_value(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void NumVal::set_value(int64_t value) {
   _internal_set_value(value);
   // @@protoc_insertion_point(field_set:romabuf.NumVal.value)
 }
 
 // -------------------------------------------------------------------
 
+// BoolVal
+
+// required bool value = 1;
+inline bool BoolVal::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool BoolVal::has_value() const {
+  return _internal_has_value();
+}
+inline void BoolVal::clear_value() {
+  _impl_.value_ = false;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline bool BoolVal::_internal_value() const {
+  return _impl_.value_;
+}
+inline bool BoolVal::value() const {
+  // @@protoc_insertion_point(field_get:romabuf.BoolVal.value)
+  return _internal_value();
+}
+inline void BoolVal::_internal_set_value(bool value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_ = value;
+}
+inline void BoolVal::set_value(bool value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:romabuf.BoolVal.value)
+}
+
+// -------------------------------------------------------------------
+
 // StrVal
 
 // required string value = 1;
 inline bool StrVal::_internal_has_value() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool StrVal::has_value() const {
   return _internal_has_value();
 }
 inline void StrVal::clear_value() {
-  value_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.value_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& StrVal::value() const {
   // @@protoc_insertion_point(field_get:romabuf.StrVal.value)
   return _internal_value();
 }
-inline void StrVal::set_value(const std::string& value) {
-  _internal_set_value(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void StrVal::set_value(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.value_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.StrVal.value)
 }
 inline std::string* StrVal::mutable_value() {
+  std::string* _s = _internal_mutable_value();
   // @@protoc_insertion_point(field_mutable:romabuf.StrVal.value)
-  return _internal_mutable_value();
+  return _s;
 }
 inline const std::string& StrVal::_internal_value() const {
-  return value_.Get();
+  return _impl_.value_.Get();
 }
 inline void StrVal::_internal_set_value(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  value_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void StrVal::set_value(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  value_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.StrVal.value)
-}
-inline void StrVal::set_value(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  value_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.StrVal.value)
-}
-inline void StrVal::set_value(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  value_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.StrVal.value)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.value_.Set(value, GetArenaForAllocation());
 }
 inline std::string* StrVal::_internal_mutable_value() {
-  _has_bits_[0] |= 0x00000001u;
-  return value_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.value_.Mutable(GetArenaForAllocation());
 }
 inline std::string* StrVal::release_value() {
   // @@protoc_insertion_point(field_release:romabuf.StrVal.value)
   if (!_internal_has_value()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return value_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.value_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void StrVal::set_allocated_value(std::string* value) {
   if (value != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  value_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.StrVal.value)
-}
-inline std::string* StrVal::unsafe_arena_release_value() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.StrVal.value)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000001u;
-  return value_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void StrVal::unsafe_arena_set_allocated_value(
-    std::string* value) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (value != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
-  } else {
-    _has_bits_[0] &= ~0x00000001u;
+  _impl_.value_.SetAllocated(value, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.value_.IsDefault()) {
+    _impl_.value_.Set("", GetArenaForAllocation());
   }
-  value_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      value, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.StrVal.value)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.StrVal.value)
 }
 
 // -------------------------------------------------------------------
@@ -3109,41 +3565,42 @@ inline void StrVal::unsafe_arena_set_allocated_value(
 
 // repeated .romabuf.PValue values = 1;
 inline int ListVal::_internal_values_size() const {
-  return values_.size();
+  return _impl_.values_.size();
 }
 inline int ListVal::values_size() const {
   return _internal_values_size();
 }
 inline void ListVal::clear_values() {
-  values_.Clear();
+  _impl_.values_.Clear();
 }
 inline ::romabuf::PValue* ListVal::mutable_values(int index) {
   // @@protoc_insertion_point(field_mutable:romabuf.ListVal.values)
-  return values_.Mutable(index);
+  return _impl_.values_.Mutable(index);
 }
 inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue >*
 ListVal::mutable_values() {
   // @@protoc_insertion_point(field_mutable_list:romabuf.ListVal.values)
-  return &values_;
+  return &_impl_.values_;
 }
 inline const ::romabuf::PValue& ListVal::_internal_values(int index) const {
-  return values_.Get(index);
+  return _impl_.values_.Get(index);
 }
 inline const ::romabuf::PValue& ListVal::values(int index) const {
   // @@protoc_insertion_point(field_get:romabuf.ListVal.values)
   return _internal_values(index);
 }
 inline ::romabuf::PValue* ListVal::_internal_add_values() {
-  return values_.Add();
+  return _impl_.values_.Add();
 }
 inline ::romabuf::PValue* ListVal::add_values() {
+  ::romabuf::PValue* _add = _internal_add_values();
   // @@protoc_insertion_point(field_add:romabuf.ListVal.values)
-  return _internal_add_values();
+  return _add;
 }
 inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue >&
 ListVal::values() const {
   // @@protoc_insertion_point(field_list:romabuf.ListVal.values)
-  return values_;
+  return _impl_.values_;
 }
 
 // -------------------------------------------------------------------
@@ -3152,88 +3609,156 @@ ListVal::values() const {
 
 // required int32 node_id = 1;
 inline bool ERefVal::_internal_has_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool ERefVal::has_node_id() const {
   return _internal_has_node_id();
 }
 inline void ERefVal::clear_node_id() {
-  node_id_ = 0;
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::_internal_node_id() const {
-  return node_id_;
+inline int32_t ERefVal::_internal_node_id() const {
+  return _impl_.node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::node_id() const {
+inline int32_t ERefVal::node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.ERefVal.node_id)
   return _internal_node_id();
 }
-inline void ERefVal::_internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000001u;
-  node_id_ = value;
+inline void ERefVal::_internal_set_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.node_id_ = value;
 }
-inline void ERefVal::set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void ERefVal::set_node_id(int32_t value) {
   _internal_set_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.ERefVal.node_id)
 }
 
 // required int32 vat_id = 2;
 inline bool ERefVal::_internal_has_vat_id() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool ERefVal::has_vat_id() const {
   return _internal_has_vat_id();
 }
 inline void ERefVal::clear_vat_id() {
-  vat_id_ = 0;
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.vat_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::_internal_vat_id() const {
-  return vat_id_;
+inline int32_t ERefVal::_internal_vat_id() const {
+  return _impl_.vat_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::vat_id() const {
+inline int32_t ERefVal::vat_id() const {
   // @@protoc_insertion_point(field_get:romabuf.ERefVal.vat_id)
   return _internal_vat_id();
 }
-inline void ERefVal::_internal_set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000002u;
-  vat_id_ = value;
+inline void ERefVal::_internal_set_vat_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.vat_id_ = value;
 }
-inline void ERefVal::set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void ERefVal::set_vat_id(int32_t value) {
   _internal_set_vat_id(value);
   // @@protoc_insertion_point(field_set:romabuf.ERefVal.vat_id)
 }
 
 // required int32 entity_id = 3;
 inline bool ERefVal::_internal_has_entity_id() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool ERefVal::has_entity_id() const {
   return _internal_has_entity_id();
 }
 inline void ERefVal::clear_entity_id() {
-  entity_id_ = 0;
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.entity_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::_internal_entity_id() const {
-  return entity_id_;
+inline int32_t ERefVal::_internal_entity_id() const {
+  return _impl_.entity_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 ERefVal::entity_id() const {
+inline int32_t ERefVal::entity_id() const {
   // @@protoc_insertion_point(field_get:romabuf.ERefVal.entity_id)
   return _internal_entity_id();
 }
-inline void ERefVal::_internal_set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000004u;
-  entity_id_ = value;
+inline void ERefVal::_internal_set_entity_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.entity_id_ = value;
 }
-inline void ERefVal::set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void ERefVal::set_entity_id(int32_t value) {
   _internal_set_entity_id(value);
   // @@protoc_insertion_point(field_set:romabuf.ERefVal.entity_id)
 }
 
+// optional string entity_name = 4;
+inline bool ERefVal::_internal_has_entity_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool ERefVal::has_entity_name() const {
+  return _internal_has_entity_name();
+}
+inline void ERefVal::clear_entity_name() {
+  _impl_.entity_name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& ERefVal::entity_name() const {
+  // @@protoc_insertion_point(field_get:romabuf.ERefVal.entity_name)
+  return _internal_entity_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void ERefVal::set_entity_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.entity_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:romabuf.ERefVal.entity_name)
+}
+inline std::string* ERefVal::mutable_entity_name() {
+  std::string* _s = _internal_mutable_entity_name();
+  // @@protoc_insertion_point(field_mutable:romabuf.ERefVal.entity_name)
+  return _s;
+}
+inline const std::string& ERefVal::_internal_entity_name() const {
+  return _impl_.entity_name_.Get();
+}
+inline void ERefVal::_internal_set_entity_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.entity_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* ERefVal::_internal_mutable_entity_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.entity_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* ERefVal::release_entity_name() {
+  // @@protoc_insertion_point(field_release:romabuf.ERefVal.entity_name)
+  if (!_internal_has_entity_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.entity_name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.entity_name_.IsDefault()) {
+    _impl_.entity_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void ERefVal::set_allocated_entity_name(std::string* entity_name) {
+  if (entity_name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.entity_name_.SetAllocated(entity_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.entity_name_.IsDefault()) {
+    _impl_.entity_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.ERefVal.entity_name)
+}
+
 // -------------------------------------------------------------------
 
 // PValue
@@ -3246,12 +3771,12 @@ inline bool PValue::has_num_val() const {
   return _internal_has_num_val();
 }
 inline void PValue::set_has_num_val() {
-  _oneof_case_[0] = kNumVal;
+  _impl_._oneof_case_[0] = kNumVal;
 }
 inline void PValue::clear_num_val() {
   if (_internal_has_num_val()) {
-    if (GetArena() == nullptr) {
-      delete value_.num_val_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.value_.num_val_;
     }
     clear_has_value();
   }
@@ -3260,11 +3785,11 @@ inline ::romabuf::NumVal* PValue::release_num_val() {
   // @@protoc_insertion_point(field_release:romabuf.PValue.num_val)
   if (_internal_has_num_val()) {
     clear_has_value();
-      ::romabuf::NumVal* temp = value_.num_val_;
-    if (GetArena() != nullptr) {
+    ::romabuf::NumVal* temp = _impl_.value_.num_val_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    value_.num_val_ = nullptr;
+    _impl_.value_.num_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3272,8 +3797,8 @@ inline ::romabuf::NumVal* PValue::release_num_val() {
 }
 inline const ::romabuf::NumVal& PValue::_internal_num_val() const {
   return _internal_has_num_val()
-      ? *value_.num_val_
-      : *reinterpret_cast< ::romabuf::NumVal*>(&::romabuf::_NumVal_default_instance_);
+      ? *_impl_.value_.num_val_
+      : reinterpret_cast< ::romabuf::NumVal&>(::romabuf::_NumVal_default_instance_);
 }
 inline const ::romabuf::NumVal& PValue::num_val() const {
   // @@protoc_insertion_point(field_get:romabuf.PValue.num_val)
@@ -3283,8 +3808,8 @@ inline ::romabuf::NumVal* PValue::unsafe_arena_release_num_val() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PValue.num_val)
   if (_internal_has_num_val()) {
     clear_has_value();
-    ::romabuf::NumVal* temp = value_.num_val_;
-    value_.num_val_ = nullptr;
+    ::romabuf::NumVal* temp = _impl_.value_.num_val_;
+    _impl_.value_.num_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3294,7 +3819,7 @@ inline void PValue::unsafe_arena_set_allocated_num_val(::romabuf::NumVal* num_va
   clear_value();
   if (num_val) {
     set_has_num_val();
-    value_.num_val_ = num_val;
+    _impl_.value_.num_val_ = num_val;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PValue.num_val)
 }
@@ -3302,13 +3827,14 @@ inline ::romabuf::NumVal* PValue::_internal_mutable_num_val() {
   if (!_internal_has_num_val()) {
     clear_value();
     set_has_num_val();
-    value_.num_val_ = CreateMaybeMessage< ::romabuf::NumVal >(GetArena());
+    _impl_.value_.num_val_ = CreateMaybeMessage< ::romabuf::NumVal >(GetArenaForAllocation());
   }
-  return value_.num_val_;
+  return _impl_.value_.num_val_;
 }
 inline ::romabuf::NumVal* PValue::mutable_num_val() {
+  ::romabuf::NumVal* _msg = _internal_mutable_num_val();
   // @@protoc_insertion_point(field_mutable:romabuf.PValue.num_val)
-  return _internal_mutable_num_val();
+  return _msg;
 }
 
 // .romabuf.StrVal str_val = 2;
@@ -3319,12 +3845,12 @@ inline bool PValue::has_str_val() const {
   return _internal_has_str_val();
 }
 inline void PValue::set_has_str_val() {
-  _oneof_case_[0] = kStrVal;
+  _impl_._oneof_case_[0] = kStrVal;
 }
 inline void PValue::clear_str_val() {
   if (_internal_has_str_val()) {
-    if (GetArena() == nullptr) {
-      delete value_.str_val_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.value_.str_val_;
     }
     clear_has_value();
   }
@@ -3333,11 +3859,11 @@ inline ::romabuf::StrVal* PValue::release_str_val() {
   // @@protoc_insertion_point(field_release:romabuf.PValue.str_val)
   if (_internal_has_str_val()) {
     clear_has_value();
-      ::romabuf::StrVal* temp = value_.str_val_;
-    if (GetArena() != nullptr) {
+    ::romabuf::StrVal* temp = _impl_.value_.str_val_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    value_.str_val_ = nullptr;
+    _impl_.value_.str_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3345,8 +3871,8 @@ inline ::romabuf::StrVal* PValue::release_str_val() {
 }
 inline const ::romabuf::StrVal& PValue::_internal_str_val() const {
   return _internal_has_str_val()
-      ? *value_.str_val_
-      : *reinterpret_cast< ::romabuf::StrVal*>(&::romabuf::_StrVal_default_instance_);
+      ? *_impl_.value_.str_val_
+      : reinterpret_cast< ::romabuf::StrVal&>(::romabuf::_StrVal_default_instance_);
 }
 inline const ::romabuf::StrVal& PValue::str_val() const {
   // @@protoc_insertion_point(field_get:romabuf.PValue.str_val)
@@ -3356,8 +3882,8 @@ inline ::romabuf::StrVal* PValue::unsafe_arena_release_str_val() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PValue.str_val)
   if (_internal_has_str_val()) {
     clear_has_value();
-    ::romabuf::StrVal* temp = value_.str_val_;
-    value_.str_val_ = nullptr;
+    ::romabuf::StrVal* temp = _impl_.value_.str_val_;
+    _impl_.value_.str_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3367,7 +3893,7 @@ inline void PValue::unsafe_arena_set_allocated_str_val(::romabuf::StrVal* str_va
   clear_value();
   if (str_val) {
     set_has_str_val();
-    value_.str_val_ = str_val;
+    _impl_.value_.str_val_ = str_val;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PValue.str_val)
 }
@@ -3375,13 +3901,14 @@ inline ::romabuf::StrVal* PValue::_internal_mutable_str_val() {
   if (!_internal_has_str_val()) {
     clear_value();
     set_has_str_val();
-    value_.str_val_ = CreateMaybeMessage< ::romabuf::StrVal >(GetArena());
+    _impl_.value_.str_val_ = CreateMaybeMessage< ::romabuf::StrVal >(GetArenaForAllocation());
   }
-  return value_.str_val_;
+  return _impl_.value_.str_val_;
 }
 inline ::romabuf::StrVal* PValue::mutable_str_val() {
+  ::romabuf::StrVal* _msg = _internal_mutable_str_val();
   // @@protoc_insertion_point(field_mutable:romabuf.PValue.str_val)
-  return _internal_mutable_str_val();
+  return _msg;
 }
 
 // .romabuf.ERefVal eref_val = 3;
@@ -3392,12 +3919,12 @@ inline bool PValue::has_eref_val() const {
   return _internal_has_eref_val();
 }
 inline void PValue::set_has_eref_val() {
-  _oneof_case_[0] = kErefVal;
+  _impl_._oneof_case_[0] = kErefVal;
 }
 inline void PValue::clear_eref_val() {
   if (_internal_has_eref_val()) {
-    if (GetArena() == nullptr) {
-      delete value_.eref_val_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.value_.eref_val_;
     }
     clear_has_value();
   }
@@ -3406,11 +3933,11 @@ inline ::romabuf::ERefVal* PValue::release_eref_val() {
   // @@protoc_insertion_point(field_release:romabuf.PValue.eref_val)
   if (_internal_has_eref_val()) {
     clear_has_value();
-      ::romabuf::ERefVal* temp = value_.eref_val_;
-    if (GetArena() != nullptr) {
+    ::romabuf::ERefVal* temp = _impl_.value_.eref_val_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    value_.eref_val_ = nullptr;
+    _impl_.value_.eref_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3418,8 +3945,8 @@ inline ::romabuf::ERefVal* PValue::release_eref_val() {
 }
 inline const ::romabuf::ERefVal& PValue::_internal_eref_val() const {
   return _internal_has_eref_val()
-      ? *value_.eref_val_
-      : *reinterpret_cast< ::romabuf::ERefVal*>(&::romabuf::_ERefVal_default_instance_);
+      ? *_impl_.value_.eref_val_
+      : reinterpret_cast< ::romabuf::ERefVal&>(::romabuf::_ERefVal_default_instance_);
 }
 inline const ::romabuf::ERefVal& PValue::eref_val() const {
   // @@protoc_insertion_point(field_get:romabuf.PValue.eref_val)
@@ -3429,8 +3956,8 @@ inline ::romabuf::ERefVal* PValue::unsafe_arena_release_eref_val() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PValue.eref_val)
   if (_internal_has_eref_val()) {
     clear_has_value();
-    ::romabuf::ERefVal* temp = value_.eref_val_;
-    value_.eref_val_ = nullptr;
+    ::romabuf::ERefVal* temp = _impl_.value_.eref_val_;
+    _impl_.value_.eref_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3440,7 +3967,7 @@ inline void PValue::unsafe_arena_set_allocated_eref_val(::romabuf::ERefVal* eref
   clear_value();
   if (eref_val) {
     set_has_eref_val();
-    value_.eref_val_ = eref_val;
+    _impl_.value_.eref_val_ = eref_val;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PValue.eref_val)
 }
@@ -3448,13 +3975,14 @@ inline ::romabuf::ERefVal* PValue::_internal_mutable_eref_val() {
   if (!_internal_has_eref_val()) {
     clear_value();
     set_has_eref_val();
-    value_.eref_val_ = CreateMaybeMessage< ::romabuf::ERefVal >(GetArena());
+    _impl_.value_.eref_val_ = CreateMaybeMessage< ::romabuf::ERefVal >(GetArenaForAllocation());
   }
-  return value_.eref_val_;
+  return _impl_.value_.eref_val_;
 }
 inline ::romabuf::ERefVal* PValue::mutable_eref_val() {
+  ::romabuf::ERefVal* _msg = _internal_mutable_eref_val();
   // @@protoc_insertion_point(field_mutable:romabuf.PValue.eref_val)
-  return _internal_mutable_eref_val();
+  return _msg;
 }
 
 // .romabuf.ListVal list_val = 4;
@@ -3465,12 +3993,12 @@ inline bool PValue::has_list_val() const {
   return _internal_has_list_val();
 }
 inline void PValue::set_has_list_val() {
-  _oneof_case_[0] = kListVal;
+  _impl_._oneof_case_[0] = kListVal;
 }
 inline void PValue::clear_list_val() {
   if (_internal_has_list_val()) {
-    if (GetArena() == nullptr) {
-      delete value_.list_val_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.value_.list_val_;
     }
     clear_has_value();
   }
@@ -3479,11 +4007,11 @@ inline ::romabuf::ListVal* PValue::release_list_val() {
   // @@protoc_insertion_point(field_release:romabuf.PValue.list_val)
   if (_internal_has_list_val()) {
     clear_has_value();
-      ::romabuf::ListVal* temp = value_.list_val_;
-    if (GetArena() != nullptr) {
+    ::romabuf::ListVal* temp = _impl_.value_.list_val_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    value_.list_val_ = nullptr;
+    _impl_.value_.list_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3491,8 +4019,8 @@ inline ::romabuf::ListVal* PValue::release_list_val() {
 }
 inline const ::romabuf::ListVal& PValue::_internal_list_val() const {
   return _internal_has_list_val()
-      ? *value_.list_val_
-      : *reinterpret_cast< ::romabuf::ListVal*>(&::romabuf::_ListVal_default_instance_);
+      ? *_impl_.value_.list_val_
+      : reinterpret_cast< ::romabuf::ListVal&>(::romabuf::_ListVal_default_instance_);
 }
 inline const ::romabuf::ListVal& PValue::list_val() const {
   // @@protoc_insertion_point(field_get:romabuf.PValue.list_val)
@@ -3502,8 +4030,8 @@ inline ::romabuf::ListVal* PValue::unsafe_arena_release_list_val() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PValue.list_val)
   if (_internal_has_list_val()) {
     clear_has_value();
-    ::romabuf::ListVal* temp = value_.list_val_;
-    value_.list_val_ = nullptr;
+    ::romabuf::ListVal* temp = _impl_.value_.list_val_;
+    _impl_.value_.list_val_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3513,7 +4041,7 @@ inline void PValue::unsafe_arena_set_allocated_list_val(::romabuf::ListVal* list
   clear_value();
   if (list_val) {
     set_has_list_val();
-    value_.list_val_ = list_val;
+    _impl_.value_.list_val_ = list_val;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PValue.list_val)
 }
@@ -3521,23 +4049,98 @@ inline ::romabuf::ListVal* PValue::_internal_mutable_list_val() {
   if (!_internal_has_list_val()) {
     clear_value();
     set_has_list_val();
-    value_.list_val_ = CreateMaybeMessage< ::romabuf::ListVal >(GetArena());
+    _impl_.value_.list_val_ = CreateMaybeMessage< ::romabuf::ListVal >(GetArenaForAllocation());
   }
-  return value_.list_val_;
+  return _impl_.value_.list_val_;
 }
 inline ::romabuf::ListVal* PValue::mutable_list_val() {
+  ::romabuf::ListVal* _msg = _internal_mutable_list_val();
   // @@protoc_insertion_point(field_mutable:romabuf.PValue.list_val)
-  return _internal_mutable_list_val();
+  return _msg;
+}
+
+// .romabuf.BoolVal bool_val = 5;
+inline bool PValue::_internal_has_bool_val() const {
+  return value_case() == kBoolVal;
+}
+inline bool PValue::has_bool_val() const {
+  return _internal_has_bool_val();
+}
+inline void PValue::set_has_bool_val() {
+  _impl_._oneof_case_[0] = kBoolVal;
+}
+inline void PValue::clear_bool_val() {
+  if (_internal_has_bool_val()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.value_.bool_val_;
+    }
+    clear_has_value();
+  }
+}
+inline ::romabuf::BoolVal* PValue::release_bool_val() {
+  // @@protoc_insertion_point(field_release:romabuf.PValue.bool_val)
+  if (_internal_has_bool_val()) {
+    clear_has_value();
+    ::romabuf::BoolVal* temp = _impl_.value_.bool_val_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.value_.bool_val_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::romabuf::BoolVal& PValue::_internal_bool_val() const {
+  return _internal_has_bool_val()
+      ? *_impl_.value_.bool_val_
+      : reinterpret_cast< ::romabuf::BoolVal&>(::romabuf::_BoolVal_default_instance_);
+}
+inline const ::romabuf::BoolVal& PValue::bool_val() const {
+  // @@protoc_insertion_point(field_get:romabuf.PValue.bool_val)
+  return _internal_bool_val();
+}
+inline ::romabuf::BoolVal* PValue::unsafe_arena_release_bool_val() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PValue.bool_val)
+  if (_internal_has_bool_val()) {
+    clear_has_value();
+    ::romabuf::BoolVal* temp = _impl_.value_.bool_val_;
+    _impl_.value_.bool_val_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void PValue::unsafe_arena_set_allocated_bool_val(::romabuf::BoolVal* bool_val) {
+  clear_value();
+  if (bool_val) {
+    set_has_bool_val();
+    _impl_.value_.bool_val_ = bool_val;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PValue.bool_val)
+}
+inline ::romabuf::BoolVal* PValue::_internal_mutable_bool_val() {
+  if (!_internal_has_bool_val()) {
+    clear_value();
+    set_has_bool_val();
+    _impl_.value_.bool_val_ = CreateMaybeMessage< ::romabuf::BoolVal >(GetArenaForAllocation());
+  }
+  return _impl_.value_.bool_val_;
+}
+inline ::romabuf::BoolVal* PValue::mutable_bool_val() {
+  ::romabuf::BoolVal* _msg = _internal_mutable_bool_val();
+  // @@protoc_insertion_point(field_mutable:romabuf.PValue.bool_val)
+  return _msg;
 }
 
 inline bool PValue::has_value() const {
   return value_case() != VALUE_NOT_SET;
 }
 inline void PValue::clear_has_value() {
-  _oneof_case_[0] = VALUE_NOT_SET;
+  _impl_._oneof_case_[0] = VALUE_NOT_SET;
 }
 inline PValue::ValueCase PValue::value_case() const {
-  return PValue::ValueCase(_oneof_case_[0]);
+  return PValue::ValueCase(_impl_._oneof_case_[0]);
 }
 // -------------------------------------------------------------------
 
@@ -3551,12 +4154,12 @@ inline bool PleromaMessage::has_call() const {
   return _internal_has_call();
 }
 inline void PleromaMessage::set_has_call() {
-  _oneof_case_[0] = kCall;
+  _impl_._oneof_case_[0] = kCall;
 }
 inline void PleromaMessage::clear_call() {
   if (_internal_has_call()) {
-    if (GetArena() == nullptr) {
-      delete msg_.call_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.msg_.call_;
     }
     clear_has_msg();
   }
@@ -3565,11 +4168,11 @@ inline ::romabuf::Call* PleromaMessage::release_call() {
   // @@protoc_insertion_point(field_release:romabuf.PleromaMessage.call)
   if (_internal_has_call()) {
     clear_has_msg();
-      ::romabuf::Call* temp = msg_.call_;
-    if (GetArena() != nullptr) {
+    ::romabuf::Call* temp = _impl_.msg_.call_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    msg_.call_ = nullptr;
+    _impl_.msg_.call_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3577,8 +4180,8 @@ inline ::romabuf::Call* PleromaMessage::release_call() {
 }
 inline const ::romabuf::Call& PleromaMessage::_internal_call() const {
   return _internal_has_call()
-      ? *msg_.call_
-      : *reinterpret_cast< ::romabuf::Call*>(&::romabuf::_Call_default_instance_);
+      ? *_impl_.msg_.call_
+      : reinterpret_cast< ::romabuf::Call&>(::romabuf::_Call_default_instance_);
 }
 inline const ::romabuf::Call& PleromaMessage::call() const {
   // @@protoc_insertion_point(field_get:romabuf.PleromaMessage.call)
@@ -3588,8 +4191,8 @@ inline ::romabuf::Call* PleromaMessage::unsafe_arena_release_call() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PleromaMessage.call)
   if (_internal_has_call()) {
     clear_has_msg();
-    ::romabuf::Call* temp = msg_.call_;
-    msg_.call_ = nullptr;
+    ::romabuf::Call* temp = _impl_.msg_.call_;
+    _impl_.msg_.call_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3599,7 +4202,7 @@ inline void PleromaMessage::unsafe_arena_set_allocated_call(::romabuf::Call* cal
   clear_msg();
   if (call) {
     set_has_call();
-    msg_.call_ = call;
+    _impl_.msg_.call_ = call;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PleromaMessage.call)
 }
@@ -3607,13 +4210,14 @@ inline ::romabuf::Call* PleromaMessage::_internal_mutable_call() {
   if (!_internal_has_call()) {
     clear_msg();
     set_has_call();
-    msg_.call_ = CreateMaybeMessage< ::romabuf::Call >(GetArena());
+    _impl_.msg_.call_ = CreateMaybeMessage< ::romabuf::Call >(GetArenaForAllocation());
   }
-  return msg_.call_;
+  return _impl_.msg_.call_;
 }
 inline ::romabuf::Call* PleromaMessage::mutable_call() {
+  ::romabuf::Call* _msg = _internal_mutable_call();
   // @@protoc_insertion_point(field_mutable:romabuf.PleromaMessage.call)
-  return _internal_mutable_call();
+  return _msg;
 }
 
 // .romabuf.AnnouncePeer announce_peer = 2;
@@ -3624,12 +4228,12 @@ inline bool PleromaMessage::has_announce_peer() const {
   return _internal_has_announce_peer();
 }
 inline void PleromaMessage::set_has_announce_peer() {
-  _oneof_case_[0] = kAnnouncePeer;
+  _impl_._oneof_case_[0] = kAnnouncePeer;
 }
 inline void PleromaMessage::clear_announce_peer() {
   if (_internal_has_announce_peer()) {
-    if (GetArena() == nullptr) {
-      delete msg_.announce_peer_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.msg_.announce_peer_;
     }
     clear_has_msg();
   }
@@ -3638,11 +4242,11 @@ inline ::romabuf::AnnouncePeer* PleromaMessage::release_announce_peer() {
   // @@protoc_insertion_point(field_release:romabuf.PleromaMessage.announce_peer)
   if (_internal_has_announce_peer()) {
     clear_has_msg();
-      ::romabuf::AnnouncePeer* temp = msg_.announce_peer_;
-    if (GetArena() != nullptr) {
+    ::romabuf::AnnouncePeer* temp = _impl_.msg_.announce_peer_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    msg_.announce_peer_ = nullptr;
+    _impl_.msg_.announce_peer_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3650,8 +4254,8 @@ inline ::romabuf::AnnouncePeer* PleromaMessage::release_announce_peer() {
 }
 inline const ::romabuf::AnnouncePeer& PleromaMessage::_internal_announce_peer() const {
   return _internal_has_announce_peer()
-      ? *msg_.announce_peer_
-      : *reinterpret_cast< ::romabuf::AnnouncePeer*>(&::romabuf::_AnnouncePeer_default_instance_);
+      ? *_impl_.msg_.announce_peer_
+      : reinterpret_cast< ::romabuf::AnnouncePeer&>(::romabuf::_AnnouncePeer_default_instance_);
 }
 inline const ::romabuf::AnnouncePeer& PleromaMessage::announce_peer() const {
   // @@protoc_insertion_point(field_get:romabuf.PleromaMessage.announce_peer)
@@ -3661,8 +4265,8 @@ inline ::romabuf::AnnouncePeer* PleromaMessage::unsafe_arena_release_announce_pe
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PleromaMessage.announce_peer)
   if (_internal_has_announce_peer()) {
     clear_has_msg();
-    ::romabuf::AnnouncePeer* temp = msg_.announce_peer_;
-    msg_.announce_peer_ = nullptr;
+    ::romabuf::AnnouncePeer* temp = _impl_.msg_.announce_peer_;
+    _impl_.msg_.announce_peer_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3672,7 +4276,7 @@ inline void PleromaMessage::unsafe_arena_set_allocated_announce_peer(::romabuf::
   clear_msg();
   if (announce_peer) {
     set_has_announce_peer();
-    msg_.announce_peer_ = announce_peer;
+    _impl_.msg_.announce_peer_ = announce_peer;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PleromaMessage.announce_peer)
 }
@@ -3680,13 +4284,14 @@ inline ::romabuf::AnnouncePeer* PleromaMessage::_internal_mutable_announce_peer(
   if (!_internal_has_announce_peer()) {
     clear_msg();
     set_has_announce_peer();
-    msg_.announce_peer_ = CreateMaybeMessage< ::romabuf::AnnouncePeer >(GetArena());
+    _impl_.msg_.announce_peer_ = CreateMaybeMessage< ::romabuf::AnnouncePeer >(GetArenaForAllocation());
   }
-  return msg_.announce_peer_;
+  return _impl_.msg_.announce_peer_;
 }
 inline ::romabuf::AnnouncePeer* PleromaMessage::mutable_announce_peer() {
+  ::romabuf::AnnouncePeer* _msg = _internal_mutable_announce_peer();
   // @@protoc_insertion_point(field_mutable:romabuf.PleromaMessage.announce_peer)
-  return _internal_mutable_announce_peer();
+  return _msg;
 }
 
 // .romabuf.AssignClusterInfo assign_cluster_info = 3;
@@ -3697,12 +4302,12 @@ inline bool PleromaMessage::has_assign_cluster_info() const {
   return _internal_has_assign_cluster_info();
 }
 inline void PleromaMessage::set_has_assign_cluster_info() {
-  _oneof_case_[0] = kAssignClusterInfo;
+  _impl_._oneof_case_[0] = kAssignClusterInfo;
 }
 inline void PleromaMessage::clear_assign_cluster_info() {
   if (_internal_has_assign_cluster_info()) {
-    if (GetArena() == nullptr) {
-      delete msg_.assign_cluster_info_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.msg_.assign_cluster_info_;
     }
     clear_has_msg();
   }
@@ -3711,11 +4316,11 @@ inline ::romabuf::AssignClusterInfo* PleromaMessage::release_assign_cluster_info
   // @@protoc_insertion_point(field_release:romabuf.PleromaMessage.assign_cluster_info)
   if (_internal_has_assign_cluster_info()) {
     clear_has_msg();
-      ::romabuf::AssignClusterInfo* temp = msg_.assign_cluster_info_;
-    if (GetArena() != nullptr) {
+    ::romabuf::AssignClusterInfo* temp = _impl_.msg_.assign_cluster_info_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    msg_.assign_cluster_info_ = nullptr;
+    _impl_.msg_.assign_cluster_info_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3723,8 +4328,8 @@ inline ::romabuf::AssignClusterInfo* PleromaMessage::release_assign_cluster_info
 }
 inline const ::romabuf::AssignClusterInfo& PleromaMessage::_internal_assign_cluster_info() const {
   return _internal_has_assign_cluster_info()
-      ? *msg_.assign_cluster_info_
-      : *reinterpret_cast< ::romabuf::AssignClusterInfo*>(&::romabuf::_AssignClusterInfo_default_instance_);
+      ? *_impl_.msg_.assign_cluster_info_
+      : reinterpret_cast< ::romabuf::AssignClusterInfo&>(::romabuf::_AssignClusterInfo_default_instance_);
 }
 inline const ::romabuf::AssignClusterInfo& PleromaMessage::assign_cluster_info() const {
   // @@protoc_insertion_point(field_get:romabuf.PleromaMessage.assign_cluster_info)
@@ -3734,8 +4339,8 @@ inline ::romabuf::AssignClusterInfo* PleromaMessage::unsafe_arena_release_assign
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PleromaMessage.assign_cluster_info)
   if (_internal_has_assign_cluster_info()) {
     clear_has_msg();
-    ::romabuf::AssignClusterInfo* temp = msg_.assign_cluster_info_;
-    msg_.assign_cluster_info_ = nullptr;
+    ::romabuf::AssignClusterInfo* temp = _impl_.msg_.assign_cluster_info_;
+    _impl_.msg_.assign_cluster_info_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3745,7 +4350,7 @@ inline void PleromaMessage::unsafe_arena_set_allocated_assign_cluster_info(::rom
   clear_msg();
   if (assign_cluster_info) {
     set_has_assign_cluster_info();
-    msg_.assign_cluster_info_ = assign_cluster_info;
+    _impl_.msg_.assign_cluster_info_ = assign_cluster_info;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PleromaMessage.assign_cluster_info)
 }
@@ -3753,13 +4358,14 @@ inline ::romabuf::AssignClusterInfo* PleromaMessage::_internal_mutable_assign_cl
   if (!_internal_has_assign_cluster_info()) {
     clear_msg();
     set_has_assign_cluster_info();
-    msg_.assign_cluster_info_ = CreateMaybeMessage< ::romabuf::AssignClusterInfo >(GetArena());
+    _impl_.msg_.assign_cluster_info_ = CreateMaybeMessage< ::romabuf::AssignClusterInfo >(GetArenaForAllocation());
   }
-  return msg_.assign_cluster_info_;
+  return _impl_.msg_.assign_cluster_info_;
 }
 inline ::romabuf::AssignClusterInfo* PleromaMessage::mutable_assign_cluster_info() {
+  ::romabuf::AssignClusterInfo* _msg = _internal_mutable_assign_cluster_info();
   // @@protoc_insertion_point(field_mutable:romabuf.PleromaMessage.assign_cluster_info)
-  return _internal_mutable_assign_cluster_info();
+  return _msg;
 }
 
 // .romabuf.HostInfo host_info = 4;
@@ -3770,12 +4376,12 @@ inline bool PleromaMessage::has_host_info() const {
   return _internal_has_host_info();
 }
 inline void PleromaMessage::set_has_host_info() {
-  _oneof_case_[0] = kHostInfo;
+  _impl_._oneof_case_[0] = kHostInfo;
 }
 inline void PleromaMessage::clear_host_info() {
   if (_internal_has_host_info()) {
-    if (GetArena() == nullptr) {
-      delete msg_.host_info_;
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.msg_.host_info_;
     }
     clear_has_msg();
   }
@@ -3784,11 +4390,11 @@ inline ::romabuf::HostInfo* PleromaMessage::release_host_info() {
   // @@protoc_insertion_point(field_release:romabuf.PleromaMessage.host_info)
   if (_internal_has_host_info()) {
     clear_has_msg();
-      ::romabuf::HostInfo* temp = msg_.host_info_;
-    if (GetArena() != nullptr) {
+    ::romabuf::HostInfo* temp = _impl_.msg_.host_info_;
+    if (GetArenaForAllocation() != nullptr) {
       temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
     }
-    msg_.host_info_ = nullptr;
+    _impl_.msg_.host_info_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3796,8 +4402,8 @@ inline ::romabuf::HostInfo* PleromaMessage::release_host_info() {
 }
 inline const ::romabuf::HostInfo& PleromaMessage::_internal_host_info() const {
   return _internal_has_host_info()
-      ? *msg_.host_info_
-      : *reinterpret_cast< ::romabuf::HostInfo*>(&::romabuf::_HostInfo_default_instance_);
+      ? *_impl_.msg_.host_info_
+      : reinterpret_cast< ::romabuf::HostInfo&>(::romabuf::_HostInfo_default_instance_);
 }
 inline const ::romabuf::HostInfo& PleromaMessage::host_info() const {
   // @@protoc_insertion_point(field_get:romabuf.PleromaMessage.host_info)
@@ -3807,8 +4413,8 @@ inline ::romabuf::HostInfo* PleromaMessage::unsafe_arena_release_host_info() {
   // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PleromaMessage.host_info)
   if (_internal_has_host_info()) {
     clear_has_msg();
-    ::romabuf::HostInfo* temp = msg_.host_info_;
-    msg_.host_info_ = nullptr;
+    ::romabuf::HostInfo* temp = _impl_.msg_.host_info_;
+    _impl_.msg_.host_info_ = nullptr;
     return temp;
   } else {
     return nullptr;
@@ -3818,7 +4424,7 @@ inline void PleromaMessage::unsafe_arena_set_allocated_host_info(::romabuf::Host
   clear_msg();
   if (host_info) {
     set_has_host_info();
-    msg_.host_info_ = host_info;
+    _impl_.msg_.host_info_ = host_info;
   }
   // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PleromaMessage.host_info)
 }
@@ -3826,23 +4432,98 @@ inline ::romabuf::HostInfo* PleromaMessage::_internal_mutable_host_info() {
   if (!_internal_has_host_info()) {
     clear_msg();
     set_has_host_info();
-    msg_.host_info_ = CreateMaybeMessage< ::romabuf::HostInfo >(GetArena());
+    _impl_.msg_.host_info_ = CreateMaybeMessage< ::romabuf::HostInfo >(GetArenaForAllocation());
   }
-  return msg_.host_info_;
+  return _impl_.msg_.host_info_;
 }
 inline ::romabuf::HostInfo* PleromaMessage::mutable_host_info() {
+  ::romabuf::HostInfo* _msg = _internal_mutable_host_info();
   // @@protoc_insertion_point(field_mutable:romabuf.PleromaMessage.host_info)
-  return _internal_mutable_host_info();
+  return _msg;
+}
+
+// .romabuf.CallBatch call_batch = 5;
+inline bool PleromaMessage::_internal_has_call_batch() const {
+  return msg_case() == kCallBatch;
+}
+inline bool PleromaMessage::has_call_batch() const {
+  return _internal_has_call_batch();
+}
+inline void PleromaMessage::set_has_call_batch() {
+  _impl_._oneof_case_[0] = kCallBatch;
+}
+inline void PleromaMessage::clear_call_batch() {
+  if (_internal_has_call_batch()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.msg_.call_batch_;
+    }
+    clear_has_msg();
+  }
+}
+inline ::romabuf::CallBatch* PleromaMessage::release_call_batch() {
+  // @@protoc_insertion_point(field_release:romabuf.PleromaMessage.call_batch)
+  if (_internal_has_call_batch()) {
+    clear_has_msg();
+    ::romabuf::CallBatch* temp = _impl_.msg_.call_batch_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.msg_.call_batch_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::romabuf::CallBatch& PleromaMessage::_internal_call_batch() const {
+  return _internal_has_call_batch()
+      ? *_impl_.msg_.call_batch_
+      : reinterpret_cast< ::romabuf::CallBatch&>(::romabuf::_CallBatch_default_instance_);
+}
+inline const ::romabuf::CallBatch& PleromaMessage::call_batch() const {
+  // @@protoc_insertion_point(field_get:romabuf.PleromaMessage.call_batch)
+  return _internal_call_batch();
+}
+inline ::romabuf::CallBatch* PleromaMessage::unsafe_arena_release_call_batch() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.PleromaMessage.call_batch)
+  if (_internal_has_call_batch()) {
+    clear_has_msg();
+    ::romabuf::CallBatch* temp = _impl_.msg_.call_batch_;
+    _impl_.msg_.call_batch_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void PleromaMessage::unsafe_arena_set_allocated_call_batch(::romabuf::CallBatch* call_batch) {
+  clear_msg();
+  if (call_batch) {
+    set_has_call_batch();
+    _impl_.msg_.call_batch_ = call_batch;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.PleromaMessage.call_batch)
+}
+inline ::romabuf::CallBatch* PleromaMessage::_internal_mutable_call_batch() {
+  if (!_internal_has_call_batch()) {
+    clear_msg();
+    set_has_call_batch();
+    _impl_.msg_.call_batch_ = CreateMaybeMessage< ::romabuf::CallBatch >(GetArenaForAllocation());
+  }
+  return _impl_.msg_.call_batch_;
+}
+inline ::romabuf::CallBatch* PleromaMessage::mutable_call_batch() {
+  ::romabuf::CallBatch* _msg = _internal_mutable_call_batch();
+  // @@protoc_insertion_point(field_mutable:romabuf.PleromaMessage.call_batch)
+  return _msg;
 }
 
 inline bool PleromaMessage::has_msg() const {
   return msg_case() != MSG_NOT_SET;
 }
 inline void PleromaMessage::clear_has_msg() {
-  _oneof_case_[0] = MSG_NOT_SET;
+  _impl_._oneof_case_[0] = MSG_NOT_SET;
 }
 inline PleromaMessage::MsgCase PleromaMessage::msg_case() const {
-  return PleromaMessage::MsgCase(_oneof_case_[0]);
+  return PleromaMessage::MsgCase(_impl_._oneof_case_[0]);
 }
 // -------------------------------------------------------------------
 
@@ -3850,380 +4531,330 @@ inline PleromaMessage::MsgCase PleromaMessage::msg_case() const {
 
 // required int32 node_id = 1;
 inline bool Call::_internal_has_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool Call::has_node_id() const {
   return _internal_has_node_id();
 }
 inline void Call::clear_node_id() {
-  node_id_ = 0;
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_node_id() const {
-  return node_id_;
+inline int32_t Call::_internal_node_id() const {
+  return _impl_.node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::node_id() const {
+inline int32_t Call::node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.node_id)
   return _internal_node_id();
 }
-inline void Call::_internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000004u;
-  node_id_ = value;
+inline void Call::_internal_set_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.node_id_ = value;
 }
-inline void Call::set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_node_id(int32_t value) {
   _internal_set_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.node_id)
 }
 
 // required int32 vat_id = 2;
 inline bool Call::_internal_has_vat_id() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool Call::has_vat_id() const {
   return _internal_has_vat_id();
 }
 inline void Call::clear_vat_id() {
-  vat_id_ = 0;
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.vat_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_vat_id() const {
-  return vat_id_;
+inline int32_t Call::_internal_vat_id() const {
+  return _impl_.vat_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::vat_id() const {
+inline int32_t Call::vat_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.vat_id)
   return _internal_vat_id();
 }
-inline void Call::_internal_set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000008u;
-  vat_id_ = value;
+inline void Call::_internal_set_vat_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.vat_id_ = value;
 }
-inline void Call::set_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_vat_id(int32_t value) {
   _internal_set_vat_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.vat_id)
 }
 
 // required int32 entity_id = 3;
 inline bool Call::_internal_has_entity_id() const {
-  bool value = (_has_bits_[0] & 0x00000010u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
   return value;
 }
 inline bool Call::has_entity_id() const {
   return _internal_has_entity_id();
 }
 inline void Call::clear_entity_id() {
-  entity_id_ = 0;
-  _has_bits_[0] &= ~0x00000010u;
+  _impl_.entity_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_entity_id() const {
-  return entity_id_;
+inline int32_t Call::_internal_entity_id() const {
+  return _impl_.entity_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::entity_id() const {
+inline int32_t Call::entity_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.entity_id)
   return _internal_entity_id();
 }
-inline void Call::_internal_set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000010u;
-  entity_id_ = value;
+inline void Call::_internal_set_entity_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.entity_id_ = value;
 }
-inline void Call::set_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_entity_id(int32_t value) {
   _internal_set_entity_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.entity_id)
 }
 
 // required string function_id = 4;
 inline bool Call::_internal_has_function_id() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool Call::has_function_id() const {
   return _internal_has_function_id();
 }
 inline void Call::clear_function_id() {
-  function_id_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.function_id_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& Call::function_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.function_id)
   return _internal_function_id();
 }
-inline void Call::set_function_id(const std::string& value) {
-  _internal_set_function_id(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Call::set_function_id(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.function_id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.Call.function_id)
 }
 inline std::string* Call::mutable_function_id() {
+  std::string* _s = _internal_mutable_function_id();
   // @@protoc_insertion_point(field_mutable:romabuf.Call.function_id)
-  return _internal_mutable_function_id();
+  return _s;
 }
 inline const std::string& Call::_internal_function_id() const {
-  return function_id_.Get();
+  return _impl_.function_id_.Get();
 }
 inline void Call::_internal_set_function_id(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void Call::set_function_id(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  function_id_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.Call.function_id)
-}
-inline void Call::set_function_id(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.Call.function_id)
-}
-inline void Call::set_function_id(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.Call.function_id)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.function_id_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Call::_internal_mutable_function_id() {
-  _has_bits_[0] |= 0x00000001u;
-  return function_id_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.function_id_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Call::release_function_id() {
   // @@protoc_insertion_point(field_release:romabuf.Call.function_id)
   if (!_internal_has_function_id()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return function_id_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.function_id_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.function_id_.IsDefault()) {
+    _impl_.function_id_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Call::set_allocated_function_id(std::string* function_id) {
   if (function_id != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  function_id_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), function_id,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.Call.function_id)
-}
-inline std::string* Call::unsafe_arena_release_function_id() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.Call.function_id)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000001u;
-  return function_id_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void Call::unsafe_arena_set_allocated_function_id(
-    std::string* function_id) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (function_id != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
-  } else {
-    _has_bits_[0] &= ~0x00000001u;
+  _impl_.function_id_.SetAllocated(function_id, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.function_id_.IsDefault()) {
+    _impl_.function_id_.Set("", GetArenaForAllocation());
   }
-  function_id_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      function_id, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.Call.function_id)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.Call.function_id)
 }
 
 // required int32 src_node_id = 5;
 inline bool Call::_internal_has_src_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000020u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
   return value;
 }
 inline bool Call::has_src_node_id() const {
   return _internal_has_src_node_id();
 }
 inline void Call::clear_src_node_id() {
-  src_node_id_ = 0;
-  _has_bits_[0] &= ~0x00000020u;
+  _impl_.src_node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000020u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_src_node_id() const {
-  return src_node_id_;
+inline int32_t Call::_internal_src_node_id() const {
+  return _impl_.src_node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::src_node_id() const {
+inline int32_t Call::src_node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.src_node_id)
   return _internal_src_node_id();
 }
-inline void Call::_internal_set_src_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000020u;
-  src_node_id_ = value;
+inline void Call::_internal_set_src_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.src_node_id_ = value;
 }
-inline void Call::set_src_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_src_node_id(int32_t value) {
   _internal_set_src_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.src_node_id)
 }
 
 // required int32 src_vat_id = 6;
 inline bool Call::_internal_has_src_vat_id() const {
-  bool value = (_has_bits_[0] & 0x00000040u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
   return value;
 }
 inline bool Call::has_src_vat_id() const {
   return _internal_has_src_vat_id();
 }
 inline void Call::clear_src_vat_id() {
-  src_vat_id_ = 0;
-  _has_bits_[0] &= ~0x00000040u;
+  _impl_.src_vat_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000040u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_src_vat_id() const {
-  return src_vat_id_;
+inline int32_t Call::_internal_src_vat_id() const {
+  return _impl_.src_vat_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::src_vat_id() const {
+inline int32_t Call::src_vat_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.src_vat_id)
   return _internal_src_vat_id();
 }
-inline void Call::_internal_set_src_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000040u;
-  src_vat_id_ = value;
+inline void Call::_internal_set_src_vat_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.src_vat_id_ = value;
 }
-inline void Call::set_src_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_src_vat_id(int32_t value) {
   _internal_set_src_vat_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.src_vat_id)
 }
 
 // required int32 src_entity_id = 7;
 inline bool Call::_internal_has_src_entity_id() const {
-  bool value = (_has_bits_[0] & 0x00000080u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
   return value;
 }
 inline bool Call::has_src_entity_id() const {
   return _internal_has_src_entity_id();
 }
 inline void Call::clear_src_entity_id() {
-  src_entity_id_ = 0;
-  _has_bits_[0] &= ~0x00000080u;
+  _impl_.src_entity_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000080u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_src_entity_id() const {
-  return src_entity_id_;
+inline int32_t Call::_internal_src_entity_id() const {
+  return _impl_.src_entity_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::src_entity_id() const {
+inline int32_t Call::src_entity_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.src_entity_id)
   return _internal_src_entity_id();
 }
-inline void Call::_internal_set_src_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000080u;
-  src_entity_id_ = value;
+inline void Call::_internal_set_src_entity_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.src_entity_id_ = value;
 }
-inline void Call::set_src_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_src_entity_id(int32_t value) {
   _internal_set_src_entity_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.src_entity_id)
 }
 
-// required string src_function_id = 8;
+// optional string src_function_id = 8;
 inline bool Call::_internal_has_src_function_id() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool Call::has_src_function_id() const {
   return _internal_has_src_function_id();
 }
 inline void Call::clear_src_function_id() {
-  src_function_id_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.src_function_id_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
 inline const std::string& Call::src_function_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.src_function_id)
   return _internal_src_function_id();
 }
-inline void Call::set_src_function_id(const std::string& value) {
-  _internal_set_src_function_id(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Call::set_src_function_id(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.src_function_id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.Call.src_function_id)
 }
 inline std::string* Call::mutable_src_function_id() {
+  std::string* _s = _internal_mutable_src_function_id();
   // @@protoc_insertion_point(field_mutable:romabuf.Call.src_function_id)
-  return _internal_mutable_src_function_id();
+  return _s;
 }
 inline const std::string& Call::_internal_src_function_id() const {
-  return src_function_id_.Get();
+  return _impl_.src_function_id_.Get();
 }
 inline void Call::_internal_set_src_function_id(const std::string& value) {
-  _has_bits_[0] |= 0x00000002u;
-  src_function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void Call::set_src_function_id(std::string&& value) {
-  _has_bits_[0] |= 0x00000002u;
-  src_function_id_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.Call.src_function_id)
-}
-inline void Call::set_src_function_id(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000002u;
-  src_function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.Call.src_function_id)
-}
-inline void Call::set_src_function_id(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000002u;
-  src_function_id_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.Call.src_function_id)
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.src_function_id_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Call::_internal_mutable_src_function_id() {
-  _has_bits_[0] |= 0x00000002u;
-  return src_function_id_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.src_function_id_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Call::release_src_function_id() {
   // @@protoc_insertion_point(field_release:romabuf.Call.src_function_id)
   if (!_internal_has_src_function_id()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000002u;
-  return src_function_id_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.src_function_id_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.src_function_id_.IsDefault()) {
+    _impl_.src_function_id_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Call::set_allocated_src_function_id(std::string* src_function_id) {
   if (src_function_id != nullptr) {
-    _has_bits_[0] |= 0x00000002u;
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    _has_bits_[0] &= ~0x00000002u;
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
-  src_function_id_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), src_function_id,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.Call.src_function_id)
-}
-inline std::string* Call::unsafe_arena_release_src_function_id() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.Call.src_function_id)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000002u;
-  return src_function_id_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void Call::unsafe_arena_set_allocated_src_function_id(
-    std::string* src_function_id) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (src_function_id != nullptr) {
-    _has_bits_[0] |= 0x00000002u;
-  } else {
-    _has_bits_[0] &= ~0x00000002u;
+  _impl_.src_function_id_.SetAllocated(src_function_id, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.src_function_id_.IsDefault()) {
+    _impl_.src_function_id_.Set("", GetArenaForAllocation());
   }
-  src_function_id_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      src_function_id, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.Call.src_function_id)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.Call.src_function_id)
 }
 
 // required bool response = 9;
 inline bool Call::_internal_has_response() const {
-  bool value = (_has_bits_[0] & 0x00000100u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000100u) != 0;
   return value;
 }
 inline bool Call::has_response() const {
   return _internal_has_response();
 }
 inline void Call::clear_response() {
-  response_ = false;
-  _has_bits_[0] &= ~0x00000100u;
+  _impl_.response_ = false;
+  _impl_._has_bits_[0] &= ~0x00000100u;
 }
 inline bool Call::_internal_response() const {
-  return response_;
+  return _impl_.response_;
 }
 inline bool Call::response() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.response)
   return _internal_response();
 }
 inline void Call::_internal_set_response(bool value) {
-  _has_bits_[0] |= 0x00000100u;
-  response_ = value;
+  _impl_._has_bits_[0] |= 0x00000100u;
+  _impl_.response_ = value;
 }
 inline void Call::set_response(bool value) {
   _internal_set_response(value);
@@ -4232,69 +4863,114 @@ inline void Call::set_response(bool value) {
 
 // required int32 promise_id = 10;
 inline bool Call::_internal_has_promise_id() const {
-  bool value = (_has_bits_[0] & 0x00000200u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000200u) != 0;
   return value;
 }
 inline bool Call::has_promise_id() const {
   return _internal_has_promise_id();
 }
 inline void Call::clear_promise_id() {
-  promise_id_ = 0;
-  _has_bits_[0] &= ~0x00000200u;
+  _impl_.promise_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000200u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::_internal_promise_id() const {
-  return promise_id_;
+inline int32_t Call::_internal_promise_id() const {
+  return _impl_.promise_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 Call::promise_id() const {
+inline int32_t Call::promise_id() const {
   // @@protoc_insertion_point(field_get:romabuf.Call.promise_id)
   return _internal_promise_id();
 }
-inline void Call::_internal_set_promise_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000200u;
-  promise_id_ = value;
+inline void Call::_internal_set_promise_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000200u;
+  _impl_.promise_id_ = value;
 }
-inline void Call::set_promise_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void Call::set_promise_id(int32_t value) {
   _internal_set_promise_id(value);
   // @@protoc_insertion_point(field_set:romabuf.Call.promise_id)
 }
 
 // repeated .romabuf.PValue pvalues = 11;
 inline int Call::_internal_pvalues_size() const {
-  return pvalues_.size();
+  return _impl_.pvalues_.size();
 }
 inline int Call::pvalues_size() const {
   return _internal_pvalues_size();
 }
 inline void Call::clear_pvalues() {
-  pvalues_.Clear();
+  _impl_.pvalues_.Clear();
 }
 inline ::romabuf::PValue* Call::mutable_pvalues(int index) {
   // @@protoc_insertion_point(field_mutable:romabuf.Call.pvalues)
-  return pvalues_.Mutable(index);
+  return _impl_.pvalues_.Mutable(index);
 }
 inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue >*
 Call::mutable_pvalues() {
   // @@protoc_insertion_point(field_mutable_list:romabuf.Call.pvalues)
-  return &pvalues_;
+  return &_impl_.pvalues_;
 }
 inline const ::romabuf::PValue& Call::_internal_pvalues(int index) const {
-  return pvalues_.Get(index);
+  return _impl_.pvalues_.Get(index);
 }
 inline const ::romabuf::PValue& Call::pvalues(int index) const {
   // @@protoc_insertion_point(field_get:romabuf.Call.pvalues)
   return _internal_pvalues(index);
 }
 inline ::romabuf::PValue* Call::_internal_add_pvalues() {
-  return pvalues_.Add();
+  return _impl_.pvalues_.Add();
 }
 inline ::romabuf::PValue* Call::add_pvalues() {
+  ::romabuf::PValue* _add = _internal_add_pvalues();
   // @@protoc_insertion_point(field_add:romabuf.Call.pvalues)
-  return _internal_add_pvalues();
+  return _add;
 }
 inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::PValue >&
 Call::pvalues() const {
   // @@protoc_insertion_point(field_list:romabuf.Call.pvalues)
-  return pvalues_;
+  return _impl_.pvalues_;
+}
+
+// -------------------------------------------------------------------
+
+// CallBatch
+
+// repeated .romabuf.Call calls = 1;
+inline int CallBatch::_internal_calls_size() const {
+  return _impl_.calls_.size();
+}
+inline int CallBatch::calls_size() const {
+  return _internal_calls_size();
+}
+inline void CallBatch::clear_calls() {
+  _impl_.calls_.Clear();
+}
+inline ::romabuf::Call* CallBatch::mutable_calls(int index) {
+  // @@protoc_insertion_point(field_mutable:romabuf.CallBatch.calls)
+  return _impl_.calls_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::Call >*
+CallBatch::mutable_calls() {
+  // @@protoc_insertion_point(field_mutable_list:romabuf.CallBatch.calls)
+  return &_impl_.calls_;
+}
+inline const ::romabuf::Call& CallBatch::_internal_calls(int index) const {
+  return _impl_.calls_.Get(index);
+}
+inline const ::romabuf::Call& CallBatch::calls(int index) const {
+  // @@protoc_insertion_point(field_get:romabuf.CallBatch.calls)
+  return _internal_calls(index);
+}
+inline ::romabuf::Call* CallBatch::_internal_add_calls() {
+  return _impl_.calls_.Add();
+}
+inline ::romabuf::Call* CallBatch::add_calls() {
+  ::romabuf::Call* _add = _internal_add_calls();
+  // @@protoc_insertion_point(field_add:romabuf.CallBatch.calls)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::Call >&
+CallBatch::calls() const {
+  // @@protoc_insertion_point(field_list:romabuf.CallBatch.calls)
+  return _impl_.calls_;
 }
 
 // -------------------------------------------------------------------
@@ -4303,278 +4979,282 @@ Call::pvalues() const {
 
 // required string address = 1;
 inline bool AnnouncePeer::_internal_has_address() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool AnnouncePeer::has_address() const {
   return _internal_has_address();
 }
 inline void AnnouncePeer::clear_address() {
-  address_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.address_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& AnnouncePeer::address() const {
   // @@protoc_insertion_point(field_get:romabuf.AnnouncePeer.address)
   return _internal_address();
 }
-inline void AnnouncePeer::set_address(const std::string& value) {
-  _internal_set_address(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void AnnouncePeer::set_address(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.address_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.AnnouncePeer.address)
 }
 inline std::string* AnnouncePeer::mutable_address() {
+  std::string* _s = _internal_mutable_address();
   // @@protoc_insertion_point(field_mutable:romabuf.AnnouncePeer.address)
-  return _internal_mutable_address();
+  return _s;
 }
 inline const std::string& AnnouncePeer::_internal_address() const {
-  return address_.Get();
+  return _impl_.address_.Get();
 }
 inline void AnnouncePeer::_internal_set_address(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void AnnouncePeer::set_address(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.AnnouncePeer.address)
-}
-inline void AnnouncePeer::set_address(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.AnnouncePeer.address)
-}
-inline void AnnouncePeer::set_address(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  address_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.AnnouncePeer.address)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.address_.Set(value, GetArenaForAllocation());
 }
 inline std::string* AnnouncePeer::_internal_mutable_address() {
-  _has_bits_[0] |= 0x00000001u;
-  return address_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.address_.Mutable(GetArenaForAllocation());
 }
 inline std::string* AnnouncePeer::release_address() {
   // @@protoc_insertion_point(field_release:romabuf.AnnouncePeer.address)
   if (!_internal_has_address()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return address_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.address_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void AnnouncePeer::set_allocated_address(std::string* address) {
   if (address != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  address_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), address,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.AnnouncePeer.address)
-}
-inline std::string* AnnouncePeer::unsafe_arena_release_address() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.AnnouncePeer.address)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000001u;
-  return address_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void AnnouncePeer::unsafe_arena_set_allocated_address(
-    std::string* address) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (address != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
-  } else {
-    _has_bits_[0] &= ~0x00000001u;
+  _impl_.address_.SetAllocated(address, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.address_.IsDefault()) {
+    _impl_.address_.Set("", GetArenaForAllocation());
   }
-  address_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      address, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.AnnouncePeer.address)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.AnnouncePeer.address)
 }
 
 // required uint32 port = 2;
 inline bool AnnouncePeer::_internal_has_port() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool AnnouncePeer::has_port() const {
   return _internal_has_port();
 }
 inline void AnnouncePeer::clear_port() {
-  port_ = 0u;
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.port_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 AnnouncePeer::_internal_port() const {
-  return port_;
+inline uint32_t AnnouncePeer::_internal_port() const {
+  return _impl_.port_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 AnnouncePeer::port() const {
+inline uint32_t AnnouncePeer::port() const {
   // @@protoc_insertion_point(field_get:romabuf.AnnouncePeer.port)
   return _internal_port();
 }
-inline void AnnouncePeer::_internal_set_port(::PROTOBUF_NAMESPACE_ID::uint32 value) {
-  _has_bits_[0] |= 0x00000002u;
-  port_ = value;
+inline void AnnouncePeer::_internal_set_port(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.port_ = value;
 }
-inline void AnnouncePeer::set_port(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+inline void AnnouncePeer::set_port(uint32_t value) {
   _internal_set_port(value);
   // @@protoc_insertion_point(field_set:romabuf.AnnouncePeer.port)
 }
 
+// optional int32 node_id = 3;
+inline bool AnnouncePeer::_internal_has_node_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool AnnouncePeer::has_node_id() const {
+  return _internal_has_node_id();
+}
+inline void AnnouncePeer::clear_node_id() {
+  _impl_.node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline int32_t AnnouncePeer::_internal_node_id() const {
+  return _impl_.node_id_;
+}
+inline int32_t AnnouncePeer::node_id() const {
+  // @@protoc_insertion_point(field_get:romabuf.AnnouncePeer.node_id)
+  return _internal_node_id();
+}
+inline void AnnouncePeer::_internal_set_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.node_id_ = value;
+}
+inline void AnnouncePeer::set_node_id(int32_t value) {
+  _internal_set_node_id(value);
+  // @@protoc_insertion_point(field_set:romabuf.AnnouncePeer.node_id)
+}
+
 // -------------------------------------------------------------------
 
 // AssignClusterInfo
 
 // required uint32 node_id = 1;
 inline bool AssignClusterInfo::_internal_has_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool AssignClusterInfo::has_node_id() const {
   return _internal_has_node_id();
 }
 inline void AssignClusterInfo::clear_node_id() {
-  node_id_ = 0u;
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.node_id_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 AssignClusterInfo::_internal_node_id() const {
-  return node_id_;
+inline uint32_t AssignClusterInfo::_internal_node_id() const {
+  return _impl_.node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint32 AssignClusterInfo::node_id() const {
+inline uint32_t AssignClusterInfo::node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.AssignClusterInfo.node_id)
   return _internal_node_id();
 }
-inline void AssignClusterInfo::_internal_set_node_id(::PROTOBUF_NAMESPACE_ID::uint32 value) {
-  _has_bits_[0] |= 0x00000001u;
-  node_id_ = value;
+inline void AssignClusterInfo::_internal_set_node_id(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.node_id_ = value;
 }
-inline void AssignClusterInfo::set_node_id(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+inline void AssignClusterInfo::set_node_id(uint32_t value) {
   _internal_set_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.AssignClusterInfo.node_id)
 }
 
 // required int32 monad_node_id = 2;
 inline bool AssignClusterInfo::_internal_has_monad_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
   return value;
 }
 inline bool AssignClusterInfo::has_monad_node_id() const {
   return _internal_has_monad_node_id();
 }
 inline void AssignClusterInfo::clear_monad_node_id() {
-  monad_node_id_ = 0;
-  _has_bits_[0] &= ~0x00000002u;
+  _impl_.monad_node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::_internal_monad_node_id() const {
-  return monad_node_id_;
+inline int32_t AssignClusterInfo::_internal_monad_node_id() const {
+  return _impl_.monad_node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::monad_node_id() const {
+inline int32_t AssignClusterInfo::monad_node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.AssignClusterInfo.monad_node_id)
   return _internal_monad_node_id();
 }
-inline void AssignClusterInfo::_internal_set_monad_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000002u;
-  monad_node_id_ = value;
+inline void AssignClusterInfo::_internal_set_monad_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.monad_node_id_ = value;
 }
-inline void AssignClusterInfo::set_monad_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void AssignClusterInfo::set_monad_node_id(int32_t value) {
   _internal_set_monad_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.AssignClusterInfo.monad_node_id)
 }
 
 // required int32 monad_vat_id = 3;
 inline bool AssignClusterInfo::_internal_has_monad_vat_id() const {
-  bool value = (_has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool AssignClusterInfo::has_monad_vat_id() const {
   return _internal_has_monad_vat_id();
 }
 inline void AssignClusterInfo::clear_monad_vat_id() {
-  monad_vat_id_ = 0;
-  _has_bits_[0] &= ~0x00000004u;
+  _impl_.monad_vat_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::_internal_monad_vat_id() const {
-  return monad_vat_id_;
+inline int32_t AssignClusterInfo::_internal_monad_vat_id() const {
+  return _impl_.monad_vat_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::monad_vat_id() const {
+inline int32_t AssignClusterInfo::monad_vat_id() const {
   // @@protoc_insertion_point(field_get:romabuf.AssignClusterInfo.monad_vat_id)
   return _internal_monad_vat_id();
 }
-inline void AssignClusterInfo::_internal_set_monad_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000004u;
-  monad_vat_id_ = value;
+inline void AssignClusterInfo::_internal_set_monad_vat_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.monad_vat_id_ = value;
 }
-inline void AssignClusterInfo::set_monad_vat_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void AssignClusterInfo::set_monad_vat_id(int32_t value) {
   _internal_set_monad_vat_id(value);
   // @@protoc_insertion_point(field_set:romabuf.AssignClusterInfo.monad_vat_id)
 }
 
 // required int32 monad_entity_id = 4;
 inline bool AssignClusterInfo::_internal_has_monad_entity_id() const {
-  bool value = (_has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool AssignClusterInfo::has_monad_entity_id() const {
   return _internal_has_monad_entity_id();
 }
 inline void AssignClusterInfo::clear_monad_entity_id() {
-  monad_entity_id_ = 0;
-  _has_bits_[0] &= ~0x00000008u;
+  _impl_.monad_entity_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::_internal_monad_entity_id() const {
-  return monad_entity_id_;
+inline int32_t AssignClusterInfo::_internal_monad_entity_id() const {
+  return _impl_.monad_entity_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 AssignClusterInfo::monad_entity_id() const {
+inline int32_t AssignClusterInfo::monad_entity_id() const {
   // @@protoc_insertion_point(field_get:romabuf.AssignClusterInfo.monad_entity_id)
   return _internal_monad_entity_id();
 }
-inline void AssignClusterInfo::_internal_set_monad_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000008u;
-  monad_entity_id_ = value;
+inline void AssignClusterInfo::_internal_set_monad_entity_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.monad_entity_id_ = value;
 }
-inline void AssignClusterInfo::set_monad_entity_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void AssignClusterInfo::set_monad_entity_id(int32_t value) {
   _internal_set_monad_entity_id(value);
   // @@protoc_insertion_point(field_set:romabuf.AssignClusterInfo.monad_entity_id)
 }
 
 // repeated .romabuf.HostInfo nodes = 5;
 inline int AssignClusterInfo::_internal_nodes_size() const {
-  return nodes_.size();
+  return _impl_.nodes_.size();
 }
 inline int AssignClusterInfo::nodes_size() const {
   return _internal_nodes_size();
 }
 inline void AssignClusterInfo::clear_nodes() {
-  nodes_.Clear();
+  _impl_.nodes_.Clear();
 }
 inline ::romabuf::HostInfo* AssignClusterInfo::mutable_nodes(int index) {
   // @@protoc_insertion_point(field_mutable:romabuf.AssignClusterInfo.nodes)
-  return nodes_.Mutable(index);
+  return _impl_.nodes_.Mutable(index);
 }
 inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::HostInfo >*
 AssignClusterInfo::mutable_nodes() {
   // @@protoc_insertion_point(field_mutable_list:romabuf.AssignClusterInfo.nodes)
-  return &nodes_;
+  return &_impl_.nodes_;
 }
 inline const ::romabuf::HostInfo& AssignClusterInfo::_internal_nodes(int index) const {
-  return nodes_.Get(index);
+  return _impl_.nodes_.Get(index);
 }
 inline const ::romabuf::HostInfo& AssignClusterInfo::nodes(int index) const {
   // @@protoc_insertion_point(field_get:romabuf.AssignClusterInfo.nodes)
   return _internal_nodes(index);
 }
 inline ::romabuf::HostInfo* AssignClusterInfo::_internal_add_nodes() {
-  return nodes_.Add();
+  return _impl_.nodes_.Add();
 }
 inline ::romabuf::HostInfo* AssignClusterInfo::add_nodes() {
+  ::romabuf::HostInfo* _add = _internal_add_nodes();
   // @@protoc_insertion_point(field_add:romabuf.AssignClusterInfo.nodes)
-  return _internal_add_nodes();
+  return _add;
 }
 inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::romabuf::HostInfo >&
 AssignClusterInfo::nodes() const {
   // @@protoc_insertion_point(field_list:romabuf.AssignClusterInfo.nodes)
-  return nodes_;
+  return _impl_.nodes_;
 }
 
 // -------------------------------------------------------------------
@@ -4583,95 +5263,70 @@ AssignClusterInfo::nodes() const {
 
 // required string node_name = 1;
 inline bool Greeting::_internal_has_node_name() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool Greeting::has_node_name() const {
   return _internal_has_node_name();
 }
 inline void Greeting::clear_node_name() {
-  node_name_.ClearToEmpty(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.node_name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
 inline const std::string& Greeting::node_name() const {
   // @@protoc_insertion_point(field_get:romabuf.Greeting.node_name)
   return _internal_node_name();
 }
-inline void Greeting::set_node_name(const std::string& value) {
-  _internal_set_node_name(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Greeting::set_node_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.node_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:romabuf.Greeting.node_name)
 }
 inline std::string* Greeting::mutable_node_name() {
+  std::string* _s = _internal_mutable_node_name();
   // @@protoc_insertion_point(field_mutable:romabuf.Greeting.node_name)
-  return _internal_mutable_node_name();
+  return _s;
 }
 inline const std::string& Greeting::_internal_node_name() const {
-  return node_name_.Get();
+  return _impl_.node_name_.Get();
 }
 inline void Greeting::_internal_set_node_name(const std::string& value) {
-  _has_bits_[0] |= 0x00000001u;
-  node_name_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value, GetArena());
-}
-inline void Greeting::set_node_name(std::string&& value) {
-  _has_bits_[0] |= 0x00000001u;
-  node_name_.Set(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:romabuf.Greeting.node_name)
-}
-inline void Greeting::set_node_name(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  _has_bits_[0] |= 0x00000001u;
-  node_name_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value),
-              GetArena());
-  // @@protoc_insertion_point(field_set_char:romabuf.Greeting.node_name)
-}
-inline void Greeting::set_node_name(const char* value,
-    size_t size) {
-  _has_bits_[0] |= 0x00000001u;
-  node_name_.Set(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:romabuf.Greeting.node_name)
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.node_name_.Set(value, GetArenaForAllocation());
 }
 inline std::string* Greeting::_internal_mutable_node_name() {
-  _has_bits_[0] |= 0x00000001u;
-  return node_name_.Mutable(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.node_name_.Mutable(GetArenaForAllocation());
 }
 inline std::string* Greeting::release_node_name() {
   // @@protoc_insertion_point(field_release:romabuf.Greeting.node_name)
   if (!_internal_has_node_name()) {
     return nullptr;
   }
-  _has_bits_[0] &= ~0x00000001u;
-  return node_name_.ReleaseNonDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.node_name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.node_name_.IsDefault()) {
+    _impl_.node_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
 }
 inline void Greeting::set_allocated_node_name(std::string* node_name) {
   if (node_name != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    _has_bits_[0] &= ~0x00000001u;
+    _impl_._has_bits_[0] &= ~0x00000001u;
   }
-  node_name_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), node_name,
-      GetArena());
-  // @@protoc_insertion_point(field_set_allocated:romabuf.Greeting.node_name)
-}
-inline std::string* Greeting::unsafe_arena_release_node_name() {
-  // @@protoc_insertion_point(field_unsafe_arena_release:romabuf.Greeting.node_name)
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  _has_bits_[0] &= ~0x00000001u;
-  return node_name_.UnsafeArenaRelease(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      GetArena());
-}
-inline void Greeting::unsafe_arena_set_allocated_node_name(
-    std::string* node_name) {
-  GOOGLE_DCHECK(GetArena() != nullptr);
-  if (node_name != nullptr) {
-    _has_bits_[0] |= 0x00000001u;
-  } else {
-    _has_bits_[0] &= ~0x00000001u;
+  _impl_.node_name_.SetAllocated(node_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.node_name_.IsDefault()) {
+    _impl_.node_name_.Set("", GetArenaForAllocation());
   }
-  node_name_.UnsafeArenaSetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      node_name, GetArena());
-  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:romabuf.Greeting.node_name)
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:romabuf.Greeting.node_name)
 }
 
 // -------------------------------------------------------------------
@@ -4680,28 +5335,28 @@ inline void Greeting::unsafe_arena_set_allocated_node_name(
 
 // required int32 node_id = 1;
 inline bool GreetingAck::_internal_has_node_id() const {
-  bool value = (_has_bits_[0] & 0x00000001u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
 inline bool GreetingAck::has_node_id() const {
   return _internal_has_node_id();
 }
 inline void GreetingAck::clear_node_id() {
-  node_id_ = 0;
-  _has_bits_[0] &= ~0x00000001u;
+  _impl_.node_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 GreetingAck::_internal_node_id() const {
-  return node_id_;
+inline int32_t GreetingAck::_internal_node_id() const {
+  return _impl_.node_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 GreetingAck::node_id() const {
+inline int32_t GreetingAck::node_id() const {
   // @@protoc_insertion_point(field_get:romabuf.GreetingAck.node_id)
   return _internal_node_id();
 }
-inline void GreetingAck::_internal_set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
-  _has_bits_[0] |= 0x00000001u;
-  node_id_ = value;
+inline void GreetingAck::_internal_set_node_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.node_id_ = value;
 }
-inline void GreetingAck::set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void GreetingAck::set_node_id(int32_t value) {
   _internal_set_node_id(value);
   // @@protoc_insertion_point(field_set:romabuf.GreetingAck.node_id)
 }
@@ -4737,6 +5392,10 @@ inline void GreetingAck::set_node_id(::PROTOBUF_NAMESPACE_ID::int32 value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 